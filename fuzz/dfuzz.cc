@@ -19,6 +19,8 @@
 #include <lc3_cpp.h>
 #include <fuzzer/FuzzedDataProvider.h>
 
+#include <cstdlib>
+
 using namespace lc3;
 
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
@@ -59,9 +61,32 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
   if (fdp.remaining_bytes() < frame_size * nchannels)
     return -1;
 
-  dec.Decode(
-    fdp.ConsumeBytes<uint8_t>(nchannels * frame_size).data(), frame_size,
-    fmt, std::vector<uint8_t>(nchannels * frame_samples * sample_bytes).data());
+  int block_size = nchannels * frame_size;
+  std::vector<uint8_t> in = fdp.ConsumeBytes<uint8_t>(block_size);
+  std::vector<uint8_t> pcm0(nchannels * frame_samples * sample_bytes);
+  std::vector<uint8_t> pcm1(pcm0.size());
+
+  // The decoding is deterministic, and a second decoder,
+  // in the same state, outputs the same samples
+
+  Decoder dec_check(dt_us, sr_hz, sr_pcm_hz, nchannels, hrmode);
+
+  int ret = dec.Decode(in.data(), frame_size, fmt, pcm0.data());
+  if (dec_check.Decode(in.data(), frame_size, fmt, pcm1.data()) != ret ||
+      pcm0 != pcm1)
+    abort();
+
+  // Roundtrip, the decoded samples are encoded then decoded again,
+  // the frames output by the encoder must be decoded without concealment
+
+  Encoder enc(dt_us, sr_hz, sr_pcm_hz, nchannels, hrmode);
+  std::vector<uint8_t> out(block_size);
+
+  if (ret < 0 || enc.Encode(fmt, pcm0.data(), block_size, out.data()) < 0)
+    return 0;
+
+  if (dec_check.Decode(out.data(), block_size, fmt, pcm1.data()) != 0)
+    abort();
 
   return 0;
 }
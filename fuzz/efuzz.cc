@@ -19,6 +19,8 @@
 #include <lc3_cpp.h>
 #include <fuzzer/FuzzedDataProvider.h>
 
+#include <cstdlib>
+
 using namespace lc3;
 
 template <typename T>
@@ -31,11 +33,47 @@ float ConsumeInRange(FuzzedDataProvider &fdp, float min, float max) {
   return fdp.ConsumeFloatingPointInRange<float>(min, max);
 }
 
+// Roundtrip check of the encoding of a block of frames
+//
+// The encoding is deterministic: a second encoder, in the same state,
+// outputs the same frames. The frames output are always decoded as valid
+// frames, without concealment, and the decoded samples are in range.
+
+struct Roundtrip {
+  Encoder &e0, &e1;
+  Decoder &d;
+  int nchannels;
+};
+
+int roundtrip(Roundtrip &r, PcmFormat fmt, const void *pcm, int frame_size)
+{
+  int block_size = r.nchannels * frame_size;
+  std::vector<uint8_t> out0(block_size), out1(block_size);
+
+  int ret = r.e0.Encode(fmt, pcm, block_size, out0.data());
+  if (r.e1.Encode(fmt, pcm, block_size, out1.data()) != ret || out0 != out1)
+    abort();
+
+  if (ret < 0)
+    return -1;
+
+  std::vector<float> xs(r.nchannels * r.d.GetFrameSamples());
+  if (r.d.Decode(out0.data(), block_size, xs.data()) != 0)
+    abort();
+
+  for (auto s: xs)
+    if (!(s >= -1.f && s <= 1.f))
+      abort();
+
+  return 0;
+}
+
 template <typename T>
-int encode(Encoder &e, int nchannels, int frame_size, FuzzedDataProvider &fdp,
+int encode(Roundtrip &r, PcmFormat fmt, int frame_size,
+  FuzzedDataProvider &fdp,
   T min = std::numeric_limits<T>::min(), T max = std::numeric_limits<T>::max())
 {
-  int pcm_samples = nchannels * e.GetFrameSamples();
+  int pcm_samples = r.nchannels * r.e0.GetFrameSamples();
   if (fdp.remaining_bytes() < pcm_samples * sizeof(T))
     return -1;
 
@@ -43,14 +81,11 @@ int encode(Encoder &e, int nchannels, int frame_size, FuzzedDataProvider &fdp,
   for (auto &s: pcm)
     s = ConsumeInRange<T>(fdp, min, max);
 
-  e.Encode(pcm.data(),
-    frame_size, std::vector<uint8_t>(nchannels * frame_size).data());
-
-  return 0;
+  return roundtrip(r, fmt, pcm.data(), frame_size);
 }
 
-int encode(Encoder &e, int frame_size, int nchannels,
-  PcmFormat fmt, FuzzedDataProvider &fdp)
+int encode(Roundtrip &r, PcmFormat fmt, int frame_size,
+  FuzzedDataProvider &fdp)
 {
   int sample_bytes =
     fmt == PcmFormat::kS16 ? sizeof(int16_t) :
@@ -58,14 +93,12 @@ int encode(Encoder &e, int frame_size, int nchannels,
     fmt == PcmFormat::kS24In3Le ? sizeof(uint8_t) * 3 :
     fmt == PcmFormat::kF32 ? sizeof(float) : 0;
 
-  int pcm_bytes = nchannels * e.GetFrameSamples() * sample_bytes;
+  int pcm_bytes = r.nchannels * r.e0.GetFrameSamples() * sample_bytes;
   if (fdp.remaining_bytes() < pcm_bytes)
     return -1;
 
-  e.Encode(fmt, fdp.ConsumeBytes<uint8_t>(pcm_bytes).data(),
-    frame_size, std::vector<uint8_t>(nchannels * frame_size).data());
-
-  return 0;
+  return roundtrip(r, fmt,
+    fdp.ConsumeBytes<uint8_t>(pcm_bytes).data(), frame_size);
 }
 
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
@@ -85,6 +118,10 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
     sr_pcm_hz = 0;
 
   Encoder enc(dt_us, sr_hz, sr_pcm_hz, nchannels, hrmode);
+  Encoder enc_check(dt_us, sr_hz, sr_pcm_hz, nchannels, hrmode);
+  Decoder dec(dt_us, sr_hz, sr_pcm_hz, nchannels, hrmode);
+
+  Roundtrip r = { enc, enc_check, dec, nchannels };
 
   PcmFormat fmt = fdp.PickValueInArray(
     { PcmFormat::kS16, PcmFormat::kS24,
@@ -96,22 +133,22 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
   switch (fmt) {
 
   case PcmFormat::kS16:
-    return encode<int16_t>(enc, nchannels, frame_size, fdp);
+    return encode<int16_t>(r, fmt, frame_size, fdp);
 
   case PcmFormat::kS24: {
     const int32_t s24_min = -(1 << 23);
     const int32_t s24_max =  (1 << 23) - 1;
-    return encode<int32_t>(enc, nchannels, frame_size, fdp, s24_min, s24_max);
+    return encode<int32_t>(r, fmt, frame_size, fdp, s24_min, s24_max);
   }
 
   case PcmFormat::kF32: {
     const float f32_min = -1.0;
     const float f32_max =  1.0;
-    return encode<float>(enc, nchannels, frame_size, fdp, f32_min, f32_max);
+    return encode<float>(r, fmt, frame_size, fdp, f32_min, f32_max);
   }
 
   case PcmFormat::kS24In3Le:
-    return encode(enc, nchannels, frame_size, fmt, fdp);
+    return encode(r, fmt, frame_size, fdp);
   }
 
   return 0;
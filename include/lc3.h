@@ -214,6 +214,14 @@ extern "C" {
     ( (hrmode) ? ((sr) == 48000) || ((sr) == 96000) : LC3_CHECK_SR_HZ(sr) )
 
 
+/**
+ * Flags of the serialized state of encoders and decoders
+ *   LC3_STATE_QUANTIZED  Histories of samples quantized on 16 bits
+ */
+
+#define LC3_STATE_QUANTIZED  (1 << 0)
+
+
 /**
  * PCM Sample Format
  *   S16      Signed 16 bits, in 16 bits words (int16_t)
@@ -231,12 +239,53 @@ enum lc3_pcm_format {
 };
 
 
+/**
+ * Side information of a frame
+ *   bandwidth       Bandwidth, as the samplerate in Hz covering it
+ *   lastnz          Number of spectral coefficients coded
+ *   lsb_mode        Least significant bits of the spectrum coded apart
+ *   global_gain     Index of the global gain, as coded (0 to 255)
+ *   noise_factor    Noise filling factor (0 to 7)
+ *   tns_nfilters    Number of TNS filters (1 or 2), and orders (0 to 8)
+ *   tns_order
+ *   pitch_present   Pitch present, LTPF activation and pitch index,
+ *   ltpf_active     left to 0 when the pitch is not present
+ *   pitch_index
+ *   sns             SNS indices: Codebooks of the first stage, shape and
+ *                   gain of the second stage, pulse configurations indices
+ *                   and leading signs
+ */
+
+struct lc3_frame_info {
+    int bandwidth;
+    int lastnz;
+    bool lsb_mode;
+    int global_gain;
+    int noise_factor;
+
+    int tns_nfilters;
+    int tns_order[2];
+
+    bool pitch_present;
+    bool ltpf_active;
+    int pitch_index;
+
+    struct {
+        int lfcb, hfcb;
+        int shape, gain;
+        int idx_a, idx_b;
+        bool ls_a, ls_b;
+    } sns;
+};
+
+
 /**
  * Handle
  */
 
 typedef struct lc3_encoder *lc3_encoder_t;
 typedef struct lc3_decoder *lc3_decoder_t;
+typedef struct lc3_multi_encoder *lc3_multi_encoder_t;
 
 
 /**
@@ -366,6 +415,75 @@ LC3_EXPORT lc3_encoder_t lc3_setup_encoder(
 LC3_EXPORT void lc3_encoder_disable_ltpf(
     lc3_encoder_t encoder);
 
+/**
+ * Enable pitch tracking of LTPF analysis
+ * encoder        Handle of the encoder
+ *
+ * On voiced frames, the pitch is searched around the pitch of the previous
+ * frame, instead of the full range of pitch-lags, and the full search is
+ * done back when the track is lost. This reduces the cost of the analysis
+ * on speech, but the bitstream may differ from the one of the reference.
+ */
+LC3_EXPORT void lc3_encoder_enable_pitch_tracking(
+    lc3_encoder_t encoder);
+
+/**
+ * Return size needed for an encoder snapshot
+ * hrmode          Enable High-Resolution mode (48000 and 96000 sample rates)
+ * dt_us           Frame duration in us, 2500, 5000, 7500 or 10000
+ * sr_hz           Sample rate in Hz, as given for the size of the encoder
+ * return          Size of the snapshot in bytes, 0 on bad parameters
+ */
+LC3_EXPORT unsigned lc3_hr_encoder_snapshot_size(
+    bool hrmode, int dt_us, int sr_hz);
+
+LC3_EXPORT unsigned lc3_encoder_snapshot_size(int dt_us, int sr_hz);
+
+/**
+ * Snapshot and restore the state of an encoder
+ * encoder         Handle of the encoder
+ * mem             Snapshot memory space, aligned to pointer type
+ * return          0: On success  -1: Wrong parameters
+ *
+ * Only the state carried from frame to frame is copied: the state of the
+ * attack detector and LTPF analysis, the bit consumption tracking of the
+ * spectral quantization, and the temporal and MDCT history. The encoder
+ * is restored to the state of the snapshot, taken on an encoder of the
+ * same frame duration and sample rate.
+ * This allows trial encodings of a frame, at several sizes, before the
+ * one kept is encoded back from the snapshot.
+ */
+LC3_EXPORT int lc3_encoder_snapshot(
+    const struct lc3_encoder *encoder, void *mem);
+
+LC3_EXPORT int lc3_encoder_restore(
+    lc3_encoder_t encoder, const void *mem);
+
+/**
+ * Export and import the state of an encoder
+ * encoder         Handle of the encoder
+ * flags           `LC3_STATE_QUANTIZED` to quantize the histories, or 0
+ * buffer, size    Buffer of the serialized state, and its size in bytes
+ * return          Export: Size of the state, -1 on wrong parameters
+ *                 or buffer too small.  Import: 0 on success, -1 on wrong
+ *                 parameters or state
+ *
+ * The state carried from frame to frame is serialized in a compact and
+ * versioned form, independent of the host and the build of the library.
+ * The fields derived from the setup of the encoder are left out, the
+ * state is imported into an encoder setup with the same parameters.
+ * The size of the state is returned by an export with a NULL buffer.
+ * The fields of an imported state are checked against their range, the
+ * encoder is left unchanged when the state is rejected.
+ * With `LC3_STATE_QUANTIZED`, the histories of samples are quantized on
+ * 16 bits, leaving a noise over 90 dB below their peak.
+ */
+LC3_EXPORT int lc3_encoder_export(
+    const struct lc3_encoder *encoder, int flags, void *buffer, int size);
+
+LC3_EXPORT int lc3_encoder_import(
+    lc3_encoder_t encoder, const void *buffer, int size);
+
 /**
  * Encode a frame
  * encoder         Handle of the encoder
@@ -379,6 +497,214 @@ LC3_EXPORT int lc3_encode(
     lc3_encoder_t encoder, enum lc3_pcm_format fmt,
     const void *pcm, int stride, int nbytes, void *out);
 
+/**
+ * Encode a frame, in variable bitrate mode
+ * encoder         Handle of the encoder
+ * fmt             PCM input format
+ * pcm, stride     Input PCM samples, and count between two consecutives
+ * quality         Target quality, as a signal to noise ratio in dB
+ * min_nbytes      Minimum size, in bytes, of the frame
+ * max_nbytes      Maximum size, in bytes, of the frame
+ * out             Output buffer of `max_nbytes` size
+ * return          Size of the frame in bytes, -1 on wrong parameters
+ *
+ * The size of the frame is the smallest one, in the range, for which the
+ * estimated quantization noise meets the target. The ratio is taken on
+ * the spectrum shaped by the SNS, so that the noise follows the spectral
+ * envelope of the signal, and against the geometric mean of the spectrum,
+ * giving more bits to tonal frames than to noise-like ones.
+ * Silent frames are encoded on `min_nbytes`. The estimation is corrected
+ * by the bit consumption of the previous frames, tracked by the encoder
+ * as in constant bitrate mode.
+ */
+LC3_EXPORT int lc3_encode_vbr(
+    lc3_encoder_t encoder, enum lc3_pcm_format fmt,
+    const void *pcm, int stride,
+    float quality, int min_nbytes, int max_nbytes, void *out);
+
+/**
+ * Estimate the size of a frame for quality targets
+ * encoder         Handle of the encoder
+ * fmt             PCM input format
+ * pcm, stride     Input PCM samples, and count between two consecutives
+ * nquality        Count of quality targets
+ * quality         Quality targets, as defined by `lc3_encode_vbr()`
+ * min_nbytes      Minimum size, in bytes, of the frame
+ * max_nbytes      Maximum size, in bytes, of the frame
+ * nbytes          Output the estimated size of the frame by targets
+ * return          0: On success  -1: Wrong parameters
+ *
+ * The analysis of the frame is run, up to the temporal noise shaping.
+ * The quantization and the bitstream writing are skipped. The encoder
+ * goes to the state following the encoding of the frame, except for the
+ * tracking of the bit consumption. This is intended for the first pass,
+ * over the whole stream, of a two-pass encoding.
+ */
+LC3_EXPORT int lc3_encode_estimate(
+    lc3_encoder_t encoder, enum lc3_pcm_format fmt,
+    const void *pcm, int stride, int nquality, const float *quality,
+    int min_nbytes, int max_nbytes, int *nbytes);
+
+/**
+ * Setup the redundant copies of an encoder
+ * fec             Redundant copy state, allocated by the caller
+ *
+ * The state holds the redundant copy of the previous frame, up to the
+ * next packet. It is held by the caller, apart from the encoder, and is
+ * not part of the snapshots or the exported state of the encoder.
+ */
+LC3_EXPORT void lc3_setup_fec_encoder(lc3_fec_encoder_t *fec);
+
+/**
+ * Encode a frame, with a redundant copy of the previous frame
+ * encoder         Handle of the encoder
+ * fec             Redundant copy state, set up by `lc3_setup_fec_encoder()`
+ * fmt             PCM input format
+ * pcm, stride     Input PCM samples, and count between two consecutives
+ * nbytes          Target size, in bytes, of the frame
+ * fec_nbytes      Size, in bytes, of the redundant copy of the frame,
+ *                 up to `LC3_FEC_MAX_FRAME_BYTES`, 0 when not sent
+ * out             Output buffer of `nbytes`, plus the size of the previous
+ *                 redundant copy, plus one byte
+ * return          Size of the packet in bytes, -1 on wrong parameters
+ *
+ * The packet output is the frame, followed by the redundant copy of the
+ * previous frame, and its size on the last byte. The redundant copy is
+ * encoded with the frame, at a lower size, reusing the analysis, and is
+ * held by `fec` up to the next packet. The state `fec` follows a single
+ * encoder. Packets are decoded by `lc3_decode_fec()`.
+ */
+LC3_EXPORT int lc3_encode_fec(
+    lc3_encoder_t encoder, lc3_fec_encoder_t *fec,
+    enum lc3_pcm_format fmt, const void *pcm, int stride,
+    int nbytes, int fec_nbytes, void *out);
+
+/**
+ * Setup a rate control
+ * rc              Rate control, allocated by the caller
+ *
+ * The rate control is held by the caller, apart from the encoder, and is
+ * not part of the snapshots or the exported state of the encoder.
+ */
+LC3_EXPORT void lc3_setup_rate_control(lc3_rate_control_t *rc);
+
+/**
+ * Transport feedback to a rate control
+ * encoder         Handle of the encoder
+ * rc              Rate control, set up by `lc3_setup_rate_control()`
+ * loss_rate       Rate of frames lost, from 0 to 1, over the interval
+ * delay_us        Queuing delay of the transport, in us
+ * budget_bytes    Bytes available for the stream over the interval
+ * interval_us     Duration of the interval, in us
+ * return          0: On success  -1: Wrong parameters
+ *
+ * The target size of the frames starts at the budget, backs off on loss
+ * over 10% or when the queuing delay exceeds
+ * `LC3_RATE_CONTROL_MAX_DELAY_US`, and probes up, by 5% by feedback,
+ * when the loss is under 2%. It does not exceed the budget.
+ */
+LC3_EXPORT int lc3_encoder_rate_feedback(
+    lc3_encoder_t encoder, lc3_rate_control_t *rc,
+    float loss_rate, int delay_us, int budget_bytes, int interval_us);
+
+/**
+ * Encode a frame, sized by a rate control
+ * encoder         Handle of the encoder
+ * rc              Rate control, fed by `lc3_encoder_rate_feedback()`
+ * fmt             PCM input format
+ * pcm, stride     Input PCM samples, and count between two consecutives
+ * out             Output buffer of `LC3_MAX_FRAME_BYTES` size,
+ *                 or `LC3_HR_MAX_FRAME_BYTES` in high-resolution mode
+ * return          Size of the frame in bytes,
+ *                 -1 on wrong parameters or when no feedback received
+ *
+ * The size of the frame is the target size, set by the feedbacks,
+ * smoothed by the bit consumption tracked by the encoder over the previous
+ * frames. The deviations are carried over, so that the frames meet the
+ * target size on average. On queuing delay, the frames do not exceed
+ * the target.
+ */
+LC3_EXPORT int lc3_encode_rate_control(
+    lc3_encoder_t encoder, lc3_rate_control_t *rc,
+    enum lc3_pcm_format fmt, const void *pcm, int stride, void *out);
+
+/**
+ * Encode a block of frames, sharing the bytes between channels
+ * encoders        Handle of the encoder of each channel
+ * nchannels       Number of channels, up to `LC3_MAX_POOL_CHANNELS`
+ * fmt             PCM input format
+ * pcm, stride     Input PCM samples of each channel, and count between
+ *                 two consecutives
+ * block_bytes     Size, in bytes, of the block of frames
+ * nbytes          Output the size, in bytes, of the frame of each channel
+ * out             Output buffer of `block_bytes` size
+ * return          0: On success  -1: Wrong parameters
+ *
+ * The encoders share the same frame duration and sample rate. The frames
+ * are output consecutively, and fill the block. Rather than an even split,
+ * the block is shared so that the channels are encoded at a common quality
+ * target, as defined by `lc3_encode_vbr()`: the channels easy to encode
+ * give their bytes to the others. The analysis of each frame is run once,
+ * the sharing only takes the size estimations of the frames.
+ * The sizes of the frames vary from block to block, and are needed by the
+ * decoder, they are to be signaled by the transport.
+ */
+LC3_EXPORT int lc3_encode_pool(
+    lc3_encoder_t const *encoders, int nchannels, enum lc3_pcm_format fmt,
+    const void * const *pcm, int stride, int block_bytes, int *nbytes,
+    void *out);
+
+/**
+ * Return size needed for a multi-rendition encoder
+ * hrmode          Enable High-Resolution mode (48000 and 96000 sample rates)
+ * dt_us           Frame duration in us, 2500, 5000, 7500 or 10000
+ * sr_pcm_hz       Input sample rate in Hz
+ * return          Size of then encoder in bytes, 0 on bad parameters
+ */
+LC3_EXPORT unsigned lc3_hr_multi_encoder_size(
+    bool hrmode, int dt_us, int sr_pcm_hz);
+
+LC3_EXPORT unsigned lc3_multi_encoder_size(int dt_us, int sr_pcm_hz);
+
+/**
+ * Setup multi-rendition encoder
+ * hrmode          Enable High-Resolution mode (48000 and 96000 sample rates)
+ * dt_us           Frame duration in us, 2500, 5000, 7500 or 10000
+ * sr_pcm_hz       Input sample rate in Hz
+ * nrenditions     Number of renditions, up to `LC3_MAX_RENDITIONS`
+ * sr_hz           Sample rate of each rendition, lower or equal to `sr_pcm_hz`
+ * mem             Encoder memory space, aligned to pointer type
+ * return          Encoder as an handle, NULL on bad parameters
+ *
+ * A multi-rendition encoder produces, from one PCM input stream, several
+ * streams of different sample rates or frame sizes. The stages that do not
+ * depend on the size of the frames (MDCT, energy estimation, bandwidth
+ * detection and LTPF pitch analysis) are run once by frame, the stages
+ * depending on the size of the frames are run by rendition.
+ * The renditions of the highest sample rate are the same as the ones
+ * of independent encoders. The spectrum of lower sample rates is taken
+ * from the one of the highest, and can differ in rounding.
+ */
+LC3_EXPORT lc3_multi_encoder_t lc3_hr_setup_multi_encoder(
+    bool hrmode, int dt_us, int sr_pcm_hz,
+    int nrenditions, const int *sr_hz, void *mem);
+
+LC3_EXPORT lc3_multi_encoder_t lc3_setup_multi_encoder(
+    int dt_us, int sr_pcm_hz, int nrenditions, const int *sr_hz, void *mem);
+
+/**
+ * Encode a frame in each rendition
+ * encoder         Handle of the multi-rendition encoder
+ * fmt             PCM input format
+ * pcm, stride     Input PCM samples, and count between two consecutives
+ * nbytes          Target size, in bytes, of the frame of each rendition
+ * out             Output buffer of each rendition, of `nbytes` size
+ * return          0: On success  -1: Wrong parameters
+ */
+LC3_EXPORT int lc3_multi_encode(
+    lc3_multi_encoder_t encoder, enum lc3_pcm_format fmt,
+    const void *pcm, int stride, const int *nbytes, void * const *out);
+
 /**
  * Return size needed for an decoder
  * hrmode          Enable High-Resolution mode (48000 and 96000 sample rates)
@@ -426,6 +752,85 @@ LC3_EXPORT int lc3_decode(
     lc3_decoder_t decoder, const void *in, int nbytes,
     enum lc3_pcm_format fmt, void *pcm, int stride);
 
+/**
+ * Decode a frame, or its redundant copy
+ * decoder         Handle of the decoder
+ * in, size        Input packet, and size in bytes, NULL when lost
+ * next, next_size Next packet, and size in bytes, NULL when not available
+ * fmt             PCM output format
+ * pcm, stride     Output PCM samples, and count between two consecutives
+ * return          0: On success  1: PLC operated  2: Redundant copy decoded
+ *                 -1: Wrong parameters
+ *
+ * The packets are output by `lc3_encode_fec()`. When the packet is lost,
+ * the redundant copy of the frame, sent with the next packet, is decoded.
+ * PLC is operated when neither are available. A packet, or a redundant
+ * copy, whose size trailer is out of the range of frame sizes is taken
+ * as lost.
+ */
+LC3_EXPORT int lc3_decode_fec(
+    lc3_decoder_t decoder, const void *in, int size,
+    const void *next, int next_size,
+    enum lc3_pcm_format fmt, void *pcm, int stride);
+
+/**
+ * Export and import the state of a decoder
+ * decoder         Handle of the decoder
+ * flags           `LC3_STATE_QUANTIZED` to quantize the histories, or 0
+ * buffer, size    Buffer of the serialized state, and its size in bytes
+ * return          Export: Size of the state, -1 on wrong parameters
+ *                 or buffer too small.  Import: 0 on success, -1 on wrong
+ *                 parameters or state
+ *
+ * See `lc3_encoder_export()`.
+ */
+LC3_EXPORT int lc3_decoder_export(
+    const struct lc3_decoder *decoder, int flags, void *buffer, int size);
+
+LC3_EXPORT int lc3_decoder_import(
+    lc3_decoder_t decoder, const void *buffer, int size);
+
+/**
+ * Inspect the side information of a frame
+ * hrmode          Enable High-Resolution mode (48000 and 96000 sample rates)
+ * dt_us           Frame duration in us, 2500, 5000, 7500 or 10000
+ * sr_hz           Sample rate in Hz, 8000, 16000, 24000, 32000, 48000 or 96000
+ * in, nbytes      Input bitstream, and size in bytes
+ * info            Return the side information of the frame
+ * return          0: On success  -1: Wrong parameters or bitstream error
+ *
+ * Only the side information is read, the spectrum is not decoded and no
+ * state is kept between frames. Bitstream errors lying in the spectral
+ * data are therefore not detected.
+ */
+LC3_EXPORT int lc3_hr_frame_inspect(bool hrmode, int dt_us, int sr_hz,
+    const void *in, int nbytes, struct lc3_frame_info *info);
+
+LC3_EXPORT int lc3_frame_inspect(int dt_us, int sr_hz,
+    const void *in, int nbytes, struct lc3_frame_info *info);
+
+/**
+ * Apply a gain to a frame, in the compressed domain
+ * hrmode          Enable High-Resolution mode (48000 and 96000 sample rates)
+ * dt_us           Frame duration in us, 2500, 5000, 7500 or 10000
+ * sr_hz           Sample rate in Hz, 8000, 16000, 24000, 32000, 48000 or 96000
+ * frame, nbytes   The frame, rewritten in place, and its size in bytes
+ * gain_db         Gain to apply in dB
+ * applied_db      Return the gain applied in dB, when not NULL
+ * return          0: Gain applied  1: Gain clamped to the range of the frame
+ *                -1: Wrong parameters or bitstream error
+ *
+ * The global gain index of the frame is rewritten, without decoding the
+ * frame. The gain is rounded to steps of 20/28 dB (about 0.7 dB), and
+ * limited by the 8 bits range of the index. A frame coded with the
+ * lowest index is left unchanged.
+ */
+LC3_EXPORT int lc3_hr_frame_apply_gain(bool hrmode, int dt_us, int sr_hz,
+    void *frame, int nbytes, float gain_db, float *applied_db);
+
+LC3_EXPORT int lc3_frame_apply_gain(int dt_us, int sr_hz,
+    void *frame, int nbytes, float gain_db, float *applied_db);
+
 
 #ifdef __cplusplus
 }
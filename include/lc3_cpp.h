@@ -92,12 +92,27 @@ class Base {
 // Encoder Class
 class Encoder : public Base<struct lc3_encoder> {
   template <typename T>
-  int EncodeImpl(PcmFormat fmt, const T *pcm, int block_size, uint8_t *out) {
+  int EncodeImpl(PcmFormat fmt, const T *pcm, int block_size, uint8_t *out,
+                 int *frame_sizes) {
     if (states.size() != nchannels_) return -1;
 
     enum lc3_pcm_format cfmt = static_cast<lc3_pcm_format>(fmt);
     int ret = 0;
 
+    if (frame_sizes) {
+      std::vector<lc3_encoder_t> encoders;
+      std::vector<const void *> pcm_ptrs;
+
+      for (size_t ich = 0; ich < nchannels_; ich++) {
+        encoders.push_back(states[ich].get());
+        pcm_ptrs.push_back(pcm + ich);
+      }
+
+      return lc3_encode_pool(encoders.data(), nchannels_, cfmt,
+                             pcm_ptrs.data(), nchannels_, block_size,
+                             frame_sizes, out);
+    }
+
     uint8_t *out_ptr = out;
     for (size_t ich = 0; ich < nchannels_; ich++) {
       int frame_size = block_size / nchannels_
@@ -142,6 +157,11 @@ class Encoder : public Base<struct lc3_encoder> {
       lc3_encoder_disable_ltpf(s.get());
   }
 
+  void EnablePitchTracking() {
+    for (auto &s : states)
+      lc3_encoder_enable_pitch_tracking(s.get());
+  }
+
   ~Encoder() override = default;
 
   // Reset encoder state
@@ -159,42 +179,51 @@ class Encoder : public Base<struct lc3_encoder> {
   // The PCM samples are read in interleaved way, and consecutive
   // `nchannels` frames, are output in `out` buffer, of size `buffer_size`.
   //
+  // When `frame_sizes` is given, the block is shared between the channels
+  // according to how hard they are to encode, rather than evenly split.
+  // The sizes of the frames are returned in `frame_sizes`, of `nchannels`
+  // size, and are given back to the decoder.
+  //
   // The value returned is 0 on successs, -1 otherwise.
 
-  int Encode(const int16_t *pcm, int block_size, uint8_t *out) {
-    return EncodeImpl(PcmFormat::kS16, pcm, block_size, out);
+  int Encode(const int16_t *pcm, int block_size, uint8_t *out,
+             int *frame_sizes = nullptr) {
+    return EncodeImpl(PcmFormat::kS16, pcm, block_size, out, frame_sizes);
   }
 
-  int Encode(const int32_t *pcm, int block_size, uint8_t *out) {
-    return EncodeImpl(PcmFormat::kS24, pcm, block_size, out);
+  int Encode(const int32_t *pcm, int block_size, uint8_t *out,
+             int *frame_sizes = nullptr) {
+    return EncodeImpl(PcmFormat::kS24, pcm, block_size, out, frame_sizes);
   }
 
-  int Encode(const float *pcm, int block_size, uint8_t *out) {
-    return EncodeImpl(PcmFormat::kF32, pcm, block_size, out);
+  int Encode(const float *pcm, int block_size, uint8_t *out,
+             int *frame_sizes = nullptr) {
+    return EncodeImpl(PcmFormat::kF32, pcm, block_size, out, frame_sizes);
   }
 
-  int Encode(PcmFormat fmt, const void *pcm, int block_size, uint8_t *out) {
+  int Encode(PcmFormat fmt, const void *pcm, int block_size, uint8_t *out,
+             int *frame_sizes = nullptr) {
     uintptr_t pcm_ptr = reinterpret_cast<uintptr_t>(pcm);
 
     switch (fmt) {
       case PcmFormat::kS16:
         assert(pcm_ptr % alignof(int16_t) == 0);
         return EncodeImpl(fmt, reinterpret_cast<const int16_t *>(pcm),
-                          block_size, out);
+                          block_size, out, frame_sizes);
 
       case PcmFormat::kS24:
         assert(pcm_ptr % alignof(int32_t) == 0);
         return EncodeImpl(fmt, reinterpret_cast<const int32_t *>(pcm),
-                          block_size, out);
+                          block_size, out, frame_sizes);
 
       case PcmFormat::kS24In3Le:
         return EncodeImpl(fmt, reinterpret_cast<const int8_t(*)[3]>(pcm),
-                          block_size, out);
+                          block_size, out, frame_sizes);
 
       case PcmFormat::kF32:
         assert(pcm_ptr % alignof(float) == 0);
         return EncodeImpl(fmt, reinterpret_cast<const float *>(pcm), block_size,
-                          out);
+                          out, frame_sizes);
     }
 
     return -1;
@@ -205,7 +234,8 @@ class Encoder : public Base<struct lc3_encoder> {
 // Decoder Class
 class Decoder : public Base<struct lc3_decoder> {
   template <typename T>
-  int DecodeImpl(const uint8_t *in, int block_size, PcmFormat fmt, T *pcm) {
+  int DecodeImpl(const uint8_t *in, int block_size, PcmFormat fmt, T *pcm,
+                 const int *frame_sizes) {
     if (states.size() != nchannels_) return -1;
 
     enum lc3_pcm_format cfmt = static_cast<enum lc3_pcm_format>(fmt);
@@ -213,8 +243,8 @@ class Decoder : public Base<struct lc3_decoder> {
 
     const uint8_t *in_ptr = in;
     for (size_t ich = 0; ich < nchannels_; ich++) {
-      int frame_size = block_size / nchannels_
-          + (ich < block_size % nchannels_);
+      int frame_size = frame_sizes ? frame_sizes[ich] :
+          block_size / nchannels_ + (ich < block_size % nchannels_);
 
       ret |= lc3_decode(states[ich].get(), in_ptr, frame_size,
                         cfmt, pcm + ich, nchannels_);
@@ -267,42 +297,50 @@ class Decoder : public Base<struct lc3_decoder> {
   // The PCM samples are output in signed 16 bits, 24 bits, float,
   // according the type of `pcm` output buffer, or by selecting a format.
   //
+  // The `frame_sizes` gives the sizes of the frames, of a block shared
+  // between channels by the encoder, instead of an even split.
+  //
   // The value returned is 0 on successs, 1 when PLC has been performed,
   // and -1 otherwise.
 
-  int Decode(const uint8_t *in, int block_size, int16_t *pcm) {
-    return DecodeImpl(in, block_size, PcmFormat::kS16, pcm);
+  int Decode(const uint8_t *in, int block_size, int16_t *pcm,
+             const int *frame_sizes = nullptr) {
+    return DecodeImpl(in, block_size, PcmFormat::kS16, pcm, frame_sizes);
   }
 
-  int Decode(const uint8_t *in, int block_size, int32_t *pcm) {
-    return DecodeImpl(in, block_size, PcmFormat::kS24In3Le, pcm);
+  int Decode(const uint8_t *in, int block_size, int32_t *pcm,
+             const int *frame_sizes = nullptr) {
+    return DecodeImpl(in, block_size, PcmFormat::kS24In3Le, pcm, frame_sizes);
   }
 
-  int Decode(const uint8_t *in, int block_size, float *pcm) {
-    return DecodeImpl(in, block_size, PcmFormat::kF32, pcm);
+  int Decode(const uint8_t *in, int block_size, float *pcm,
+             const int *frame_sizes = nullptr) {
+    return DecodeImpl(in, block_size, PcmFormat::kF32, pcm, frame_sizes);
   }
 
-  int Decode(const uint8_t *in, int block_size, PcmFormat fmt, void *pcm) {
+  int Decode(const uint8_t *in, int block_size, PcmFormat fmt, void *pcm,
+             const int *frame_sizes = nullptr) {
     uintptr_t pcm_ptr = reinterpret_cast<uintptr_t>(pcm);
 
     switch (fmt) {
       case PcmFormat::kS16:
         assert(pcm_ptr % alignof(int16_t) == 0);
         return DecodeImpl(in, block_size, fmt,
-                          reinterpret_cast<int16_t *>(pcm));
+                          reinterpret_cast<int16_t *>(pcm), frame_sizes);
 
       case PcmFormat::kS24:
         assert(pcm_ptr % alignof(int32_t) == 0);
         return DecodeImpl(in, block_size, fmt,
-                          reinterpret_cast<int32_t *>(pcm));
+                          reinterpret_cast<int32_t *>(pcm), frame_sizes);
 
       case PcmFormat::kS24In3Le:
         return DecodeImpl(in, block_size, fmt,
-                          reinterpret_cast<int8_t(*)[3]>(pcm));
+                          reinterpret_cast<int8_t(*)[3]>(pcm), frame_sizes);
 
       case PcmFormat::kF32:
         assert(pcm_ptr % alignof(float) == 0);
-        return DecodeImpl(in, block_size, fmt, reinterpret_cast<float *>(pcm));
+        return DecodeImpl(in, block_size, fmt, reinterpret_cast<float *>(pcm),
+                          frame_sizes);
     }
 
     return -1;
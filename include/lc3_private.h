@@ -105,13 +105,32 @@ typedef struct lc3_ltpf_analysis {
     int16_t x_12k8[384];
     int16_t x_6k4[178];
     int tc;
+
+    bool track;
 } lc3_ltpf_analysis_t;
 
 typedef struct lc3_spec_analysis {
     float nbits_off;
     int nbits_spare;
+    int g_idx;
 } lc3_spec_analysis_t;
 
+typedef struct lc3_rate_control {
+    float nbytes, budget;
+    float carry;
+    bool congested;
+} lc3_rate_control_t;
+
+#define LC3_RATE_CONTROL_MAX_DELAY_US  20000
+
+#define LC3_FEC_MAX_FRAME_BYTES  255
+
+typedef struct lc3_fec_encoder {
+    lc3_spec_analysis_t spec;
+    int nbytes;
+    uint8_t frame[LC3_FEC_MAX_FRAME_BYTES];
+} lc3_fec_encoder_t;
+
 struct lc3_encoder {
     bool ltpf_bypass;
 
@@ -136,6 +155,62 @@ struct lc3_encoder {
         float __x[LC3_ENCODER_BUFFER_COUNT(dt_us, sr_hz)-1]; \
     }
 
+#define LC3_MAX_POOL_CHANNELS  8
+
+
+/**
+ * Encoder state snapshot and memory
+ * The buffer holds the temporal history, as 16 bits integers, followed
+ * by the MDCT delayed samples.
+ */
+
+struct lc3_encoder_snapshot {
+    enum lc3_dt dt;
+    enum lc3_srate sr_pcm;
+
+    lc3_attdet_analysis_t attdet;
+    lc3_ltpf_analysis_t ltpf;
+    lc3_spec_analysis_t spec;
+
+    float x[1];
+};
+
+#define LC3_ENCODER_SNAPSHOT_BUFFER_COUNT(dt_us, sr_hz) \
+    ( (LC3_NT(sr_hz) + 1) / 2 + LC3_ND(dt_us, sr_hz) )
+
+#define LC3_ENCODER_SNAPSHOT_MEM_T(dt_us, sr_hz) \
+    struct { \
+        struct lc3_encoder_snapshot __s; \
+        float __x[LC3_ENCODER_SNAPSHOT_BUFFER_COUNT(dt_us, sr_hz)-1]; \
+    }
+
+
+/**
+ * Multi-rendition encoder state and memory
+ */
+
+#define LC3_MAX_RENDITIONS  8
+
+struct lc3_rendition {
+    enum lc3_srate sr;
+
+    lc3_attdet_analysis_t attdet;
+    lc3_spec_analysis_t spec;
+};
+
+struct lc3_multi_encoder {
+    int nr;
+    struct lc3_rendition r[LC3_MAX_RENDITIONS];
+
+    struct lc3_encoder encoder;
+};
+
+#define LC3_MULTI_ENCODER_MEM_T(dt_us, sr_hz) \
+    struct { \
+        struct lc3_multi_encoder __m; \
+        float __x[LC3_ENCODER_BUFFER_COUNT(dt_us, sr_hz)-1]; \
+    }
+
 
 /**
  * Decoder state and memory
@@ -18,30 +18,22 @@
 
 #include "attdet.h"
 
+#include "attdet_arm.h"
+#include "attdet_sse.h"
+
 
 /**
- * Time domain attack detector
+ * Downsampling, filtering and energy of blocks of samples
+ * sr              Samplerate, 32 or 48 KHz
+ * x               [-6..-1] Previous, [0..nblk*ns/4-1] Current samples
+ * nblk            Number of blocks of 40 downsampled samples
+ * e               Return the energy of each block
  */
-bool lc3_attdet_run(enum lc3_dt dt, enum lc3_srate sr,
-    int nbytes, struct lc3_attdet_analysis *attdet, const int16_t *x)
-{
-    /* --- Check enabling --- */
-
-    const int nbytes_ranges[][LC3_NUM_SRATE - LC3_SRATE_32K][2] = {
-        [LC3_DT_7M5 - LC3_DT_7M5] = { { 61,     149 }, {  75,     149 } },
-        [LC3_DT_10M - LC3_DT_7M5] = { { 81, INT_MAX }, { 100, INT_MAX } },
-    };
-
-    if (dt < LC3_DT_7M5 || sr < LC3_SRATE_32K || lc3_hr(sr) ||
-            nbytes < nbytes_ranges[dt - LC3_DT_7M5][sr - LC3_SRATE_32K][0] ||
-            nbytes > nbytes_ranges[dt - LC3_DT_7M5][sr - LC3_SRATE_32K][1]   )
-        return 0;
-
-    /* --- Filtering & Energy calculation --- */
-
-    int nblk = 4 - (dt == LC3_DT_7M5);
-    int32_t e[4];
+#ifndef compute_energy
 
+LC3_HOT static void compute_energy(
+    enum lc3_srate sr, const int16_t *x, int nblk, int32_t *e)
+{
     for (int i = 0; i < nblk; i++) {
         e[i] = 0;
 
@@ -69,6 +61,35 @@ bool lc3_attdet_run(enum lc3_dt dt, enum lc3_srate sr,
             }
         }
     }
+}
+
+#endif /* compute_energy */
+
+
+/**
+ * Time domain attack detector
+ */
+bool lc3_attdet_run(enum lc3_dt dt, enum lc3_srate sr,
+    int nbytes, struct lc3_attdet_analysis *attdet, const int16_t *x)
+{
+    /* --- Check enabling --- */
+
+    const int nbytes_ranges[][LC3_NUM_SRATE - LC3_SRATE_32K][2] = {
+        [LC3_DT_7M5 - LC3_DT_7M5] = { { 61,     149 }, {  75,     149 } },
+        [LC3_DT_10M - LC3_DT_7M5] = { { 81, INT_MAX }, { 100, INT_MAX } },
+    };
+
+    if (dt < LC3_DT_7M5 || sr < LC3_SRATE_32K || lc3_hr(sr) ||
+            nbytes < nbytes_ranges[dt - LC3_DT_7M5][sr - LC3_SRATE_32K][0] ||
+            nbytes > nbytes_ranges[dt - LC3_DT_7M5][sr - LC3_SRATE_32K][1]   )
+        return 0;
+
+    /* --- Filtering & Energy calculation --- */
+
+    int nblk = 4 - (dt == LC3_DT_7M5);
+    int32_t e[4];
+
+    compute_energy(sr, x, nblk, e);
 
     /* --- Attack detection ---
      * The attack block `p_att` is defined as the normative value + 1,
@@ -0,0 +1,101 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if (__ARM_FEATURE_SIMD32 && !(__GNUC__ < 10) || defined(TEST_ARM))
+
+#ifndef TEST_ARM
+#include <arm_acle.h>
+#endif /* TEST_ARM */
+
+
+/**
+ * Downsampling, filtering and energy of blocks of samples
+ * sr              Samplerate, 32 or 48 KHz
+ * x               [-6..-1] Previous, [0..nblk*ns/4-1] Current samples
+ * nblk            Number of blocks of 40 downsampled samples
+ * e               Return the energy of each block
+ *
+ * The vector `x` is aligned on 32 bits. The blocks are downsampled as a
+ * whole, in pairs of samples packed on 32 bits, then filtered by pairs
+ * using dual 16 bits multiply-adds.
+ */
+#ifndef compute_energy
+
+LC3_HOT static void arm_compute_energy(
+    enum lc3_srate sr, const int16_t *x, int nblk, int32_t *e)
+{
+    int16x2_t __d[1 + 2*40], *dn = __d + 1;
+    int nd = nblk * 20;
+
+    /* --- Downsampling by pair of samples --- */
+
+    const int16x2_t *xn = (const int16x2_t *)x;
+
+    if (sr == LC3_SRATE_32K) {
+        for (int i = -1; i < nd; i++, xn += 2) {
+            int32_t d0 = __smuad(xn[-2], 0x00010001) >> 1;
+            int32_t d1 = __smuad(xn[-1], 0x00010001) >> 1;
+
+            dn[i] = __pkhbt(d0, (uint32_t)d1 << 16);
+        }
+    }
+
+    else {
+        for (int i = -1; i < nd; i++, xn += 3) {
+            int32_t d0 = __smlad(xn[-2], 0x00000001,
+                                 __smuad(xn[-3], 0x00010001)) >> 2;
+            int32_t d1 = __smlad(xn[-2], 0x00010000,
+                                 __smuad(xn[-1], 0x00010001)) >> 2;
+
+            dn[i] = __pkhbt(d0, (uint32_t)d1 << 16);
+        }
+    }
+
+    /* --- Filtering and energy --- */
+
+    const int16x2_t c0 = __pkhbt(1, (uint32_t)-4 << 16);
+    const int16x2_t c1 = __pkhbt(-4, 3 << 16);
+
+    int16x2_t d2 = dn[-1];
+
+    for (int i = 0; i < nblk; i++) {
+        int32_t en = 0;
+
+        for (int j = 0; j < 40; j += 2) {
+            int16x2_t d0 = *(dn++);
+
+            int16_t f0 = __smlad(d2, c0, 3 * (int16_t)d0) >> 3;
+            int16_t f1 = __smlad(d0, c1, d2 >> 16) >> 3;
+
+            en += (f0 * f0) >> 5;
+            en += (f1 * f1) >> 5;
+
+            d2 = d0;
+        }
+
+        e[i] = en;
+    }
+}
+
+#ifndef TEST_ARM
+#define compute_energy arm_compute_energy
+#endif
+
+#endif /* compute_energy */
+
+#endif /* __ARM_FEATURE_SIMD32 */
@@ -0,0 +1,111 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if __SSE2__ && !defined(TEST_ARM) && !defined(TEST_NEON) && \
+        !defined(TEST_WASM) || defined(TEST_SSE)
+
+#ifndef TEST_SSE
+#include <emmintrin.h>
+#endif /* TEST_SSE */
+
+
+/**
+ * Downsampling, filtering and energy of blocks of samples
+ * sr              Samplerate, 32 or 48 KHz
+ * x               [-6..-1] Previous, [0..nblk*ns/4-1] Current samples
+ * nblk            Number of blocks of 40 downsampled samples
+ * e               Return the energy of each block
+ *
+ * The blocks are downsampled as a whole. The filter is computed on 32 bits
+ * by groups of 8 samples, and the filtered values, that fit on 16 bits,
+ * are squared by multiply-adds with a null high part.
+ */
+#ifndef compute_energy
+
+LC3_HOT static void sse_compute_energy(
+    enum lc3_srate sr, const int16_t *x, int nblk, int32_t *e)
+{
+    int16_t __d[2 + 4*40], *d = __d + 2;
+    int nd = nblk * 40;
+
+    /* --- Downsampling --- */
+
+    if (sr == LC3_SRATE_32K) {
+        const __m128i ones = _mm_set1_epi16(1);
+
+        d[-2] = (x[-4] + x[-3]) >> 1;
+        d[-1] = (x[-2] + x[-1]) >> 1;
+
+        for (int i = 0; i < nd; i += 8, x += 16) {
+            __m128i s0 = _mm_madd_epi16(
+                _mm_loadu_si128((const __m128i *)(x + 0)), ones);
+            __m128i s1 = _mm_madd_epi16(
+                _mm_loadu_si128((const __m128i *)(x + 8)), ones);
+
+            _mm_storeu_si128((__m128i *)(d + i), _mm_packs_epi32(
+                _mm_srai_epi32(s0, 1), _mm_srai_epi32(s1, 1)));
+        }
+    }
+
+    else {
+        for (int i = -2; i < nd; i++, x += 3)
+            d[i] = (x[-6] + x[-5] + x[-4]) >> 2;
+    }
+
+    /* --- Filtering and energy --- */
+
+    const __m128i c = _mm_set1_epi32((int32_t)(((uint32_t)-4 << 16) | 3));
+    const __m128i mask = _mm_set1_epi32(0xffff);
+
+    for (int i = 0; i < nblk; i++, d += 40) {
+        __m128i en = _mm_setzero_si128();
+
+        for (int j = 0; j < 40; j += 8) {
+            __m128i xn  = _mm_loadu_si128((const __m128i *)(d + j));
+            __m128i xn1 = _mm_loadu_si128((const __m128i *)(d + j - 1));
+            __m128i xn2 = _mm_loadu_si128((const __m128i *)(d + j - 2));
+
+            __m128i f0 = _mm_add_epi32(
+                _mm_madd_epi16(_mm_unpacklo_epi16(xn, xn1), c),
+                _mm_srai_epi32(_mm_unpacklo_epi16(xn2, xn2), 16));
+
+            __m128i f1 = _mm_add_epi32(
+                _mm_madd_epi16(_mm_unpackhi_epi16(xn, xn1), c),
+                _mm_srai_epi32(_mm_unpackhi_epi16(xn2, xn2), 16));
+
+            f0 = _mm_and_si128(_mm_srai_epi32(f0, 3), mask);
+            f1 = _mm_and_si128(_mm_srai_epi32(f1, 3), mask);
+
+            en = _mm_add_epi32(en, _mm_add_epi32(
+                _mm_srai_epi32(_mm_madd_epi16(f0, f0), 5),
+                _mm_srai_epi32(_mm_madd_epi16(f1, f1), 5) ));
+        }
+
+        int32_t v[4];
+        _mm_storeu_si128((__m128i *)v, en);
+        e[i] = (v[0] + v[1]) + (v[2] + v[3]);
+    }
+}
+
+#ifndef TEST_SSE
+#define compute_energy sse_compute_energy
+#endif
+
+#endif /* compute_energy */
+
+#endif /* __SSE2__ */
@@ -166,10 +166,16 @@ static inline void ac_put(struct lc3_bits_buffer *buffer, int byte)
  * Arithmetic coder range shift
  * ac              Arithmetic coder
  * buffer          Bitstream buffer
+ *
+ * The carry of symbols writing is left on bit 24 of the low value,
+ * and resolved here.
  */
 LC3_HOT static inline void ac_shift(
     struct lc3_bits_ac *ac, struct lc3_bits_buffer *buffer)
 {
+    ac->carry |= ac->low >> 24;
+    ac->low &= 0xffffff;
+
     if (ac->low < 0xff0000 || ac->carry)
     {
         if (ac->cache >= 0)
@@ -196,6 +202,9 @@ LC3_HOT static inline void ac_shift(
 static void ac_terminate(struct lc3_bits_ac *ac,
     struct lc3_bits_buffer *buffer)
 {
+    ac->carry |= ac->low >> 24;
+    ac->low &= 0xffffff;
+
     int nbits = 25 - ac_get_range_bits(ac);
     unsigned mask = 0xffffff >> nbits;
     unsigned val  = ac->low + mask;
@@ -270,7 +279,7 @@ LC3_HOT void lc3_put_bits_generic(struct lc3_bits *bits, unsigned v, int n)
 
     int n1 = LC3_MIN(LC3_ACCU_BITS - accu->n, n);
     if (n1) {
-        accu->v |= v << accu->n;
+        accu->v |= (uint64_t)v << accu->n;
         accu->n = LC3_ACCU_BITS;
     }
 
@@ -278,7 +287,7 @@ LC3_HOT void lc3_put_bits_generic(struct lc3_bits *bits, unsigned v, int n)
 
     /* --- Accumulate remaining bits -- */
 
-    accu->v = v >> n1;
+    accu->v = (uint64_t)v >> n1;
     accu->n = n - n1;
 }
 
@@ -322,12 +331,12 @@ static inline void accu_load(struct lc3_bits_accu *accu,
 
     for ( ; nbytes; nbytes--) {
         accu->v >>= 8;
-        accu->v |= (unsigned)*(--buffer->p_bw) << (LC3_ACCU_BITS - 8);
+        accu->v |= (uint64_t)*(--buffer->p_bw) << (LC3_ACCU_BITS - 8);
     }
 
     if (accu->n >= 8) {
         accu->nover = LC3_MIN(accu->nover + accu->n, LC3_ACCU_BITS);
-        accu->v >>= accu->n;
+        accu->v = accu->n < LC3_ACCU_BITS ? accu->v >> accu->n : 0;
         accu->n = 0;
     }
 }
@@ -346,7 +355,7 @@ LC3_HOT unsigned lc3_get_bits_generic(struct lc3_bits *bits, int n)
     accu_load(accu, buffer);
 
     int n1 = LC3_MIN(LC3_ACCU_BITS - accu->n, n);
-    unsigned v = (accu->v >> accu->n) & ((1u << n1) - 1);
+    unsigned v = (accu->v >> accu->n) & ((UINT64_C(1) << n1) - 1);
     accu->n += n1;
 
     /* --- Second round --- */
@@ -356,7 +365,7 @@ LC3_HOT unsigned lc3_get_bits_generic(struct lc3_bits *bits, int n)
     if (n2) {
         accu_load(accu, buffer);
 
-        v |= ((accu->v >> accu->n) & ((1u << n2) - 1)) << n1;
+        v |= ((accu->v >> accu->n) & ((UINT64_C(1) << n2) - 1)) << n1;
         accu->n += n2;
     }
 
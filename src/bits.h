@@ -89,10 +89,10 @@ struct lc3_ac_model {
  * Bitstream context
  */
 
-#define LC3_ACCU_BITS (int)(8 * sizeof(unsigned))
+#define LC3_ACCU_BITS (int)(8 * sizeof(uint64_t))
 
 struct lc3_bits_accu {
-    unsigned v;
+    uint64_t v;
     int n, nover;
 };
 
@@ -221,7 +221,7 @@ LC3_HOT static inline void lc3_put_bits(
     struct lc3_bits_accu *accu = &bits->accu;
 
     if (accu->n + n <= LC3_ACCU_BITS) {
-        accu->v |= v << accu->n;
+        accu->v |= (uint64_t)v << accu->n;
         accu->n += n;
     } else {
         lc3_put_bits_generic(bits, v, n);
@@ -244,7 +244,7 @@ LC3_HOT static inline unsigned lc3_get_bits(struct lc3_bits *bits, int n)
     struct lc3_bits_accu *accu = &bits->accu;
 
     if (accu->n + n <= LC3_ACCU_BITS) {
-        int v = (accu->v >> accu->n) & ((1u << n) - 1);
+        unsigned v = (accu->v >> accu->n) & ((UINT64_C(1) << n) - 1);
         return (accu->n += n), v;
     }
     else {
@@ -265,9 +265,6 @@ LC3_HOT static inline void lc3_put_symbol(
     ac->low += range * symbols[s].low;
     ac->range = range * symbols[s].range;
 
-    ac->carry |= ac->low >> 24;
-    ac->low &= 0xffffff;
-
     if (ac->range < 0x10000)
         lc3_ac_write_renorm(bits);
 }
@@ -287,18 +284,42 @@ LC3_HOT static inline unsigned lc3_get_symbol(
     if (ac->error)
         ac->low = 0;
 
+    /* --- Symbol lookup ---
+     * The escape symbol, prevalent at high bitrates, is checked first.
+     * Otherwise, the symbol is the count of cumulative values of the model
+     * under the low value, the comparisons are done without branches. */
+
     int s = 16;
 
     if (ac->low < range * symbols[s].low) {
-        s >>= 1;
-        s -= ac->low < range * symbols[s].low ? 4 : -4;
-        s -= ac->low < range * symbols[s].low ? 2 : -2;
-        s -= ac->low < range * symbols[s].low ? 1 : -1;
-        s -= ac->low < range * symbols[s].low;
+        s = 0;
+        for (int i = 1; i < 16; i++)
+            s += ac->low >= range * symbols[i].low;
     }
 
-    ac->low -= range * symbols[s].low;
-    ac->range = range * symbols[s].range;
+    unsigned low = ac->low - range * symbols[s].low;
+    range *= symbols[s].range;
+
+    /* --- Renormalization ---
+     * The range cannot be less than 2^6, at most 2 bytes are shifted.
+     * They are read in place, the generic renormalization takes care
+     * of the end of the buffer. */
+
+    struct lc3_bits_buffer *buffer = &bits->buffer;
+
+    if (range < 0x10000 && buffer->end - buffer->p_fw >= 2) {
+        const uint8_t *p = buffer->p_fw;
+        int n = range < 0x100 ? 2 : 1;
+
+        unsigned v = n > 1 ? ((unsigned)p[0] << 8) | p[1] : p[0];
+        buffer->p_fw += n;
+
+        low = ((low << (8*n)) | v) & 0xffffff;
+        range <<= 8*n;
+    }
+
+    ac->low = low;
+    ac->range = range;
 
     if (ac->range < 0x10000)
         lc3_ac_read_renorm(bits);
@@ -76,7 +76,9 @@ enum lc3_bandwidth lc3_bwdet_run(
     };
 
     /* --- Stage 1 ---
-     * Determine bw0 candidate */
+     * Determine bw0 candidate, as the highest region over the threshold.
+     * The regions are checked from the highest one, so the search stops
+     * on the first region found */
 
     enum lc3_bandwidth bw0 = LC3_BANDWIDTH_NB;
     enum lc3_bandwidth bwn = (enum lc3_bandwidth)sr;
@@ -86,7 +88,7 @@ enum lc3_bandwidth lc3_bwdet_run(
 
     const struct region *bwr = bws_table[dt][bwn-1];
 
-    for (enum lc3_bandwidth bw = bw0; bw < bwn; bw++) {
+    for (int bw = bwn-1; bw0 == LC3_BANDWIDTH_NB && bw >= 0; bw--) {
         int i = bwr[bw].is, ie = bwr[bw].ie;
         int n = ie - i;
 
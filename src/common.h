@@ -24,6 +24,7 @@
 
 #include <limits.h>
 #include <stdalign.h>
+#include <stddef.h>
 #include <string.h>
 
 #ifdef __ARM_ARCH
@@ -103,6 +104,76 @@
 #endif /* __ARM_FEATURE_SAT */
 
 
+/**
+ * Flush of denormals to zero
+ * lc3_ftz_enter() Set the FTZ/DAZ modes, return the previous control word
+ * lc3_ftz_leave() Restore the control word returned by `lc3_ftz_enter()`
+ *
+ * The states of the filters decay to denormals, on fade-out and silent
+ * inputs, that are processed much slower by the FPU. The modes are set
+ * for the scope of the processing of a frame only.
+ */
+
+#ifndef LC3_FTZ
+#define LC3_FTZ 1
+#endif
+
+#if LC3_FTZ && defined(__SSE__)
+
+#include <xmmintrin.h>
+
+typedef unsigned lc3_fpcr_t;
+
+static inline lc3_fpcr_t lc3_ftz_enter(void) {
+    lc3_fpcr_t csr = _mm_getcsr();
+    _mm_setcsr(csr | 0x8040);
+    return csr;
+}
+
+static inline void lc3_ftz_leave(lc3_fpcr_t csr) {
+    _mm_setcsr(csr);
+}
+
+#elif LC3_FTZ && defined(__aarch64__)
+
+typedef uint64_t lc3_fpcr_t;
+
+static inline lc3_fpcr_t lc3_ftz_enter(void) {
+    lc3_fpcr_t fpcr;
+    __asm__ volatile ("mrs %0, fpcr" : "=r"(fpcr));
+    __asm__ volatile ("msr fpcr, %0" : : "r"(fpcr | (1 << 24)));
+    return fpcr;
+}
+
+static inline void lc3_ftz_leave(lc3_fpcr_t fpcr) {
+    __asm__ volatile ("msr fpcr, %0" : : "r"(fpcr));
+}
+
+#elif LC3_FTZ && defined(__arm__) && defined(__ARM_FP)
+
+typedef uint32_t lc3_fpcr_t;
+
+static inline lc3_fpcr_t lc3_ftz_enter(void) {
+    lc3_fpcr_t fpscr;
+    __asm__ volatile ("vmrs %0, fpscr" : "=r"(fpscr));
+    __asm__ volatile ("vmsr fpscr, %0" : : "r"(fpscr | (1 << 24)));
+    return fpscr;
+}
+
+static inline void lc3_ftz_leave(lc3_fpcr_t fpscr) {
+    __asm__ volatile ("vmsr fpscr, %0" : : "r"(fpscr));
+}
+
+#else
+
+typedef int lc3_fpcr_t;
+
+static inline lc3_fpcr_t lc3_ftz_enter(void) { return 0; }
+static inline void lc3_ftz_leave(lc3_fpcr_t fpcr) { (void)fpcr; }
+
+#endif
+
+
 /**
  * Return `true` when high-resolution mode
  */
@@ -157,6 +157,30 @@ static inline float lc3_log10f(float x)
     return log10f(2) * lc3_log2f(x);
 }
 
+/**
+ * Table of the `10 * log10(x)` approximation, in Q15
+ */
+static const uint16_t lc3_db_q16_table[32][2] = {
+
+    /* [n][0] = 10 * log10(2) * log2(1 + n/32), with n = [0..15]     */
+    /* [n][1] = [n+1][0] - [n][0] (while defining [16][0])           */
+
+    {     0, 4379 }, {  4379, 4248 }, {  8627, 4125 }, { 12753, 4009 },
+    { 16762, 3899 }, { 20661, 3795 }, { 24456, 3697 }, { 28153, 3603 },
+    { 31755, 3514 }, { 35269, 3429 }, { 38699, 3349 }, { 42047, 3272 },
+    { 45319, 3198 }, { 48517, 3128 }, { 51645, 3061 }, { 54705, 2996 },
+
+    /* [n][0] = 10 * log10(2) * log2(1 + n/32) - 10 * log10(2) / 2,  */
+    /*     with n = [16..31]                                         */
+    /* [n][1] = [n+1][0] - [n][0] (while defining [32][0])           */
+
+    {  8381, 2934 }, { 11315, 2875 }, { 14190, 2818 }, { 17008, 2763 },
+    { 19772, 2711 }, { 22482, 2660 }, { 25142, 2611 }, { 27754, 2564 },
+    { 30318, 2519 }, { 32837, 2475 }, { 35312, 2433 }, { 37744, 2392 },
+    { 40136, 2352 }, { 42489, 2314 }, { 44803, 2277 }, { 47080, 2241 },
+
+};
+
 /**
  * Fast `10 * log10(x)` (or dB) approximation in fixed Q16
  * x               Operand, in range 2^-63 to 2^63 (1e-19 to 1e19)
@@ -167,28 +191,7 @@ static inline float lc3_log10f(float x)
  */
 static inline int32_t lc3_db_q16(float x)
 {
-    /* --- Table in Q15 --- */
-
-    static const uint16_t t[][2] = {
-
-        /* [n][0] = 10 * log10(2) * log2(1 + n/32), with n = [0..15]     */
-        /* [n][1] = [n+1][0] - [n][0] (while defining [16][0])           */
-
-        {     0, 4379 }, {  4379, 4248 }, {  8627, 4125 }, { 12753, 4009 },
-        { 16762, 3899 }, { 20661, 3795 }, { 24456, 3697 }, { 28153, 3603 },
-        { 31755, 3514 }, { 35269, 3429 }, { 38699, 3349 }, { 42047, 3272 },
-        { 45319, 3198 }, { 48517, 3128 }, { 51645, 3061 }, { 54705, 2996 },
-
-        /* [n][0] = 10 * log10(2) * log2(1 + n/32) - 10 * log10(2) / 2,  */
-        /*     with n = [16..31]                                         */
-        /* [n][1] = [n+1][0] - [n][0] (while defining [32][0])           */
-
-        {  8381, 2934 }, { 11315, 2875 }, { 14190, 2818 }, { 17008, 2763 },
-        { 19772, 2711 }, { 22482, 2660 }, { 25142, 2611 }, { 27754, 2564 },
-        { 30318, 2519 }, { 32837, 2475 }, { 35312, 2433 }, { 37744, 2392 },
-        { 40136, 2352 }, { 42489, 2314 }, { 44803, 2277 }, { 47080, 2241 },
-
-    };
+    const uint16_t (*t)[2] = lc3_db_q16_table;
 
     /* --- Approximation ---
      *
@@ -31,6 +31,9 @@
 #include "spec.h"
 #include "plc.h"
 
+#include "pcm_neon.h"
+#include "pcm_wasm.h"
+
 
 /**
  * Frame side data
@@ -182,6 +185,38 @@ LC3_EXPORT int lc3_delay_samples(int dt_us, int sr_hz)
  *  Encoder
  * -------------------------------------------------------------------------- */
 
+/**
+ * Convert PCM samples from signed 16 bits
+ * pcm, stride     Input PCM samples, and count between two consecutives
+ * n               Count of samples
+ * xt, xs          Output samples, as 16 bits integers and as floats
+ */
+#ifndef pcm_from_s16
+LC3_HOT static void pcm_from_s16(
+    const int16_t *pcm, int stride, int n, int16_t *xt, float *xs)
+{
+    for (int i = 0; i < n; i++, pcm += stride)
+        xt[i] = *pcm, xs[i] = *pcm;
+}
+#endif /* pcm_from_s16 */
+
+/**
+ * Convert PCM samples from float 32 bits
+ * pcm, stride     Input PCM samples, and count between two consecutives
+ * n               Count of samples
+ * xt, xs          Output samples, as 16 bits integers and as floats
+ */
+#ifndef pcm_from_float
+LC3_HOT static void pcm_from_float(
+    const float *pcm, int stride, int n, int16_t *xt, float *xs)
+{
+    for (int i = 0; i < n; i++, pcm += stride) {
+        xs[i] = lc3_ldexpf(*pcm, 15);
+        xt[i] = LC3_SAT16((int32_t)xs[i]);
+    }
+}
+#endif /* pcm_from_float */
+
 /**
  * Input PCM Samples from signed 16 bits
  * encoder         Encoder state
@@ -199,8 +234,7 @@ static void load_s16(
     float *xs = encoder->x + encoder->xs_off;
     int ns = lc3_ns(dt, sr);
 
-    for (int i = 0; i < ns; i++, pcm += stride)
-        xt[i] = *pcm, xs[i] = *pcm;
+    pcm_from_s16(pcm, stride, ns, xt, xs);
 }
 
 /**
@@ -270,20 +304,55 @@ static void load_float(
     float *xs = encoder->x + encoder->xs_off;
     int ns = lc3_ns(dt, sr);
 
-    for (int i = 0; i < ns; i++, pcm += stride) {
-        xs[i] = lc3_ldexpf(*pcm, 15);
-        xt[i] = LC3_SAT16((int32_t)xs[i]);
+    pcm_from_float(pcm, stride, ns, xt, xs);
+}
+
+/**
+ * Frame Analysis, stages depending on the size of the frame
+ * dt, sr          Duration and samplerate of the frame
+ * nbytes          Size in bytes of the frame, maximum size in VBR mode
+ * min_nbytes      Minimum size in VBR mode, `nbytes` otherwise
+ * quality         Quality target in VBR mode, in dB
+ * att, nn_flag    Attack and near-nyquist detection flags
+ * e               Energy estimation per bands
+ * spec            Spectral analysis state
+ * x               Spectral coefficients, shaped and quantized as output
+ * side            Frame data, `bw` and `pitch_present` set, completed
+ * return          Size in bytes of the frame
+ *
+ * In VBR mode, the SNS and TNS analysis are done for the maximum size.
+ */
+static int analyze_rate(enum lc3_dt dt, enum lc3_srate sr,
+    int nbytes, int min_nbytes, float quality,
+    bool att, bool nn_flag, const float *e,
+    lc3_spec_analysis_t *spec, float *x, struct side_data *side)
+{
+    lc3_sns_analyze(dt, sr, nbytes, e, att, &side->sns, x, x);
+
+    lc3_tns_analyze(dt, side->bw, nn_flag, nbytes, &side->tns, x);
+
+    if (min_nbytes < nbytes) {
+        nbytes = lc3_spec_estimate_nbytes(dt, sr, side->bw, side->pitch_present,
+            &side->tns, spec, x, quality, min_nbytes, nbytes);
+        lc3_tns_resize(dt, nbytes, &side->tns);
     }
+
+    lc3_spec_analyze(dt, sr,
+        nbytes, side->pitch_present, &side->tns, spec, x, &side->spec);
+
+    return nbytes;
 }
 
 /**
- * Frame Analysis
+ * Frame Analysis, stages not depending on the size of the frame
  * encoder         Encoder state
- * nbytes          Size in bytes of the frame
- * side            Return frame data
+ * nbytes          Size in bytes of the frame, for the attack detection
+ * e               Return the energy estimation per bands
+ * att, nn_flag    Return the attack and near-nyquist detection flags
+ * side            Return frame data, `bw` and `pitch_present` set
  */
-static void analyze(struct lc3_encoder *encoder,
-    int nbytes, struct side_data *side)
+static void analyze_frame(struct lc3_encoder *encoder, int nbytes,
+    float *e, bool *att, bool *nn_flag, struct side_data *side)
 {
     enum lc3_dt dt = encoder->dt;
     enum lc3_srate sr = encoder->sr;
@@ -299,7 +368,7 @@ static void analyze(struct lc3_encoder *encoder,
 
     /* --- Temporal --- */
 
-    bool att = lc3_attdet_run(dt, sr_pcm, nbytes, &encoder->attdet, xt);
+    *att = lc3_attdet_run(dt, sr_pcm, nbytes, &encoder->attdet, xt);
 
     side->pitch_present = !encoder->ltpf_bypass &&
         lc3_ltpf_analyse(dt, sr_pcm, &encoder->ltpf, xt, &side->ltpf);
@@ -308,39 +377,48 @@ static void analyze(struct lc3_encoder *encoder,
 
     /* --- Spectral --- */
 
-    float e[LC3_MAX_BANDS];
-
     lc3_mdct_forward(dt, sr_pcm, sr, xs, xd, xf);
 
-    bool nn_flag = lc3_energy_compute(dt, sr, xf, e);
-    if (nn_flag || encoder->ltpf_bypass)
+    *nn_flag = lc3_energy_compute(dt, sr, xf, e);
+    if (*nn_flag || encoder->ltpf_bypass)
         lc3_ltpf_disable(&side->ltpf);
 
     side->bw = lc3_bwdet_run(dt, sr, e);
+}
 
-    lc3_sns_analyze(dt, sr, nbytes, e, att, &side->sns, xf, xf);
+/**
+ * Frame Analysis
+ * encoder         Encoder state
+ * nbytes          Size in bytes of the frame, maximum size in VBR mode
+ * min_nbytes      Minimum size in VBR mode, `nbytes` otherwise
+ * quality         Quality target in VBR mode, in dB
+ * side            Return frame data
+ * return          Size in bytes of the frame
+ */
+static int analyze(struct lc3_encoder *encoder,
+    int nbytes, int min_nbytes, float quality, struct side_data *side)
+{
+    float e[LC3_MAX_BANDS];
+    bool att, nn_flag;
 
-    lc3_tns_analyze(dt, side->bw, nn_flag, nbytes, &side->tns, xf);
+    analyze_frame(encoder, nbytes, e, &att, &nn_flag, side);
 
-    lc3_spec_analyze(dt, sr,
-        nbytes, side->pitch_present, &side->tns,
-        &encoder->spec, xf, &side->spec);
+    return analyze_rate(encoder->dt, encoder->sr, nbytes, min_nbytes,
+        quality, att, nn_flag, e, &encoder->spec,
+        encoder->x + encoder->xs_off, side);
 }
 
 /**
  * Encode bitstream
- * encoder         Encoder state
+ * dt, sr          Duration and samplerate of the frame
  * side            The frame data
+ * x               Spectral coefficients, as output by the analysis
  * nbytes          Target size of the frame (20 to 400)
  * buffer          Output bitstream buffer of `nbytes` size
  */
-static void encode(struct lc3_encoder *encoder,
-    const struct side_data *side, int nbytes, void *buffer)
+static void encode(enum lc3_dt dt, enum lc3_srate sr,
+    const struct side_data *side, float *x, int nbytes, void *buffer)
 {
-    enum lc3_dt dt = encoder->dt;
-    enum lc3_srate sr = encoder->sr;
-
-    float *xf = encoder->x + encoder->xs_off;
     enum lc3_bandwidth bw = side->bw;
 
     lc3_bits_t bits;
@@ -360,7 +438,7 @@ static void encode(struct lc3_encoder *encoder,
     if (side->pitch_present)
         lc3_ltpf_put_data(&bits, &side->ltpf);
 
-    lc3_spec_encode(&bits, dt, sr, bw, nbytes, &side->spec, xf);
+    lc3_spec_encode(&bits, dt, sr, bw, nbytes, &side->spec, x);
 
     lc3_flush_bits(&bits);
 }
@@ -430,216 +508,935 @@ LC3_EXPORT void lc3_encoder_disable_ltpf(
     encoder->ltpf_bypass = true;
 }
 
+LC3_EXPORT void lc3_encoder_enable_pitch_tracking(
+    struct lc3_encoder *encoder)
+{
+    encoder->ltpf.track = true;
+}
+
 /**
- * Encode a frame
+ * Return size needed for an encoder snapshot
  */
-LC3_EXPORT int lc3_encode(struct lc3_encoder *encoder,
-    enum lc3_pcm_format fmt, const void *pcm, int stride, int nbytes, void *out)
+LC3_EXPORT unsigned lc3_hr_encoder_snapshot_size(
+    bool hrmode, int dt_us, int sr_hz)
 {
-    static void (* const load[])(struct lc3_encoder *, const void *, int) = {
-        [LC3_PCM_FORMAT_S16    ] = load_s16,
-        [LC3_PCM_FORMAT_S24    ] = load_s24,
-        [LC3_PCM_FORMAT_S24_3LE] = load_s24_3le,
-        [LC3_PCM_FORMAT_FLOAT  ] = load_float,
-    };
+    if (resolve_dt(dt_us, hrmode) >= LC3_NUM_DT ||
+        resolve_srate(sr_hz, hrmode) >= LC3_NUM_SRATE)
+        return 0;
 
-    /* --- Check parameters --- */
+    return sizeof(struct lc3_encoder_snapshot) +
+        (LC3_ENCODER_SNAPSHOT_BUFFER_COUNT(dt_us, sr_hz)-1) * sizeof(float);
+}
 
-    if (!encoder || nbytes < lc3_min_frame_bytes(encoder->dt, encoder->sr)
-                 || nbytes > lc3_max_frame_bytes(encoder->dt, encoder->sr))
-        return -1;
+LC3_EXPORT unsigned lc3_encoder_snapshot_size(int dt_us, int sr_hz)
+{
+    return lc3_hr_encoder_snapshot_size(false, dt_us, sr_hz);
+}
 
-    /* --- Processing --- */
+/**
+ * Snapshot the state of an encoder
+ */
+LC3_EXPORT int lc3_encoder_snapshot(
+    const struct lc3_encoder *encoder, void *mem)
+{
+    if (!encoder || !mem)
+        return -1;
 
-    struct side_data side;
+    struct lc3_encoder_snapshot *snapshot = mem;
+    enum lc3_dt dt = encoder->dt;
+    enum lc3_srate sr_pcm = encoder->sr_pcm;
+    int nt = lc3_nt(sr_pcm), nd = lc3_nd(dt, sr_pcm);
 
-    load[fmt](encoder, pcm, stride);
+    *snapshot = (struct lc3_encoder_snapshot){
+        .dt = dt, .sr_pcm = sr_pcm,
+        .attdet = encoder->attdet, .ltpf = encoder->ltpf,
+        .spec = encoder->spec,
+    };
 
-    analyze(encoder, nbytes, &side);
+    memcpy(snapshot->x, (const int16_t *)encoder->x + encoder->xt_off - nt,
+        nt * sizeof(int16_t));
 
-    encode(encoder, &side, nbytes, out);
+    memcpy(snapshot->x + (nt + 1) / 2, encoder->x + encoder->xd_off,
+        nd * sizeof(float));
 
     return 0;
 }
 
-
-/* ----------------------------------------------------------------------------
- *  Decoder
- * -------------------------------------------------------------------------- */
-
 /**
- * Output PCM Samples to signed 16 bits
- * decoder         Decoder state
- * pcm, stride     Output PCM samples, and count between two consecutives
+ * Restore the state of an encoder
  */
-static void store_s16(
-    struct lc3_decoder *decoder, void *_pcm, int stride)
+LC3_EXPORT int lc3_encoder_restore(
+    struct lc3_encoder *encoder, const void *mem)
 {
-    int16_t *pcm = _pcm;
-
-    enum lc3_dt dt = decoder->dt;
-    enum lc3_srate sr = decoder->sr_pcm;
+    const struct lc3_encoder_snapshot *snapshot = mem;
 
-    float *xs = decoder->x + decoder->xs_off;
-    int ns = lc3_ns(dt, sr);
+    if (!encoder || !snapshot || snapshot->dt != encoder->dt
+                              || snapshot->sr_pcm != encoder->sr_pcm)
+        return -1;
 
-    for ( ; ns > 0; ns--, xs++, pcm += stride) {
-        int32_t s = *xs >= 0 ? (int)(*xs + 0.5f) : (int)(*xs - 0.5f);
-        *pcm = LC3_SAT16(s);
-    }
-}
+    enum lc3_dt dt = encoder->dt;
+    enum lc3_srate sr_pcm = encoder->sr_pcm;
+    int nt = lc3_nt(sr_pcm), nd = lc3_nd(dt, sr_pcm);
 
-/**
- * Output PCM Samples to signed 24 bits
- * decoder         Decoder state
- * pcm, stride     Output PCM samples, and count between two consecutives
- */
-static void store_s24(
-    struct lc3_decoder *decoder, void *_pcm, int stride)
-{
-    int32_t *pcm = _pcm;
+    encoder->attdet = snapshot->attdet;
+    encoder->ltpf = snapshot->ltpf;
+    encoder->spec = snapshot->spec;
 
-    enum lc3_dt dt = decoder->dt;
-    enum lc3_srate sr = decoder->sr_pcm;
+    memcpy((int16_t *)encoder->x + encoder->xt_off - nt, snapshot->x,
+        nt * sizeof(int16_t));
 
-    float *xs = decoder->x + decoder->xs_off;
-    int ns = lc3_ns(dt, sr);
+    memcpy(encoder->x + encoder->xd_off, snapshot->x + (nt + 1) / 2,
+        nd * sizeof(float));
 
-    for ( ; ns > 0; ns--, xs++, pcm += stride) {
-        int32_t s = *xs >= 0 ? (int32_t)(lc3_ldexpf(*xs, 8) + 0.5f)
-                             : (int32_t)(lc3_ldexpf(*xs, 8) - 0.5f);
-        *pcm = LC3_SAT24(s);
-    }
+    return 0;
 }
 
 /**
- * Output PCM Samples to signed 24 bits packed
- * decoder         Decoder state
- * pcm, stride     Output PCM samples, and count between two consecutives
+ * Encode a frame, in variable bitrate mode
  */
-static void store_s24_3le(
-    struct lc3_decoder *decoder, void *_pcm, int stride)
+LC3_EXPORT int lc3_encode_vbr(struct lc3_encoder *encoder,
+    enum lc3_pcm_format fmt, const void *pcm, int stride,
+    float quality, int min_nbytes, int max_nbytes, void *out)
 {
-    uint8_t *pcm = _pcm;
+    static void (* const load[])(struct lc3_encoder *, const void *, int) = {
+        [LC3_PCM_FORMAT_S16    ] = load_s16,
+        [LC3_PCM_FORMAT_S24    ] = load_s24,
+        [LC3_PCM_FORMAT_S24_3LE] = load_s24_3le,
+        [LC3_PCM_FORMAT_FLOAT  ] = load_float,
+    };
 
-    enum lc3_dt dt = decoder->dt;
-    enum lc3_srate sr = decoder->sr_pcm;
+    /* --- Check parameters --- */
 
-    float *xs = decoder->x + decoder->xs_off;
-    int ns = lc3_ns(dt, sr);
+    if (!encoder || min_nbytes > max_nbytes
+            || min_nbytes < lc3_min_frame_bytes(encoder->dt, encoder->sr)
+            || max_nbytes > lc3_max_frame_bytes(encoder->dt, encoder->sr))
+        return -1;
 
-    for ( ; ns > 0; ns--, xs++, pcm += 3*stride) {
-        int32_t s = *xs >= 0 ? (int32_t)(lc3_ldexpf(*xs, 8) + 0.5f)
-                             : (int32_t)(lc3_ldexpf(*xs, 8) - 0.5f);
+    /* --- Processing --- */
 
-        s = LC3_SAT24(s);
-        pcm[0] = (s >>  0) & 0xff;
-        pcm[1] = (s >>  8) & 0xff;
-        pcm[2] = (s >> 16) & 0xff;
-    }
-}
+    struct side_data side;
+    lc3_fpcr_t fpcr = lc3_ftz_enter();
 
-/**
- * Output PCM Samples to float 32 bits
- * decoder         Decoder state
- * pcm, stride     Output PCM samples, and count between two consecutives
- */
-static void store_float(
-    struct lc3_decoder *decoder, void *_pcm, int stride)
-{
-    float *pcm = _pcm;
+    load[fmt](encoder, pcm, stride);
 
-    enum lc3_dt dt = decoder->dt;
-    enum lc3_srate sr = decoder->sr_pcm;
+    int nbytes = analyze(encoder, max_nbytes, min_nbytes, quality, &side);
 
-    float *xs = decoder->x + decoder->xs_off;
-    int ns = lc3_ns(dt, sr);
+    encode(encoder->dt, encoder->sr,
+        &side, encoder->x + encoder->xs_off, nbytes, out);
 
-    for ( ; ns > 0; ns--, xs++, pcm += stride) {
-        float s = lc3_ldexpf(*xs, -15);
-        *pcm = fminf(fmaxf(s, -1.f), 1.f);
-    }
+    lc3_ftz_leave(fpcr);
+
+    return nbytes;
 }
 
 /**
- * Decode bitstream
- * decoder         Decoder state
- * data, nbytes    Input bitstream buffer
- * side            Return the side data
- * return          0: Ok  < 0: Bitsream error detected
+ * Estimate the size of a frame for quality targets
  */
-static int decode(struct lc3_decoder *decoder,
-    const void *data, int nbytes, struct side_data *side)
+LC3_EXPORT int lc3_encode_estimate(struct lc3_encoder *encoder,
+    enum lc3_pcm_format fmt, const void *pcm, int stride, int nquality,
+    const float *quality, int min_nbytes, int max_nbytes, int *nbytes)
 {
-    enum lc3_dt dt = decoder->dt;
-    enum lc3_srate sr = decoder->sr;
+    static void (* const load[])(struct lc3_encoder *, const void *, int) = {
+        [LC3_PCM_FORMAT_S16    ] = load_s16,
+        [LC3_PCM_FORMAT_S24    ] = load_s24,
+        [LC3_PCM_FORMAT_S24_3LE] = load_s24_3le,
+        [LC3_PCM_FORMAT_FLOAT  ] = load_float,
+    };
 
-    float *xf = decoder->x + decoder->xs_off;
-    int ns = lc3_ns(dt, sr);
-    int ne = lc3_ne(dt, sr);
+    /* --- Check parameters --- */
 
-    lc3_bits_t bits;
-    int ret = 0;
+    if (!encoder || min_nbytes > max_nbytes
+            || min_nbytes < lc3_min_frame_bytes(encoder->dt, encoder->sr)
+            || max_nbytes > lc3_max_frame_bytes(encoder->dt, encoder->sr))
+        return -1;
 
-    lc3_setup_bits(&bits, LC3_BITS_MODE_READ, (void *)data, nbytes);
+    /* --- Processing --- */
 
-    if ((ret = lc3_bwdet_get_bw(&bits, sr, &side->bw)) < 0)
-        return ret;
+    enum lc3_dt dt = encoder->dt;
+    enum lc3_srate sr = encoder->sr;
+    float *xf = encoder->x + encoder->xs_off;
 
-    if ((ret = lc3_spec_get_side(&bits, dt, sr, &side->spec)) < 0)
-        return ret;
+    struct side_data side;
+    float e[LC3_MAX_BANDS];
+    bool att, nn_flag;
 
-    if ((ret = lc3_tns_get_data(&bits, dt, side->bw, nbytes, &side->tns)) < 0)
-        return ret;
+    lc3_fpcr_t fpcr = lc3_ftz_enter();
 
-    side->pitch_present = lc3_get_bit(&bits);
+    load[fmt](encoder, pcm, stride);
 
-    if ((ret = lc3_sns_get_data(&bits, &side->sns)) < 0)
-        return ret;
+    analyze_frame(encoder, max_nbytes, e, &att, &nn_flag, &side);
 
-    if (side->pitch_present)
-      lc3_ltpf_get_data(&bits, &side->ltpf);
+    lc3_sns_analyze(dt, sr, max_nbytes, e, att, &side.sns, xf, xf);
 
-    if ((ret = lc3_spec_decode(&bits, dt, sr,
-                    side->bw, nbytes, &side->spec, xf)) < 0)
-        return ret;
+    lc3_tns_analyze(dt, side.bw, nn_flag, max_nbytes, &side.tns, xf);
 
-    memset(xf + ne, 0, (ns - ne) * sizeof(float));
+    for (int i = 0; i < nquality; i++)
+        nbytes[i] = lc3_spec_estimate_nbytes(dt, sr, side.bw,
+            side.pitch_present, &side.tns, &encoder->spec, xf,
+            quality[i], min_nbytes, max_nbytes);
 
-    return lc3_check_bits(&bits);
+    lc3_ftz_leave(fpcr);
+
+    return 0;
 }
 
 /**
- * Frame synthesis
- * decoder         Decoder state
- * side            Frame data, NULL performs PLC
- * nbytes          Size in bytes of the frame
+ * Encode a frame
  */
-static void synthesize(struct lc3_decoder *decoder,
-    const struct side_data *side, int nbytes)
+LC3_EXPORT int lc3_encode(struct lc3_encoder *encoder,
+    enum lc3_pcm_format fmt, const void *pcm, int stride, int nbytes, void *out)
 {
-    enum lc3_dt dt = decoder->dt;
-    enum lc3_srate sr = decoder->sr;
-    enum lc3_srate sr_pcm = decoder->sr_pcm;
-
-    float *xf = decoder->x + decoder->xs_off;
-    int ns = lc3_ns(dt, sr_pcm);
-    int ne = lc3_ne(dt, sr);
+    return lc3_encode_vbr(encoder,
+        fmt, pcm, stride, 0, nbytes, nbytes, out) < 0 ? -1 : 0;
+}
 
-    float *xg = decoder->x + decoder->xg_off;
-    float *xs = xf;
+/**
+ * Setup the redundant copies of an encoder
+ */
+LC3_EXPORT void lc3_setup_fec_encoder(struct lc3_fec_encoder *fec)
+{
+    if (fec)
+        *fec = (struct lc3_fec_encoder){ 0 };
+}
 
-    float *xd = decoder->x + decoder->xd_off;
-    float *xh = decoder->x + decoder->xh_off;
+/**
+ * Encode a frame, with a redundant copy of the previous frame
+ */
+LC3_EXPORT int lc3_encode_fec(
+    struct lc3_encoder *encoder, struct lc3_fec_encoder *fec,
+    enum lc3_pcm_format fmt, const void *pcm, int stride,
+    int nbytes, int fec_nbytes, void *out)
+{
+    static void (* const load[])(struct lc3_encoder *, const void *, int) = {
+        [LC3_PCM_FORMAT_S16    ] = load_s16,
+        [LC3_PCM_FORMAT_S24    ] = load_s24,
+        [LC3_PCM_FORMAT_S24_3LE] = load_s24_3le,
+        [LC3_PCM_FORMAT_FLOAT  ] = load_float,
+    };
 
-    if (side) {
-        enum lc3_bandwidth bw = side->bw;
+    /* --- Check parameters --- */
 
-        lc3_plc_suspend(&decoder->plc);
+    if (!encoder || !fec
+            || nbytes < lc3_min_frame_bytes(encoder->dt, encoder->sr)
+            || nbytes > lc3_max_frame_bytes(encoder->dt, encoder->sr))
+        return -1;
 
-        lc3_tns_synthesize(dt, bw, &side->tns, xf);
+    if (fec_nbytes && (fec_nbytes > LC3_MIN(nbytes, LC3_FEC_MAX_FRAME_BYTES)
+            || fec_nbytes < lc3_min_frame_bytes(encoder->dt, encoder->sr)))
+        return -1;
 
-        lc3_sns_synthesize(dt, sr, &side->sns, xf, xg);
+    /* --- Analysis --- */
+
+    enum lc3_dt dt = encoder->dt;
+    enum lc3_srate sr = encoder->sr;
+    float *xf = encoder->x + encoder->xs_off;
+
+    struct side_data side;
+    float e[LC3_MAX_BANDS];
+    bool att, nn_flag;
+
+    lc3_fpcr_t fpcr = lc3_ftz_enter();
+
+    load[fmt](encoder, pcm, stride);
+
+    analyze_frame(encoder, nbytes, e, &att, &nn_flag, &side);
+
+    lc3_sns_analyze(dt, sr, nbytes, e, att, &side.sns, xf, xf);
+
+    lc3_tns_analyze(dt, side.bw, nn_flag, nbytes, &side.tns, xf);
+
+    float x[LC3_MAX_NS];
+    if (fec_nbytes)
+        memcpy(x, xf, lc3_ns(dt, sr) * sizeof(*x));
+
+    /* --- Frame, and redundant copy of the previous frame --- */
+
+    uint8_t *p = out;
+
+    lc3_spec_analyze(dt, sr,
+        nbytes, side.pitch_present, &side.tns, &encoder->spec, xf, &side.spec);
+
+    encode(dt, sr, &side, xf, nbytes, p);
+    p += nbytes;
+
+    memcpy(p, fec->frame, fec->nbytes);
+    p += fec->nbytes;
+
+    *(p++) = fec->nbytes;
+
+    /* --- Redundant copy, sent with the next frame --- */
+
+    if ((fec->nbytes = fec_nbytes)) {
+        lc3_tns_resize(dt, fec_nbytes, &side.tns);
+
+        lc3_spec_analyze(dt, sr, fec_nbytes,
+            side.pitch_present, &side.tns, &fec->spec, x, &side.spec);
+
+        encode(dt, sr, &side, x, fec_nbytes, fec->frame);
+    }
+
+    lc3_ftz_leave(fpcr);
+
+    return p - (uint8_t *)out;
+}
+
+/**
+ * Setup a rate control
+ */
+LC3_EXPORT void lc3_setup_rate_control(struct lc3_rate_control *rc)
+{
+    if (rc)
+        *rc = (struct lc3_rate_control){ 0 };
+}
+
+/**
+ * Transport feedback to the rate control
+ */
+LC3_EXPORT int lc3_encoder_rate_feedback(
+    struct lc3_encoder *encoder, struct lc3_rate_control *rc,
+    float loss_rate, int delay_us, int budget_bytes, int interval_us)
+{
+    /* --- Check parameters --- */
+
+    if (!encoder || !rc || interval_us <= 0 || budget_bytes < 0 ||
+            !(loss_rate >= 0 && loss_rate <= 1))
+        return -1;
+
+    /* --- Budget and target size of the frames ---
+     * The target backs off multiplicatively on heavy loss, or when the
+     * queue builds up, and probes up otherwise. It is capped to the
+     * budget of the interval. */
+
+    int dt_us = 2500 * (1 + encoder->dt);
+
+    float min_nbytes = lc3_min_frame_bytes(encoder->dt, encoder->sr);
+    float max_nbytes = lc3_max_frame_bytes(encoder->dt, encoder->sr);
+
+    rc->budget = LC3_CLIP(
+        (float)budget_bytes * dt_us / interval_us, min_nbytes, max_nbytes);
+
+    rc->congested = delay_us > LC3_RATE_CONTROL_MAX_DELAY_US;
+
+    float nbytes = rc->nbytes > 0 ? rc->nbytes : rc->budget;
+
+    if (loss_rate > 0.1f)
+        nbytes *= 1 - 0.5f * loss_rate;
+    else if (rc->congested)
+        nbytes *= 0.85f;
+    else if (loss_rate < 0.02f)
+        nbytes *= 1.05f;
+
+    rc->nbytes = LC3_CLIP(nbytes, min_nbytes, rc->budget);
+
+    return 0;
+}
+
+/**
+ * Encode a frame, sized by the rate control
+ */
+LC3_EXPORT int lc3_encode_rate_control(
+    struct lc3_encoder *encoder, struct lc3_rate_control *rc,
+    enum lc3_pcm_format fmt, const void *pcm, int stride, void *out)
+{
+    /* --- Check parameters --- */
+
+    if (!encoder || !rc || rc->nbytes <= 0)
+        return -1;
+
+    /* --- Size of the frame ---
+     * The target is corrected by the bit consumption tracked by the
+     * encoder, as for the gain estimation in constant bitrate: the offset
+     * smoothed on the previous frames and the bits left by the last one.
+     * Frames following easy ones give bytes back, the others take more.
+     * The deviation to the target is carried over the next frames, so that
+     * the target is met on average. It is not exceeded when the queue of
+     * the transport builds up, and the deviation is then dropped. */
+
+    const lc3_spec_analysis_t *spec = &encoder->spec;
+
+    float nbits_off = spec->nbits_off + spec->nbits_spare;
+    nbits_off = fminf(fmaxf(nbits_off, -40), 40);
+
+    int min_nbytes = lc3_min_frame_bytes(encoder->dt, encoder->sr);
+    int max_nbytes = lc3_max_frame_bytes(encoder->dt, encoder->sr);
+
+    if (rc->congested)
+        max_nbytes = LC3_MAX((int)rc->nbytes, min_nbytes);
+
+    int nbytes = LC3_CLIP(
+        (int)(rc->nbytes - nbits_off / 8 - 0.5f * rc->carry + 0.5f),
+        min_nbytes, max_nbytes);
+
+    rc->carry = rc->congested ? 0 : rc->carry + nbytes - rc->nbytes;
+
+    return lc3_encode_vbr(encoder,
+        fmt, pcm, stride, 0, nbytes, nbytes, out);
+}
+
+/**
+ * Estimate the size of the frames of a block, for a quality target
+ * dt, sr          Duration and samplerate of the frames
+ * nchannels       Number of frames of the block
+ * encoders        Encoder state of each frame
+ * side            Frame data, analyzed up to the TNS
+ * quality         Quality target, in dB
+ * nbytes          Return the estimated size of each frame
+ * return          Sum of the sizes
+ */
+static int estimate_block(enum lc3_dt dt, enum lc3_srate sr, int nchannels,
+    struct lc3_encoder * const *encoders, const struct side_data *side,
+    float quality, int *nbytes)
+{
+    int sum = 0;
+
+    for (int ich = 0; ich < nchannels; ich++) {
+        const struct lc3_encoder *encoder = encoders[ich];
+
+        nbytes[ich] = lc3_spec_estimate_nbytes(dt, sr,
+            side[ich].bw, side[ich].pitch_present, &side[ich].tns,
+            &encoder->spec, encoder->x + encoder->xs_off, quality,
+            lc3_min_frame_bytes(dt, sr), lc3_max_frame_bytes(dt, sr));
+
+        sum += nbytes[ich];
+    }
+
+    return sum;
+}
+
+/**
+ * Share the bytes of a block between frames
+ * dt, sr          Duration and samplerate of the frames
+ * nchannels       Number of frames of the block
+ * encoders        Encoder state of each frame
+ * side            Frame data, analyzed up to the TNS
+ * block_bytes     Size in bytes of the block
+ * nbytes          Return the size of each frame
+ *
+ * The frames are sized for the highest common quality target, found by
+ * bisection, whose estimated sizes fit in the block. The bytes left are
+ * given first to the frames whose size grows with the quality target.
+ */
+static void share_block(enum lc3_dt dt, enum lc3_srate sr, int nchannels,
+    struct lc3_encoder * const *encoders, const struct side_data *side,
+    int block_bytes, int *nbytes)
+{
+    float q_lo = -20.f, q_hi = 100.f;
+    int lo[LC3_MAX_POOL_CHANNELS], hi[LC3_MAX_POOL_CHANNELS];
+
+    /* --- Bisection on the quality target --- */
+
+    int sum = estimate_block(dt, sr, nchannels, encoders, side, q_lo, lo);
+    memcpy(hi, lo, nchannels * sizeof(*hi));
+
+    if (sum <= block_bytes &&
+        estimate_block(dt, sr, nchannels, encoders, side, q_hi, hi)
+                > block_bytes) {
+
+        for (int i = 0; i < 8; i++) {
+            float q = (q_lo + q_hi) / 2;
+
+            if (estimate_block(dt, sr,
+                    nchannels, encoders, side, q, nbytes) <= block_bytes)
+                memcpy(lo, nbytes, nchannels * sizeof(*lo)), q_lo = q;
+            else
+                memcpy(hi, nbytes, nchannels * sizeof(*hi)), q_hi = q;
+        }
+    }
+
+    else if (sum <= block_bytes)
+        memcpy(lo, hi, nchannels * sizeof(*lo));
+
+    /* --- Fit the sizes to the block --- */
+
+    int max_nbytes = lc3_max_frame_bytes(dt, sr);
+
+    sum = 0;
+    for (int ich = 0; ich < nchannels; ich++)
+        sum += (nbytes[ich] = lo[ich]);
+
+    while (sum > block_bytes) {
+        int imax = 0;
+        for (int ich = 1; ich < nchannels; ich++)
+            imax = nbytes[ich] > nbytes[imax] ? ich : imax;
+
+        nbytes[imax]--, sum--;
+    }
+
+    for (int ich = 0; ich < nchannels && sum < block_bytes; ich++) {
+        int n = LC3_MIN(hi[ich] - nbytes[ich], block_bytes - sum);
+        nbytes[ich] += LC3_MAX(n, 0), sum += LC3_MAX(n, 0);
+    }
+
+    for (int ich = 0; sum < block_bytes; ich = (ich + 1) % nchannels)
+        if (nbytes[ich] < max_nbytes)
+            nbytes[ich]++, sum++;
+}
+
+/**
+ * Encode a block of frames, sharing the bytes between channels
+ */
+LC3_EXPORT int lc3_encode_pool(struct lc3_encoder * const *encoders,
+    int nchannels, enum lc3_pcm_format fmt, const void * const *pcm,
+    int stride, int block_bytes, int *nbytes, void *out)
+{
+    static void (* const load[])(struct lc3_encoder *, const void *, int) = {
+        [LC3_PCM_FORMAT_S16    ] = load_s16,
+        [LC3_PCM_FORMAT_S24    ] = load_s24,
+        [LC3_PCM_FORMAT_S24_3LE] = load_s24_3le,
+        [LC3_PCM_FORMAT_FLOAT  ] = load_float,
+    };
+
+    /* --- Check parameters --- */
+
+    if (!encoders || !pcm || !nbytes || !out
+            || nchannels < 1 || nchannels > LC3_MAX_POOL_CHANNELS)
+        return -1;
+
+    for (int ich = 0; ich < nchannels; ich++)
+        if (!encoders[ich] || encoders[ich]->dt != encoders[0]->dt ||
+                              encoders[ich]->sr != encoders[0]->sr   )
+            return -1;
+
+    enum lc3_dt dt = encoders[0]->dt;
+    enum lc3_srate sr = encoders[0]->sr;
+
+    if (block_bytes < nchannels * lc3_min_frame_bytes(dt, sr) ||
+        block_bytes > nchannels * lc3_max_frame_bytes(dt, sr)   )
+        return -1;
+
+    /* --- Analysis, on an even share of the block --- */
+
+    struct side_data side[LC3_MAX_POOL_CHANNELS];
+    lc3_fpcr_t fpcr = lc3_ftz_enter();
+
+    for (int ich = 0; ich < nchannels; ich++) {
+        struct lc3_encoder *encoder = encoders[ich];
+        float *xf = encoder->x + encoder->xs_off;
+        int share = block_bytes / nchannels + (ich < block_bytes % nchannels);
+
+        float e[LC3_MAX_BANDS];
+        bool att, nn_flag;
+
+        load[fmt](encoder, pcm[ich], stride);
+
+        analyze_frame(encoder, share, e, &att, &nn_flag, &side[ich]);
+
+        lc3_sns_analyze(dt, sr, share, e, att, &side[ich].sns, xf, xf);
+
+        lc3_tns_analyze(dt, side[ich].bw, nn_flag, share, &side[ich].tns, xf);
+    }
+
+    /* --- Sizes, quantization and encoding --- */
+
+    share_block(dt, sr, nchannels, encoders, side, block_bytes, nbytes);
+
+    uint8_t *frame = out;
+
+    for (int ich = 0; ich < nchannels; ich++) {
+        struct lc3_encoder *encoder = encoders[ich];
+        float *xf = encoder->x + encoder->xs_off;
+
+        lc3_tns_resize(dt, nbytes[ich], &side[ich].tns);
+
+        lc3_spec_analyze(dt, sr, nbytes[ich], side[ich].pitch_present,
+            &side[ich].tns, &encoder->spec, xf, &side[ich].spec);
+
+        encode(dt, sr, &side[ich], xf, nbytes[ich], frame);
+
+        frame += nbytes[ich];
+    }
+
+    lc3_ftz_leave(fpcr);
+
+    return 0;
+}
+
+/**
+ * Return size needed for a multi-rendition encoder
+ */
+LC3_EXPORT unsigned lc3_hr_multi_encoder_size(
+    bool hrmode, int dt_us, int sr_pcm_hz)
+{
+    unsigned size = lc3_hr_encoder_size(hrmode, dt_us, sr_pcm_hz);
+
+    return size ? size + offsetof(struct lc3_multi_encoder, encoder) : 0;
+}
+
+LC3_EXPORT unsigned lc3_multi_encoder_size(int dt_us, int sr_pcm_hz)
+{
+    return lc3_hr_multi_encoder_size(false, dt_us, sr_pcm_hz);
+}
+
+/**
+ * Setup multi-rendition encoder
+ */
+LC3_EXPORT struct lc3_multi_encoder *lc3_hr_setup_multi_encoder(
+    bool hrmode, int dt_us, int sr_pcm_hz,
+    int nrenditions, const int *sr_hz, void *mem)
+{
+    enum lc3_srate sr_pcm = resolve_srate(sr_pcm_hz, hrmode);
+
+    if (nrenditions < 1 || nrenditions > LC3_MAX_RENDITIONS || !sr_hz || !mem)
+        return NULL;
+
+    struct lc3_multi_encoder *multi = mem;
+    int sr_max_hz = 0;
+
+    for (int i = 0; i < nrenditions; i++) {
+        enum lc3_srate sr = resolve_srate(sr_hz[i], hrmode);
+        if (sr >= LC3_NUM_SRATE || sr > sr_pcm)
+            return NULL;
+
+        multi->r[i] = (struct lc3_rendition){ .sr = sr };
+        sr_max_hz = LC3_MAX(sr_max_hz, sr_hz[i]);
+    }
+
+    if (!lc3_hr_setup_encoder(
+            hrmode, dt_us, sr_max_hz, sr_pcm_hz, &multi->encoder))
+        return NULL;
+
+    multi->nr = nrenditions;
+
+    return multi;
+}
+
+LC3_EXPORT struct lc3_multi_encoder *lc3_setup_multi_encoder(
+    int dt_us, int sr_pcm_hz, int nrenditions, const int *sr_hz, void *mem)
+{
+    return lc3_hr_setup_multi_encoder(
+        false, dt_us, sr_pcm_hz, nrenditions, sr_hz, mem);
+}
+
+/**
+ * Encode a frame in each rendition
+ */
+LC3_EXPORT int lc3_multi_encode(struct lc3_multi_encoder *multi,
+    enum lc3_pcm_format fmt, const void *pcm, int stride,
+    const int *nbytes, void * const *out)
+{
+    static void (* const load[])(struct lc3_encoder *, const void *, int) = {
+        [LC3_PCM_FORMAT_S16    ] = load_s16,
+        [LC3_PCM_FORMAT_S24    ] = load_s24,
+        [LC3_PCM_FORMAT_S24_3LE] = load_s24_3le,
+        [LC3_PCM_FORMAT_FLOAT  ] = load_float,
+    };
+
+    /* --- Check parameters --- */
+
+    if (!multi || !nbytes || !out)
+        return -1;
+
+    struct lc3_encoder *encoder = &multi->encoder;
+    struct lc3_rendition *r = multi->r;
+    int nr = multi->nr;
+
+    enum lc3_dt dt = encoder->dt;
+    enum lc3_srate sr_pcm = encoder->sr_pcm;
+
+    for (int i = 0; i < nr; i++)
+        if (nbytes[i] < lc3_min_frame_bytes(dt, r[i].sr) ||
+            nbytes[i] > lc3_max_frame_bytes(dt, r[i].sr) || !out[i])
+            return -1;
+
+    /* --- Temporal --- */
+
+    lc3_fpcr_t fpcr = lc3_ftz_enter();
+
+    load[fmt](encoder, pcm, stride);
+
+    int16_t *xt = (int16_t *)encoder->x + encoder->xt_off;
+    float *xs = encoder->x + encoder->xs_off;
+    int ns = lc3_ns(dt, sr_pcm);
+    int nt = lc3_nt(sr_pcm);
+
+    float *xd = encoder->x + encoder->xd_off;
+
+    bool att[LC3_MAX_RENDITIONS];
+    for (int i = 0; i < nr; i++)
+        att[i] = lc3_attdet_run(dt, sr_pcm, nbytes[i], &r[i].attdet, xt);
+
+    lc3_ltpf_data_t ltpf;
+    bool pitch_present = !encoder->ltpf_bypass &&
+        lc3_ltpf_analyse(dt, sr_pcm, &encoder->ltpf, xt, &ltpf);
+
+    memmove(xt - nt, xt + (ns-nt), nt * sizeof(*xt));
+
+    /* --- Spectral, by samplerate of renditions --- */
+
+    struct lc3_complex buffer[LC3_MAX_NS / 2];
+
+    const struct lc3_complex *z = lc3_mdct_forward_fft(
+        dt, sr_pcm, xs, xd, buffer, (struct lc3_complex *)xs);
+
+    for (int i = 0; i < nr; i++) {
+        enum lc3_srate sr_r = r[i].sr;
+        int ns_r = lc3_ns(dt, sr_r);
+
+        int i0 = 0;
+        while (r[i0].sr != sr_r)
+            i0++;
+        if (i0 < i)
+            continue;
+
+        float xg[LC3_MAX_NS], x[LC3_MAX_NS];
+
+        lc3_mdct_forward_rot(dt, sr_pcm, sr_r, z, xg);
+
+        float e[LC3_MAX_BANDS];
+        struct side_data side = {
+            .pitch_present = pitch_present, .ltpf = ltpf };
+
+        bool nn_flag = lc3_energy_compute(dt, sr_r, xg, e);
+        if (nn_flag || encoder->ltpf_bypass)
+            lc3_ltpf_disable(&side.ltpf);
+
+        side.bw = lc3_bwdet_run(dt, sr_r, e);
+
+        /* --- Renditions of the samplerate --- */
+
+        for (int j = i; j < nr; j++) {
+            if (r[j].sr != sr_r)
+                continue;
+
+            memcpy(x, xg, ns_r * sizeof(*x));
+
+            analyze_rate(dt, sr_r, nbytes[j], nbytes[j], 0,
+                att[j], nn_flag, e, &r[j].spec, x, &side);
+
+            encode(dt, sr_r, &side, x, nbytes[j], out[j]);
+        }
+    }
+
+    lc3_ftz_leave(fpcr);
+
+    return 0;
+}
+
+
+/* ----------------------------------------------------------------------------
+ *  Decoder
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Convert PCM samples to signed 16 bits
+ * xs, n           Samples as floats, and count
+ * pcm, stride     Output PCM samples, and count between two consecutives
+ */
+#ifndef pcm_to_s16
+LC3_HOT static void pcm_to_s16(
+    const float *xs, int n, int16_t *pcm, int stride)
+{
+    for ( ; n > 0; n--, xs++, pcm += stride) {
+        int32_t s = *xs >= 0 ? (int)(*xs + 0.5f) : (int)(*xs - 0.5f);
+        *pcm = LC3_SAT16(s);
+    }
+}
+#endif /* pcm_to_s16 */
+
+/**
+ * Convert PCM samples to float 32 bits
+ * xs, n           Samples as floats, and count
+ * pcm, stride     Output PCM samples, and count between two consecutives
+ */
+#ifndef pcm_to_float
+LC3_HOT static void pcm_to_float(
+    const float *xs, int n, float *pcm, int stride)
+{
+    for ( ; n > 0; n--, xs++, pcm += stride) {
+        float s = lc3_ldexpf(*xs, -15);
+        *pcm = fminf(fmaxf(s, -1.f), 1.f);
+    }
+}
+#endif /* pcm_to_float */
+
+/**
+ * Output PCM Samples to signed 16 bits
+ * decoder         Decoder state
+ * pcm, stride     Output PCM samples, and count between two consecutives
+ */
+static void store_s16(
+    struct lc3_decoder *decoder, void *_pcm, int stride)
+{
+    int16_t *pcm = _pcm;
+
+    enum lc3_dt dt = decoder->dt;
+    enum lc3_srate sr = decoder->sr_pcm;
+
+    float *xs = decoder->x + decoder->xs_off;
+    int ns = lc3_ns(dt, sr);
+
+    pcm_to_s16(xs, ns, pcm, stride);
+}
+
+/**
+ * Output PCM Samples to signed 24 bits
+ * decoder         Decoder state
+ * pcm, stride     Output PCM samples, and count between two consecutives
+ */
+static void store_s24(
+    struct lc3_decoder *decoder, void *_pcm, int stride)
+{
+    int32_t *pcm = _pcm;
+
+    enum lc3_dt dt = decoder->dt;
+    enum lc3_srate sr = decoder->sr_pcm;
+
+    float *xs = decoder->x + decoder->xs_off;
+    int ns = lc3_ns(dt, sr);
+
+    for ( ; ns > 0; ns--, xs++, pcm += stride) {
+        int32_t s = *xs >= 0 ? (int32_t)(lc3_ldexpf(*xs, 8) + 0.5f)
+                             : (int32_t)(lc3_ldexpf(*xs, 8) - 0.5f);
+        *pcm = LC3_SAT24(s);
+    }
+}
+
+/**
+ * Output PCM Samples to signed 24 bits packed
+ * decoder         Decoder state
+ * pcm, stride     Output PCM samples, and count between two consecutives
+ */
+static void store_s24_3le(
+    struct lc3_decoder *decoder, void *_pcm, int stride)
+{
+    uint8_t *pcm = _pcm;
+
+    enum lc3_dt dt = decoder->dt;
+    enum lc3_srate sr = decoder->sr_pcm;
+
+    float *xs = decoder->x + decoder->xs_off;
+    int ns = lc3_ns(dt, sr);
+
+    for ( ; ns > 0; ns--, xs++, pcm += 3*stride) {
+        int32_t s = *xs >= 0 ? (int32_t)(lc3_ldexpf(*xs, 8) + 0.5f)
+                             : (int32_t)(lc3_ldexpf(*xs, 8) - 0.5f);
+
+        s = LC3_SAT24(s);
+        pcm[0] = (s >>  0) & 0xff;
+        pcm[1] = (s >>  8) & 0xff;
+        pcm[2] = (s >> 16) & 0xff;
+    }
+}
+
+/**
+ * Output PCM Samples to float 32 bits
+ * decoder         Decoder state
+ * pcm, stride     Output PCM samples, and count between two consecutives
+ */
+static void store_float(
+    struct lc3_decoder *decoder, void *_pcm, int stride)
+{
+    float *pcm = _pcm;
+
+    enum lc3_dt dt = decoder->dt;
+    enum lc3_srate sr = decoder->sr_pcm;
+
+    float *xs = decoder->x + decoder->xs_off;
+    int ns = lc3_ns(dt, sr);
+
+    pcm_to_float(xs, ns, pcm, stride);
+}
+
+/**
+ * Get the side data of a frame
+ * bits            Bitstream context
+ * dt, sr          Duration and samplerate of the frame
+ * nbytes          Size in bytes of the frame
+ * side            Return the side data
+ * return          0: Ok  < 0: Bitsream error detected
+ */
+static int get_side(lc3_bits_t *bits, enum lc3_dt dt, enum lc3_srate sr,
+    int nbytes, struct side_data *side)
+{
+    int ret = 0;
+
+    if ((ret = lc3_bwdet_get_bw(bits, sr, &side->bw)) < 0)
+        return ret;
+
+    if ((ret = lc3_spec_get_side(bits, dt, sr, &side->spec)) < 0)
+        return ret;
+
+    if ((ret = lc3_tns_get_data(bits, dt, side->bw, nbytes, &side->tns)) < 0)
+        return ret;
+
+    side->pitch_present = lc3_get_bit(bits);
+
+    if ((ret = lc3_sns_get_data(bits, &side->sns)) < 0)
+        return ret;
+
+    if (side->pitch_present)
+      lc3_ltpf_get_data(bits, &side->ltpf);
+
+    return 0;
+}
+
+/**
+ * Decode bitstream
+ * decoder         Decoder state
+ * data, nbytes    Input bitstream buffer
+ * side            Return the side data
+ * return          0: Ok  < 0: Bitsream error detected
+ */
+static int decode(struct lc3_decoder *decoder,
+    const void *data, int nbytes, struct side_data *side)
+{
+    enum lc3_dt dt = decoder->dt;
+    enum lc3_srate sr = decoder->sr;
+
+    float *xf = decoder->x + decoder->xs_off;
+    int ns = lc3_ns(dt, sr);
+    int ne = lc3_ne(dt, sr);
+
+    lc3_bits_t bits;
+    int ret = 0;
+
+    lc3_setup_bits(&bits, LC3_BITS_MODE_READ, (void *)data, nbytes);
+
+    if ((ret = get_side(&bits, dt, sr, nbytes, side)) < 0)
+        return ret;
+
+    if ((ret = lc3_spec_decode(&bits, dt, sr,
+                    side->bw, nbytes, &side->spec, xf)) < 0)
+        return ret;
+
+    memset(xf + ne, 0, (ns - ne) * sizeof(float));
+
+    return lc3_check_bits(&bits);
+}
+
+/**
+ * Frame synthesis
+ * decoder         Decoder state
+ * side            Frame data, NULL performs PLC
+ * nbytes          Size in bytes of the frame
+ */
+static void synthesize(struct lc3_decoder *decoder,
+    const struct side_data *side, int nbytes)
+{
+    enum lc3_dt dt = decoder->dt;
+    enum lc3_srate sr = decoder->sr;
+    enum lc3_srate sr_pcm = decoder->sr_pcm;
+
+    float *xf = decoder->x + decoder->xs_off;
+    int ns = lc3_ns(dt, sr_pcm);
+    int ne = lc3_ne(dt, sr);
+
+    float *xg = decoder->x + decoder->xg_off;
+    float *xs = xf;
+
+    float *xd = decoder->x + decoder->xd_off;
+    float *xh = decoder->x + decoder->xh_off;
+
+    if (side) {
+        enum lc3_bandwidth bw = side->bw;
+
+        lc3_plc_suspend(&decoder->plc);
+
+        float g[LC3_MAX_BANDS];
+
+        lc3_sns_synthesize_gains(dt, sr, &side->sns, g);
+
+        lc3_tns_synthesize_shaped(dt, sr, bw, &side->tns, g, xf, xg);
 
         lc3_mdct_inverse(dt, sr_pcm, sr, xg, xd, xs);
 
@@ -759,6 +1556,7 @@ LC3_EXPORT int lc3_decode(struct lc3_decoder *decoder,
     /* --- Processing --- */
 
     struct side_data side;
+    lc3_fpcr_t fpcr = lc3_ftz_enter();
 
     int ret = !in || (decode(decoder, in, nbytes, &side) < 0);
 
@@ -768,5 +1566,173 @@ LC3_EXPORT int lc3_decode(struct lc3_decoder *decoder,
 
     complete(decoder);
 
+    lc3_ftz_leave(fpcr);
+
     return ret;
 }
+
+/**
+ * Decode a frame, or its redundant copy
+ */
+LC3_EXPORT int lc3_decode_fec(struct lc3_decoder *decoder,
+    const void *in, int size, const void *next, int next_size,
+    enum lc3_pcm_format fmt, void *pcm, int stride)
+{
+    /* --- Check parameters --- */
+
+    if (!decoder || (in && size < 1))
+        return -1;
+
+    int min_nbytes = lc3_min_frame_bytes(decoder->dt, decoder->sr);
+    int max_nbytes = lc3_max_frame_bytes(decoder->dt, decoder->sr);
+
+    /* --- Frame received ---
+     * A packet whose trailer gives a frame out of the size range is
+     * corrupted, and taken as lost. */
+
+    if (in) {
+        int nbytes = size - 1 - ((const uint8_t *)in)[size - 1];
+
+        if (nbytes >= min_nbytes && nbytes <= max_nbytes)
+            return lc3_decode(decoder, in, nbytes, fmt, pcm, stride);
+    }
+
+    /* --- Redundant copy, sent with the next frame --- */
+
+    int fec_nbytes = next && next_size > min_nbytes ?
+        ((const uint8_t *)next)[next_size - 1] : 0;
+
+    if (fec_nbytes >= min_nbytes &&
+            fec_nbytes <= LC3_MIN(max_nbytes, LC3_FEC_MAX_FRAME_BYTES) &&
+            fec_nbytes <= next_size - 1 - min_nbytes) {
+
+        const uint8_t *fec =
+            (const uint8_t *)next + next_size - 1 - fec_nbytes;
+
+        int ret = lc3_decode(decoder, fec, fec_nbytes, fmt, pcm, stride);
+
+        return ret == 0 ? 2 : ret;
+    }
+
+    return lc3_decode(decoder, NULL, 0, fmt, pcm, stride);
+}
+
+/**
+ * Inspect the side information of a frame
+ */
+LC3_EXPORT int lc3_hr_frame_inspect(bool hrmode, int dt_us, int sr_hz,
+    const void *in, int nbytes, struct lc3_frame_info *info)
+{
+    static const int bw_hz[LC3_NUM_BANDWIDTH] = {
+        [LC3_BANDWIDTH_NB   ] =  8000, [LC3_BANDWIDTH_WB   ] = 16000,
+        [LC3_BANDWIDTH_SSWB ] = 24000, [LC3_BANDWIDTH_SWB  ] = 32000,
+        [LC3_BANDWIDTH_FB   ] = 48000, [LC3_BANDWIDTH_FB_HR] = 48000,
+        [LC3_BANDWIDTH_UB_HR] = 96000,
+    };
+
+    enum lc3_dt dt = resolve_dt(dt_us, hrmode);
+    enum lc3_srate sr = resolve_srate(sr_hz, hrmode);
+
+    if (dt >= LC3_NUM_DT || sr >= LC3_NUM_SRATE || !in || !info ||
+            nbytes < lc3_min_frame_bytes(dt, sr) ||
+            nbytes > lc3_max_frame_bytes(dt, sr))
+        return -1;
+
+    /* --- Read the side data --- */
+
+    struct side_data side = { .ltpf = { .active = false } };
+    lc3_bits_t bits;
+
+    lc3_setup_bits(&bits, LC3_BITS_MODE_READ, (void *)in, nbytes);
+
+    if (get_side(&bits, dt, sr, nbytes, &side) < 0)
+        return -1;
+
+    int nf = lc3_spec_get_noise_factor(&bits);
+
+    if (lc3_check_bits(&bits) < 0)
+        return -1;
+
+    /* --- Fill the information --- */
+
+    *info = (struct lc3_frame_info){
+        .bandwidth = bw_hz[side.bw],
+        .lastnz = side.spec.nq,
+        .lsb_mode = side.spec.lsb_mode,
+        .global_gain = side.spec.g_idx,
+        .noise_factor = nf,
+
+        .tns_nfilters = side.tns.nfilters,
+        .tns_order = { side.tns.rc_order[0], side.tns.rc_order[1] },
+
+        .pitch_present = side.pitch_present,
+        .ltpf_active = side.pitch_present && side.ltpf.active,
+        .pitch_index = side.pitch_present ? side.ltpf.pitch_index : 0,
+
+        .sns = {
+            .lfcb = side.sns.lfcb, .hfcb = side.sns.hfcb,
+            .shape = side.sns.shape, .gain = side.sns.gain,
+            .idx_a = side.sns.idx_a, .idx_b = side.sns.idx_b,
+            .ls_a = side.sns.ls_a, .ls_b = side.sns.ls_b,
+        },
+    };
+
+    return 0;
+}
+
+LC3_EXPORT int lc3_frame_inspect(int dt_us, int sr_hz,
+    const void *in, int nbytes, struct lc3_frame_info *info)
+{
+    return lc3_hr_frame_inspect(false, dt_us, sr_hz, in, nbytes, info);
+}
+
+/**
+ * Apply a gain to a frame, in the compressed domain
+ */
+LC3_EXPORT int lc3_hr_frame_apply_gain(bool hrmode, int dt_us, int sr_hz,
+    void *frame, int nbytes, float gain_db, float *applied_db)
+{
+    enum lc3_dt dt = resolve_dt(dt_us, hrmode);
+    enum lc3_srate sr = resolve_srate(sr_hz, hrmode);
+
+    if (dt >= LC3_NUM_DT || sr >= LC3_NUM_SRATE || !frame ||
+            nbytes < lc3_min_frame_bytes(dt, sr) ||
+            nbytes > lc3_max_frame_bytes(dt, sr))
+        return -1;
+
+    /* --- Read the side data --- */
+
+    struct side_data side;
+    lc3_bits_t bits;
+
+    lc3_setup_bits(&bits, LC3_BITS_MODE_READ, frame, nbytes);
+
+    if (get_side(&bits, dt, sr, nbytes, &side) < 0 ||
+            lc3_check_bits(&bits) < 0)
+        return -1;
+
+    /* --- Rewrite the gain index ---
+     * The index moves by steps of 20/28 dB. The null index marks the
+     * frames without noise filling, and is left out of the range. */
+
+    int g_idx = side.spec.g_idx;
+    int g_incr = (int)floorf(
+        LC3_CLIP(gain_db, -256 * 20.f/28, 256 * 20.f/28) * (28.f/20) + 0.5f);
+
+    int g_idx_new = g_idx > 0 ? LC3_CLIP(g_idx + g_incr, 1, 255) : g_idx;
+
+    if (g_idx_new != g_idx)
+        lc3_spec_set_gain_index(dt, sr, frame, nbytes, g_idx_new);
+
+    if (applied_db)
+        *applied_db = (g_idx_new - g_idx) * (20.f/28);
+
+    return g_idx_new - g_idx != g_incr;
+}
+
+LC3_EXPORT int lc3_frame_apply_gain(int dt_us, int sr_hz,
+    void *frame, int nbytes, float gain_db, float *applied_db)
+{
+    return lc3_hr_frame_apply_gain(
+        false, dt_us, sr_hz, frame, nbytes, gain_db, applied_db);
+}
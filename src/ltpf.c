@@ -19,8 +19,19 @@
 #include "ltpf.h"
 #include "tables.h"
 
+
+/**
+ * Width of synthesis filter
+ */
+
+#define MAX_FILTER_WIDTH \
+    (LC3_MAX_SRATE_HZ / 4000)
+
+
 #include "ltpf_neon.h"
 #include "ltpf_arm.h"
+#include "ltpf_sse.h"
+#include "ltpf_wasm.h"
 
 
 /* ----------------------------------------------------------------------------
@@ -513,6 +524,7 @@ LC3_HOT static int argmax_weighted(
  *
  * The size `n` of vectors must be multiple of 4
  */
+#ifndef interpolate
 LC3_HOT static void interpolate(const int16_t *x, int n, int d, int16_t *y)
 {
     static const int16_t h4_q15[][4] = {
@@ -539,6 +551,7 @@ LC3_HOT static void interpolate(const int16_t *x, int n, int d, int16_t *y)
         *(y++) = yn >> 15;
     }
 }
+#endif /* interpolate */
 
 /**
  * Interpolate autocorrelation
@@ -578,28 +591,54 @@ LC3_HOT static float interpolate_corr(const float *x, int d)
  * return          True when pitch present
  *
  * The `x` vector is aligned on 32 bits
+ *
+ * When tracking is enabled, and the previous frame was strongly correlated,
+ * the lag is searched in a window of +/- 8 around the previous one.
+ * The full range is searched back when the track is lost : the correlation
+ * drops, or the maximum lies on the edge of the window.
  */
 static bool detect_pitch(struct lc3_ltpf_analysis *ltpf,
     const int16_t *x, int n, int *tc)
 {
-    float rm1, rm2;
+    float rm1, rm2, nc1;
     float r[98];
 
     const int r0 = 17, nr = 98;
+    const float w_incr = -.5f/(nr-1);
     int k0 = LC3_MAX(   0, ltpf->tc-4);
     int nk = LC3_MIN(nr-1, ltpf->tc+4) - k0 + 1;
+    int t1;
+
+    /* --- Search the lag, around the previous one when tracked --- */
+
+    for (bool full = !ltpf->track || ltpf->nc[0] <= 0.9f; ; full = true) {
+        int j0 = full ?  0 : LC3_MAX(   0, ltpf->tc-8);
+        int nj = full ? nr : LC3_MIN(nr-1, ltpf->tc+8) - j0 + 1;
+
+        correlate(x, x - (r0 + j0), n, r + j0, nj);
+
+        /* The weights `1 + (j0 + i) * w_incr` are scaled by a positive
+         * factor, that does not change the argument of the maximum */
 
-    correlate(x, x - r0, n, r, nr);
+        t1 = j0 + argmax_weighted(
+            r + j0, nj, w_incr / (1 + j0 * w_incr), &rm1);
+
+        const int16_t *x1 = x - (r0 + t1);
+
+        nc1 = rm1 <= 0 ? 0 :
+            rm1 / sqrtf(dot(x, x, n) * dot(x1, x1, n));
+
+        bool lost = nc1 <= 0.9f ||
+            (t1 == j0 && j0 > 0) || (t1 == j0 + nj-1 && t1 < nr-1);
+
+        if (full || !lost)
+            break;
+    }
 
-    int t1 = argmax_weighted(r, nr, -.5f/(nr-1), &rm1);
     int t2 = k0 + argmax(r + k0, nk, &rm2);
 
-    const int16_t *x1 = x - (r0 + t1);
     const int16_t *x2 = x - (r0 + t2);
 
-    float nc1 = rm1 <= 0 ? 0 :
-        rm1 / sqrtf(dot(x, x, n) * dot(x1, x1, n));
-
     float nc2 = rm2 <= 0 ? 0 :
         rm2 / sqrtf(dot(x, x, n) * dot(x2, x2, n));
 
@@ -741,14 +780,6 @@ bool lc3_ltpf_analyse(
  *  Synthesis
  * -------------------------------------------------------------------------- */
 
-/**
- * Width of synthesis filter
- */
-
-#define MAX_FILTER_WIDTH \
-    (LC3_MAX_SRATE_HZ / 4000)
-
-
 /**
  * Synthesis filter template
  * xh, nh          History ring buffer of filtered samples
@@ -813,6 +844,7 @@ LC3_HOT static inline void synthesize_template(
  * Synthesis filter for each samplerates (width of filter)
  */
 
+#ifndef synthesize_4
 
 LC3_HOT static void synthesize_4(const float *xh, int nh, int lag,
     const float *x0, float *x, int n, const float *c, int fade)
@@ -820,24 +852,38 @@ LC3_HOT static void synthesize_4(const float *xh, int nh, int lag,
     synthesize_template(xh, nh, lag, x0, x, n, c, 4, fade);
 }
 
+#endif /* synthesize_4 */
+
+#ifndef synthesize_6
+
 LC3_HOT static void synthesize_6(const float *xh, int nh, int lag,
     const float *x0, float *x, int n, const float *c, int fade)
 {
     synthesize_template(xh, nh, lag, x0, x, n, c, 6, fade);
 }
 
+#endif /* synthesize_6 */
+
+#ifndef synthesize_8
+
 LC3_HOT static void synthesize_8(const float *xh, int nh, int lag,
     const float *x0, float *x, int n, const float *c, int fade)
 {
     synthesize_template(xh, nh, lag, x0, x, n, c, 8, fade);
 }
 
+#endif /* synthesize_8 */
+
+#ifndef synthesize_12
+
 LC3_HOT static void synthesize_12(const float *xh, int nh, int lag,
     const float *x0, float *x, int n, const float *c, int fade)
 {
     synthesize_template(xh, nh, lag, x0, x, n, c, 12, fade);
 }
 
+#endif /* synthesize_12 */
+
 static void (* const synthesize[])(const float *, int, int,
     const float *, float *, int, const float *, int) =
 {
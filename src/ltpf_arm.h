@@ -503,4 +503,91 @@ static void arm_correlate(
 
 #endif /* correlate */
 
+/**
+ * Resample to 6.4 KHz
+ *
+ * The 5 taps of the symmetric filter are taken from 3 pairs of samples,
+ * the pairs being kept in registers from an output sample to the next.
+ */
+#ifndef resample_6k4
+
+static void arm_resample_6k4(const int16_t *x, int16_t *y, int n)
+{
+    static const int16_t h[] = { 18477, 15424, 8105 };
+
+    const int16x2_t h10 = __pkhbt(h[1], h[0] << 16);
+    const int16x2_t h12 = __pkhbt(h[1], h[2] << 16);
+
+    const int16x2_t *xn = (const int16x2_t *)x;
+    int16x2_t x2 = xn[-2], x1 = xn[-1];
+
+    for (int i = 0; i < n; i++) {
+        int16x2_t x0 = *(xn++);
+
+        *(y++) = __smlad(x1, h10, __smlad(x0, h12, (x2 >> 16) * h[2])) >> 16;
+
+        x2 = x1, x1 = x0;
+    }
+}
+
+#ifndef TEST_ARM
+#define resample_6k4 arm_resample_6k4
+#endif
+
+#endif /* resample_6k4 */
+
+/**
+ * Interpolate from pitch detected value
+ *
+ * The samples are processed by pairs, from the vector `x` aligned on
+ * 32 bits. On misalignment the first and last values are computed apart.
+ */
+#ifndef interpolate
+
+static void arm_interpolate(const int16_t *x, int n, int d, int16_t *y)
+{
+    static const int16_t h4_q15[][4] = {
+        { 6877, 19121,  6877,     0 }, { 3506, 18025, 11000,   220 },
+        { 1300, 15048, 15048,  1300 }, {  220, 11000, 18025,  3506 } };
+
+    const int16_t *h = h4_q15[d];
+
+    const int16x2_t h32 = __pkhbt(h[3], h[2] << 16);
+    const int16x2_t h10 = __pkhbt(h[1], h[0] << 16);
+    const int16x2_t h21 = __pkhbt(h[2], h[1] << 16);
+    const int16x2_t h03 = __pkhbt(h[0], h[3] << 16);
+
+    int i = 0;
+
+    /* --- Check alignment of `x` --- */
+
+    if ((uintptr_t)(x - 2) & 3)
+        y[i] = (x[i+1] * h[0] + x[i] * h[1] +
+                x[i-1] * h[2] + x[i-2] * h[3]) >> 15, i++;
+
+    /* --- Processing by pair --- */
+
+    const int16x2_t *xn = (const int16x2_t *)(x + i - 2);
+    int16x2_t x0 = *(xn++), x1;
+
+    for ( ; i + 2 <= n; i += 2, x0 = x1) {
+        x1 = *(xn++);
+
+        y[i+0] = __smlad(x0, h32, __smuad(x1, h10)) >> 15;
+        y[i+1] = __smlad(x1, h21, __smuad(__pkhbt(x[i+2], x0), h03)) >> 15;
+    }
+
+    /* --- Odd element count --- */
+
+    if (i < n)
+        y[i] = (x[i+1] * h[0] + x[i] * h[1] +
+                x[i-1] * h[2] + x[i-2] * h[3]) >> 15;
+}
+
+#ifndef TEST_ARM
+#define interpolate arm_interpolate
+#endif
+
+#endif /* interpolate */
+
 #endif /* __ARM_FEATURE_SIMD32 */
@@ -17,7 +17,7 @@
  ******************************************************************************/
 
 #if __ARM_NEON && __ARM_ARCH_ISA_A64 && \
-        !defined(TEST_ARM) || defined(TEST_NEON)
+        !defined(TEST_ARM) && !defined(TEST_WASM) || defined(TEST_NEON)
 
 #ifndef TEST_NEON
 #include <arm_neon.h>
@@ -189,26 +189,31 @@ LC3_HOT static void neon_resample_48k_12k8(
 
 /**
  * Return dot product of 2 vectors
+ *
+ * The sums of 2 products lie in ]-2^31, 2^31], the only one that wraps
+ * is 2^31, with both pairs of samples at -2^15. The sums are accumulated
+ * biased by -1, that cannot wrap, and the bias of `n/2` is given back.
  */
 #ifndef dot
 
 LC3_HOT static inline float neon_dot(const int16_t *a, const int16_t *b, int n)
 {
+    const int32x4_t bias = vmovq_n_s32(-1);
     int64x2_t v = vmovq_n_s64(0);
 
     for (int i = 0; i < (n >> 4); i++) {
         int32x4_t u;
 
-        u = vmull_s16(   vld1_s16(a), vld1_s16(b)), a += 4, b += 4;
-        u = vmlal_s16(u, vld1_s16(a), vld1_s16(b)), a += 4, b += 4;
+        u = vmlal_s16(bias, vld1_s16(a), vld1_s16(b)), a += 4, b += 4;
+        u = vmlal_s16(u,    vld1_s16(a), vld1_s16(b)), a += 4, b += 4;
         v = vpadalq_s32(v, u);
 
-        u = vmull_s16(   vld1_s16(a), vld1_s16(b)), a += 4, b += 4;
-        u = vmlal_s16(u, vld1_s16(a), vld1_s16(b)), a += 4, b += 4;
+        u = vmlal_s16(bias, vld1_s16(a), vld1_s16(b)), a += 4, b += 4;
+        u = vmlal_s16(u,    vld1_s16(a), vld1_s16(b)), a += 4, b += 4;
         v = vpadalq_s32(v, u);
     }
 
-    int32_t v32 = (vaddvq_s64(v) + (1 << 5)) >> 6;
+    int32_t v32 = (vaddvq_s64(v) + (n >> 1) + (1 << 5)) >> 6;
     return (float)v32;
 }
 
@@ -220,12 +225,16 @@ LC3_HOT static inline float neon_dot(const int16_t *a, const int16_t *b, int n)
 
 /**
  * Return vector of correlations
+ *
+ * The sums of 2 products are accumulated biased by -1, as for `neon_dot()`.
  */
 #ifndef correlate
 
 LC3_HOT static void neon_correlate(
     const int16_t *a, const int16_t *b, int n, float *y, int nc)
 {
+    const int32x4_t bias = vmovq_n_s32(-1);
+
     for ( ; nc >= 4; nc -= 4, b -= 4) {
         const int16_t *an = (const int16_t *)a;
         const int16_t *bn = (const int16_t *)b;
@@ -243,10 +252,10 @@ LC3_HOT static void neon_correlate(
                 b0 = vld1_s16(bn), bn += 4;
                 ax = vld1_s16(an), an += 4;
 
-                u0 = vmull_s16(ax, b0);
-                u1 = vmull_s16(ax, vext_s16(b1, b0, 3));
-                u2 = vmull_s16(ax, vext_s16(b1, b0, 2));
-                u3 = vmull_s16(ax, vext_s16(b1, b0, 1));
+                u0 = vmlal_s16(bias, ax, b0);
+                u1 = vmlal_s16(bias, ax, vext_s16(b1, b0, 3));
+                u2 = vmlal_s16(bias, ax, vext_s16(b1, b0, 2));
+                u3 = vmlal_s16(bias, ax, vext_s16(b1, b0, 1));
 
                 b1 = b0;
                 b0 = vld1_s16(bn), bn += 4;
@@ -263,10 +272,14 @@ LC3_HOT static void neon_correlate(
                 v3 = vpadalq_s32(v3, u3);
             }
 
-        *(y++) = (float)((int32_t)((vaddvq_s64(v0) + (1 << 5)) >> 6));
-        *(y++) = (float)((int32_t)((vaddvq_s64(v1) + (1 << 5)) >> 6));
-        *(y++) = (float)((int32_t)((vaddvq_s64(v2) + (1 << 5)) >> 6));
-        *(y++) = (float)((int32_t)((vaddvq_s64(v3) + (1 << 5)) >> 6));
+        *(y++) = (float)((int32_t)(
+            (vaddvq_s64(v0) + (n >> 1) + (1 << 5)) >> 6));
+        *(y++) = (float)((int32_t)(
+            (vaddvq_s64(v1) + (n >> 1) + (1 << 5)) >> 6));
+        *(y++) = (float)((int32_t)(
+            (vaddvq_s64(v2) + (n >> 1) + (1 << 5)) >> 6));
+        *(y++) = (float)((int32_t)(
+            (vaddvq_s64(v3) + (n >> 1) + (1 << 5)) >> 6));
     }
 
     for ( ; nc > 0; nc--)
@@ -278,4 +291,170 @@ LC3_HOT static void neon_correlate(
 #define correlate neon_correlate
 #endif
 
+
+/**
+ * Vector of 4 samples at offset `r` (0 to 3) of concatenated `a` and `b`
+ */
+#if !defined(synthesize_4) || !defined(synthesize_6) \
+        || !defined(synthesize_8) || !defined(synthesize_12)
+
+LC3_HOT static inline float32x4_t neon_shift_f32(
+    float32x4_t a, float32x4_t b, int r)
+{
+    switch (r) {
+    case 1: return vextq_f32(a, b, 1);
+    case 2: return vextq_f32(a, b, 2);
+    case 3: return vextq_f32(a, b, 3);
+    }
+
+    return a;
+}
+
+/**
+ * Synthesis filter template
+ * xh, nh          History ring buffer of filtered samples
+ * lag             Lag parameter in the ring buffer
+ * x0              w-1 previous input samples
+ * x, n            Current samples as input, filtered as output
+ * c, w            Coefficients `den` then `num`, and width of filter
+ * fade            Fading mode of filter  -1: Out  1: In  0: None
+ *
+ * The size `n` of vectors must be multiple of 4. Groups of 4 samples are
+ * filtered at once, the pitch lag being greater than `w/2 + 2`, the
+ * filtered samples read back never lie in the current group.
+ * The input samples of the 3 previous groups, overwritten by the filtered
+ * ones, are kept in registers.
+ */
+LC3_HOT static inline void neon_synthesize_template(
+    const float *xh, int nh, int lag,
+    const float *x0, float *x, int n,
+    const float *c, const int w, int fade)
+{
+    float g = (float)(fade <= 0);
+    float g_incr = (float)((fade > 0) - (fade < 0)) / n;
+
+    float32x4_t cv[2*MAX_FILTER_WIDTH], xv[4];
+    float xp[12] = { 0 }, yt[MAX_FILTER_WIDTH+3];
+
+    for (int k = 0; k < 2*w; k++)
+        cv[k] = vmovq_n_f32(c[k]);
+
+    /* --- Load previous samples --- */
+
+    lag += (w >> 1);
+
+    const float *y = x - xh < lag ? x + (nh - lag) : x - lag;
+    const float *y_end = xh + nh;
+
+    memcpy(xp + 12 - (w-1), x0, (w-1) * sizeof(float));
+
+    for (int j = 0; j < 3; j++)
+        xv[j] = vld1q_f32(xp + 4*j);
+
+    /* --- Process by group of 4 samples --- */
+
+    for (int i = 0; i < n; i += 4, x += 4) {
+
+        const float *yk = y;
+
+        if (y + (w+3) > y_end) {
+            for (int k = 0; k < w+3; k++)
+                yt[k] = y + k < y_end ? y[k] : y[k - nh];
+            yk = yt;
+        }
+
+        if ((y += 4) >= y_end)
+            y -= nh;
+
+        xv[3] = vld1q_f32(x);
+
+        float32x4_t u = vmovq_n_f32(0);
+
+        for (int k = 0; k < w; k++) {
+            int s = 12 - (w-1) + k;
+            float32x4_t xk =
+                neon_shift_f32(xv[s >> 2], xv[(s >> 2) + (s < 12)], s & 3);
+
+            u = vfmsq_f32(u, vld1q_f32(yk + k), cv[k]);
+            u = vfmaq_f32(u, xk, cv[w+k]);
+        }
+
+        float32x4_t gv = vmovq_n_f32(g);
+
+        if (fade) {
+            float gj[4];
+            for (int j = 0; j < 4; j++, g += g_incr)
+                gj[j] = g;
+
+            gv = vld1q_f32(gj);
+        }
+
+        vst1q_f32(x, vfmsq_f32(xv[3], gv, u));
+
+        xv[0] = xv[1], xv[1] = xv[2], xv[2] = xv[3];
+    }
+}
+
+#endif /* synthesize_4 || synthesize_6 || synthesize_8 || synthesize_12 */
+
+
+/**
+ * Synthesis filter for each samplerates (width of filter)
+ */
+#ifndef synthesize_4
+
+LC3_HOT static void neon_synthesize_4(const float *xh, int nh, int lag,
+    const float *x0, float *x, int n, const float *c, int fade)
+{
+    neon_synthesize_template(xh, nh, lag, x0, x, n, c, 4, fade);
+}
+
+#ifndef TEST_NEON
+#define synthesize_4 neon_synthesize_4
+#endif
+
+#endif /* synthesize_4 */
+
+#ifndef synthesize_6
+
+LC3_HOT static void neon_synthesize_6(const float *xh, int nh, int lag,
+    const float *x0, float *x, int n, const float *c, int fade)
+{
+    neon_synthesize_template(xh, nh, lag, x0, x, n, c, 6, fade);
+}
+
+#ifndef TEST_NEON
+#define synthesize_6 neon_synthesize_6
+#endif
+
+#endif /* synthesize_6 */
+
+#ifndef synthesize_8
+
+LC3_HOT static void neon_synthesize_8(const float *xh, int nh, int lag,
+    const float *x0, float *x, int n, const float *c, int fade)
+{
+    neon_synthesize_template(xh, nh, lag, x0, x, n, c, 8, fade);
+}
+
+#ifndef TEST_NEON
+#define synthesize_8 neon_synthesize_8
+#endif
+
+#endif /* synthesize_8 */
+
+#ifndef synthesize_12
+
+LC3_HOT static void neon_synthesize_12(const float *xh, int nh, int lag,
+    const float *x0, float *x, int n, const float *c, int fade)
+{
+    neon_synthesize_template(xh, nh, lag, x0, x, n, c, 12, fade);
+}
+
+#ifndef TEST_NEON
+#define synthesize_12 neon_synthesize_12
+#endif
+
+#endif /* synthesize_12 */
+
 #endif /* __ARM_NEON && __ARM_ARCH_ISA_A64 */
@@ -0,0 +1,193 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if __SSE2__ && !defined(TEST_ARM) && !defined(TEST_NEON) && \
+        !defined(TEST_WASM) || defined(TEST_SSE)
+
+#ifndef TEST_SSE
+#include <emmintrin.h>
+#endif /* TEST_SSE */
+
+
+/**
+ * Vector of 4 samples at offset `r` (0 to 3) of concatenated `a` and `b`
+ */
+#if !defined(synthesize_4) || !defined(synthesize_6) \
+        || !defined(synthesize_8) || !defined(synthesize_12)
+
+LC3_HOT static inline __m128 sse_shift_ps(__m128 a, __m128 b, int r)
+{
+    __m128 t = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 3, 3));
+
+    switch (r) {
+    case 1: return _mm_shuffle_ps(a, t, _MM_SHUFFLE(2, 0, 2, 1));
+    case 2: return _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 3, 2));
+    case 3: return _mm_shuffle_ps(t, b, _MM_SHUFFLE(2, 1, 2, 0));
+    }
+
+    return a;
+}
+
+/**
+ * Synthesis filter template
+ * xh, nh          History ring buffer of filtered samples
+ * lag             Lag parameter in the ring buffer
+ * x0              w-1 previous input samples
+ * x, n            Current samples as input, filtered as output
+ * c, w            Coefficients `den` then `num`, and width of filter
+ * fade            Fading mode of filter  -1: Out  1: In  0: None
+ *
+ * The size `n` of vectors must be multiple of 4. Groups of 4 samples are
+ * filtered at once, the pitch lag being greater than `w/2 + 2`, the
+ * filtered samples read back never lie in the current group.
+ * The input samples of the 3 previous groups, overwritten by the filtered
+ * ones, are kept in registers. The order of accumulation of the generic
+ * filter is kept.
+ */
+LC3_HOT static inline void sse_synthesize_template(
+    const float *xh, int nh, int lag,
+    const float *x0, float *x, int n,
+    const float *c, const int w, int fade)
+{
+    float g = (float)(fade <= 0);
+    float g_incr = (float)((fade > 0) - (fade < 0)) / n;
+
+    __m128 cv[2*MAX_FILTER_WIDTH], xv[4];
+    float xp[12] = { 0 }, yt[MAX_FILTER_WIDTH+3];
+
+    for (int k = 0; k < 2*w; k++)
+        cv[k] = _mm_set1_ps(c[k]);
+
+    /* --- Load previous samples --- */
+
+    lag += (w >> 1);
+
+    const float *y = x - xh < lag ? x + (nh - lag) : x - lag;
+    const float *y_end = xh + nh;
+
+    memcpy(xp + 12 - (w-1), x0, (w-1) * sizeof(float));
+
+    for (int j = 0; j < 3; j++)
+        xv[j] = _mm_loadu_ps(xp + 4*j);
+
+    /* --- Process by group of 4 samples --- */
+
+    for (int i = 0; i < n; i += 4, x += 4) {
+
+        const float *yk = y;
+
+        if (y + (w+3) > y_end) {
+            for (int k = 0; k < w+3; k++)
+                yt[k] = y + k < y_end ? y[k] : y[k - nh];
+            yk = yt;
+        }
+
+        if ((y += 4) >= y_end)
+            y -= nh;
+
+        xv[3] = _mm_loadu_ps(x);
+
+        __m128 u = _mm_setzero_ps();
+
+        for (int k = 0; k < w; k++) {
+            int s = 12 - (w-1) + k;
+            __m128 xk = sse_shift_ps(xv[s >> 2], xv[(s >> 2) + (s < 12)], s & 3);
+
+            u = _mm_sub_ps(u, _mm_mul_ps(_mm_loadu_ps(yk + k), cv[k]));
+            u = _mm_add_ps(u, _mm_mul_ps(xk, cv[w+k]));
+        }
+
+        __m128 gv = _mm_set1_ps(g);
+
+        if (fade) {
+            float gj[4];
+            for (int j = 0; j < 4; j++, g += g_incr)
+                gj[j] = g;
+
+            gv = _mm_loadu_ps(gj);
+        }
+
+        _mm_storeu_ps(x, _mm_sub_ps(xv[3], _mm_mul_ps(gv, u)));
+
+        xv[0] = xv[1], xv[1] = xv[2], xv[2] = xv[3];
+    }
+}
+
+#endif /* synthesize_4 || synthesize_6 || synthesize_8 || synthesize_12 */
+
+
+/**
+ * Synthesis filter for each samplerates (width of filter)
+ */
+#ifndef synthesize_4
+
+LC3_HOT static void sse_synthesize_4(const float *xh, int nh, int lag,
+    const float *x0, float *x, int n, const float *c, int fade)
+{
+    sse_synthesize_template(xh, nh, lag, x0, x, n, c, 4, fade);
+}
+
+#ifndef TEST_SSE
+#define synthesize_4 sse_synthesize_4
+#endif
+
+#endif /* synthesize_4 */
+
+#ifndef synthesize_6
+
+LC3_HOT static void sse_synthesize_6(const float *xh, int nh, int lag,
+    const float *x0, float *x, int n, const float *c, int fade)
+{
+    sse_synthesize_template(xh, nh, lag, x0, x, n, c, 6, fade);
+}
+
+#ifndef TEST_SSE
+#define synthesize_6 sse_synthesize_6
+#endif
+
+#endif /* synthesize_6 */
+
+#ifndef synthesize_8
+
+LC3_HOT static void sse_synthesize_8(const float *xh, int nh, int lag,
+    const float *x0, float *x, int n, const float *c, int fade)
+{
+    sse_synthesize_template(xh, nh, lag, x0, x, n, c, 8, fade);
+}
+
+#ifndef TEST_SSE
+#define synthesize_8 sse_synthesize_8
+#endif
+
+#endif /* synthesize_8 */
+
+#ifndef synthesize_12
+
+LC3_HOT static void sse_synthesize_12(const float *xh, int nh, int lag,
+    const float *x0, float *x, int n, const float *c, int fade)
+{
+    sse_synthesize_template(xh, nh, lag, x0, x, n, c, 12, fade);
+}
+
+#ifndef TEST_SSE
+#define synthesize_12 sse_synthesize_12
+#endif
+
+#endif /* synthesize_12 */
+
+#endif /* __SSE2__ */
@@ -25,6 +25,7 @@ liblc3_src += \
     $(SRC_DIR)/plc.c \
     $(SRC_DIR)/sns.c \
     $(SRC_DIR)/spec.c \
+    $(SRC_DIR)/state.c \
     $(SRC_DIR)/tables.c \
     $(SRC_DIR)/tns.c
 
@@ -20,6 +20,7 @@
 #include "tables.h"
 
 #include "mdct_neon.h"
+#include "mdct_wasm.h"
 
 
 /* ----------------------------------------------------------------------------
@@ -204,6 +205,7 @@ static struct lc3_complex *fft(const struct lc3_complex *x, int n,
  * x, y            Input current and delayed samples
  * y, d            Output windowed samples, and delayed ones
  */
+#ifndef mdct_window
 LC3_HOT static void mdct_window(
     enum lc3_dt dt, enum lc3_srate sr,
     const float *x, float *d, float *y)
@@ -234,6 +236,7 @@ LC3_HOT static void mdct_window(
         *(y1++) = (*(d0++) = *(x0++)) * *(w2++) + (*d1 = *(--x1)) * *(--w3);
     }
 }
+#endif /* mdct_window */
 
 /**
  * Pre-rotate MDCT coefficients of N/2 points, before FFT N/4 points FFT
@@ -242,6 +245,7 @@ LC3_HOT static void mdct_window(
  *
  * `x` and y` can be the same buffer
  */
+#ifndef mdct_pre_fft
 LC3_HOT static void mdct_pre_fft(const struct lc3_mdct_rot_def *def,
     const float *x, struct lc3_complex *y)
 {
@@ -264,6 +268,7 @@ LC3_HOT static void mdct_pre_fft(const struct lc3_mdct_rot_def *def,
         *(--y1) = v;
     }
 }
+#endif /* mdct_pre_fft */
 
 /**
  * Post-rotate FFT N/4 points coefficients, resulting MDCT N points
@@ -272,6 +277,7 @@ LC3_HOT static void mdct_pre_fft(const struct lc3_mdct_rot_def *def,
  *
  * `x` and y` can be the same buffer
  */
+#ifndef mdct_post_fft
 LC3_HOT static void mdct_post_fft(const struct lc3_mdct_rot_def *def,
     const struct lc3_complex *x, float *y)
 {
@@ -294,6 +300,46 @@ LC3_HOT static void mdct_post_fft(const struct lc3_mdct_rot_def *def,
         *(--y1) = v0;  *(--y1) = v1;
     }
 }
+#endif /* mdct_post_fft */
+
+/**
+ * Post-rotate FFT N/4 points coefficients, keeping the first ones
+ * def             Size and twiddles factors
+ * x               Input coefficients
+ * y, ny           Output coefficients, and count kept
+ * scale           Scale factor of the coefficients
+ *
+ * `x` and y` can be the same buffer
+ * This is `mdct_post_fft()` followed by the scaling, while the output
+ * coefficients from `ny` are not computed. The lower half is output from
+ * its middle down, the loop starts at the first pair below `ny`.
+ */
+LC3_HOT static void mdct_post_fft_pruned(const struct lc3_mdct_rot_def *def,
+    const struct lc3_complex *x, float *y, int ny, float scale)
+{
+    int n4 = def->n4, n8 = n4 >> 1;
+    int k0 = LC3_MAX(n4 - ny, 0) >> 1;
+
+    const struct lc3_complex *w0 = def->w + n8 + k0, *w1 = w0 - 1 - 2*k0;
+    const struct lc3_complex *x0 = x + n8 + k0, *x1 = x0 - 1 - 2*k0;
+
+    float *y0 = y + n4 + 2*k0, *y1 = y + n4 - 2*k0;
+
+    for ( ; y1 > y; x0++, x1--, w0++, w1--) {
+
+        float v0 = x0->re * w0->im - x0->im * w0->re;
+        float v1 = x1->im * w1->im + x1->re * w1->re;
+
+        if (y0 < y + ny) {
+            float u0 = x0->im * w0->im + x0->re * w0->re;
+            float u1 = x1->re * w1->im - x1->im * w1->re;
+
+            *(y0++) = u0 * scale;  *(y0++) = u1 * scale;
+        }
+
+        *(--y1) = v0 * scale;  *(--y1) = v1 * scale;
+    }
+}
 
 /**
  * Pre-rotate IMDCT coefficients of N points, before FFT N/4 points FFT
@@ -304,6 +350,7 @@ LC3_HOT static void mdct_post_fft(const struct lc3_mdct_rot_def *def,
  * The real and imaginary parts of `y` are swapped,
  * to operate on FFT instead of IFFT
  */
+#ifndef imdct_pre_fft
 LC3_HOT static void imdct_pre_fft(const struct lc3_mdct_rot_def *def,
     const float *x, struct lc3_complex *y)
 {
@@ -326,6 +373,62 @@ LC3_HOT static void imdct_pre_fft(const struct lc3_mdct_rot_def *def,
         (  y1)->im = - v0 * vw.re + v1 * vw.im;
     }
 }
+#endif /* imdct_pre_fft */
+
+/**
+ * Pre-rotate IMDCT coefficients, with null upper coefficients
+ * def             Size and twiddles factors
+ * x, nx           Input coefficients, and count of the non-null ones
+ * scale           Scale factor of the coefficients
+ * y               Output coefficients
+ *
+ * `x` and `y` can be the same buffer, `nx` must be even.
+ * This is the scaling followed by `imdct_pre_fft()`, while the null
+ * coefficients, from `nx`, are not read.
+ */
+LC3_HOT static void imdct_pre_fft_pruned(const struct lc3_mdct_rot_def *def,
+    const float *x, int nx, float scale, struct lc3_complex *y)
+{
+    int n4 = def->n4;
+
+    const float *x0 = x, *x1 = x0 + 2*n4, *xn = x0 + nx;
+
+    const struct lc3_complex *w0 = def->w, *w1 = w0 + n4;
+    struct lc3_complex *y0 = y, *y1 = y0 + n4;
+
+    /* --- Upper coefficients null --- */
+
+    for ( ; x0 < xn && x1 > xn; x1 -= 2) {
+        float u0 = *(x0++) * scale;
+        float v0 = *(x0++) * scale;
+        struct lc3_complex uw = *(w0++), vw = *(--w1);
+
+        (y0  )->re = - u0 * uw.re;
+        (y0++)->im =   u0 * uw.im;
+
+        (--y1)->re = - v0 * vw.im;
+        (  y1)->im = - v0 * vw.re;
+    }
+
+    if (x1 > xn) {
+        memset(y0, 0, (y1 - y0) * sizeof(*y0));
+        return;
+    }
+
+    /* --- Remaining coefficients --- */
+
+    while (x0 < x1) {
+        float u0 = *(x0++) * scale, u1 = *(--x1) * scale;
+        float v0 = *(x0++) * scale, v1 = *(--x1) * scale;
+        struct lc3_complex uw = *(w0++), vw = *(--w1);
+
+        (y0  )->re = - u0 * uw.re - u1 * uw.im;
+        (y0++)->im = - u1 * uw.re + u0 * uw.im;
+
+        (--y1)->re = - v1 * vw.re - v0 * vw.im;
+        (  y1)->im = - v0 * vw.re + v1 * vw.im;
+    }
+}
 
 /**
  * Post-rotate FFT N/4 points coefficients, resulting IMDCT N points
@@ -336,6 +439,7 @@ LC3_HOT static void imdct_pre_fft(const struct lc3_mdct_rot_def *def,
  * The real and imaginary parts of `x` are swapped,
  * to operate on FFT instead of IFFT
  */
+#ifndef imdct_post_fft
 LC3_HOT static void imdct_post_fft(const struct lc3_mdct_rot_def *def,
     const struct lc3_complex *x, float *y)
 {
@@ -357,6 +461,7 @@ LC3_HOT static void imdct_post_fft(const struct lc3_mdct_rot_def *def,
         *(y0++) = vz.re * vw.re + vz.im * vw.im;
     }
 }
+#endif /* imdct_post_fft */
 
 /**
  * Apply windowing of samples
@@ -364,6 +469,7 @@ LC3_HOT static void imdct_post_fft(const struct lc3_mdct_rot_def *def,
  * x, d            Middle half of IMDCT coefficients and delayed samples
  * y, d            Output samples and delayed ones
  */
+#ifndef imdct_window
 LC3_HOT static void imdct_window(
     enum lc3_dt dt, enum lc3_srate sr,
     const float *x, float *d, float *y)
@@ -410,43 +516,56 @@ LC3_HOT static void imdct_window(
         *(--y2) = *(x++) * *(w2++);
     }
 }
+#endif /* imdct_window */
 
 /**
- * Rescale samples
- * x, n            Input and count of samples, scaled as output
- * scale           Scale factor
+ * Forward MDCT transformation
  */
-LC3_HOT static void rescale(float *x, int n, float f)
+void lc3_mdct_forward(
+    enum lc3_dt dt, enum lc3_srate sr, enum lc3_srate sr_dst,
+    const float *x, float *d, float *y)
 {
-    for (int i = 0; i < (n >> 2); i++) {
-        *(x++) *= f; *(x++) *= f;
-        *(x++) *= f; *(x++) *= f;
-    }
+    struct lc3_complex buffer[LC3_MAX_NS / 2];
+
+    const struct lc3_complex *z = lc3_mdct_forward_fft(
+        dt, sr, x, d, buffer, (struct lc3_complex *)y);
+
+    lc3_mdct_forward_rot(dt, sr, sr_dst, z, y);
 }
 
 /**
- * Forward MDCT transformation
+ * Forward MDCT transformation, windowing and FFT step
  */
-void lc3_mdct_forward(
-    enum lc3_dt dt, enum lc3_srate sr, enum lc3_srate sr_dst,
-    const float *x, float *d, float *y)
+struct lc3_complex *lc3_mdct_forward_fft(
+    enum lc3_dt dt, enum lc3_srate sr, const float *x, float *d,
+    struct lc3_complex *z0, struct lc3_complex *z1)
 {
     const struct lc3_mdct_rot_def *rot = lc3_mdct_rot[dt][sr];
-    int ns_dst = lc3_ns(dt, sr_dst);
     int ns = lc3_ns(dt, sr);
 
-    struct lc3_complex buffer[LC3_MAX_NS / 2];
-    struct lc3_complex *z = (struct lc3_complex *)y;
-    union { float *f; struct lc3_complex *z; } u = { .z = buffer };
+    union { float *f; struct lc3_complex *z; } u = { .z = z0 };
 
     mdct_window(dt, sr, x, d, u.f);
 
     mdct_pre_fft(rot, u.f, u.z);
-    u.z = fft(u.z, ns/2, u.z, z);
-    mdct_post_fft(rot, u.z, y);
+    return fft(u.z, ns/2, u.z, z1);
+}
+
+/**
+ * Forward MDCT transformation, post-rotation step
+ */
+void lc3_mdct_forward_rot(
+    enum lc3_dt dt, enum lc3_srate sr, enum lc3_srate sr_dst,
+    const struct lc3_complex *z, float *y)
+{
+    const struct lc3_mdct_rot_def *rot = lc3_mdct_rot[dt][sr];
+    int ns_dst = lc3_ns(dt, sr_dst);
+    int ns = lc3_ns(dt, sr);
 
     if (ns != ns_dst)
-        rescale(y, ns_dst, sqrtf((float)ns_dst / ns));
+        mdct_post_fft_pruned(rot, z, y, ns_dst, sqrtf((float)ns_dst / ns));
+    else
+        mdct_post_fft(rot, z, y);
 }
 
 /**
@@ -464,12 +583,14 @@ void lc3_mdct_inverse(
     struct lc3_complex *z = (struct lc3_complex *)y;
     union { float *f; struct lc3_complex *z; } u = { .z = buffer };
 
-    imdct_pre_fft(rot, x, z);
+    if (ns != ns_src)
+        imdct_pre_fft_pruned(rot, x, lc3_ne(dt, sr_src),
+            sqrtf((float)ns / ns_src), z);
+    else
+        imdct_pre_fft(rot, x, z);
+
     z = fft(z, ns/2, z, u.z);
     imdct_post_fft(rot, z, u.f);
 
-    if (ns != ns_src)
-        rescale(u.f, ns, sqrtf((float)ns / ns_src));
-
     imdct_window(dt, sr, u.f, d, y);
 }
@@ -30,11 +30,36 @@
  * y, d            Output `ns` coefficients and `nd` delayed samples
  *
  * `x` and `y` can be the same buffer
+ * When `sr_dst` is lower than `sr`, only the `ns` coefficients of `sr_dst`
+ * are computed, the next ones are left undefined.
  */
 void lc3_mdct_forward(
     enum lc3_dt dt, enum lc3_srate sr, enum lc3_srate sr_dst,
     const float *x, float *d, float *y);
 
+/**
+ * Forward MDCT transformation, in two steps
+ * dt, sr          Duration and samplerate (size of the transform)
+ * x, d            Temporal samples and delayed buffer
+ * z0, z1          Buffers of `ns/2` complex values, `z1` can be `x`
+ * return          The FFT output, `z0` or `z1`
+ *
+ * sr_dst          Samplerate destination, scale transform accordingly
+ * z               The FFT output
+ * y               Output coefficients, `lc3_ns(dt, sr_dst)` values
+ *
+ * `lc3_mdct_forward()` is `lc3_mdct_forward_fft()` followed by
+ * `lc3_mdct_forward_rot()`. The output of the FFT can be shared by
+ * destinations of different samplerates.
+ */
+struct lc3_complex *lc3_mdct_forward_fft(
+    enum lc3_dt dt, enum lc3_srate sr, const float *x, float *d,
+    struct lc3_complex *z0, struct lc3_complex *z1);
+
+void lc3_mdct_forward_rot(
+    enum lc3_dt dt, enum lc3_srate sr, enum lc3_srate sr_dst,
+    const struct lc3_complex *z, float *y);
+
 /**
  * Inverse MDCT transformation
  * dt, sr          Duration and samplerate (size of the transform)
@@ -43,6 +68,8 @@ void lc3_mdct_forward(
  * y, d            Output `ns` samples and `nd` delayed ones
  *
  * `x` and `y` can be the same buffer
+ * When `sr_src` is lower than `sr`, only the `ne` coefficients of `sr_src`
+ * are read, the next ones are taken as null.
  */
 void lc3_mdct_inverse(
     enum lc3_dt dt, enum lc3_srate sr, enum lc3_srate sr_src,
@@ -17,7 +17,7 @@
  ******************************************************************************/
 
 #if __ARM_NEON && __ARM_ARCH_ISA_A64 && \
-        !defined(TEST_ARM) || defined(TEST_NEON)
+        !defined(TEST_ARM) && !defined(TEST_WASM) || defined(TEST_NEON)
 
 #ifndef TEST_NEON
 #include <arm_neon.h>
@@ -293,4 +293,408 @@ LC3_HOT static inline void neon_fft_bf2(
 
 #endif /* fft_bf2 */
 
+
+/**
+ * Reverse the order of the 4 elements of a vector
+ */
+LC3_HOT static inline float32x4_t neon_rev_f32(float32x4_t v)
+{
+    v = vrev64q_f32(v);
+    return vcombine_f32(vget_high_f32(v), vget_low_f32(v));
+}
+
+
+/**
+ * Windowing of samples before MDCT
+ *
+ * The samples are processed by groups of 4, the ones read or written
+ * in reverse order are loaded and stored reversed.
+ */
+#ifndef mdct_window
+
+LC3_HOT static void neon_mdct_window(
+    enum lc3_dt dt, enum lc3_srate sr,
+    const float *x, float *d, float *y)
+{
+    const float *win = lc3_mdct_win[dt][sr];
+    int ns = lc3_ns(dt, sr), nd = lc3_nd(dt, sr);
+    int n2 = ns >> 1, m = ns - nd;
+    int i = 0;
+
+    /* --- Delayed samples, and first samples of the frame --- */
+
+    for ( ; i + 4 <= m; i += 4) {
+        float32x4_t x0 = vld1q_f32(x + m + i);
+        float32x4_t x1 = neon_rev_f32(vld1q_f32(x + m-4 - i));
+        float32x4_t d0 = vld1q_f32(d + i);
+
+        float32x4_t w0 = vld1q_f32(win + i);
+        float32x4_t w1 = neon_rev_f32(vld1q_f32(win + ns-4 - i));
+        float32x4_t w2 = vld1q_f32(win + ns + i);
+
+        vst1q_f32(y + n2-4 - i,
+            neon_rev_f32(vfmsq_f32(vmulq_f32(d0, w0), x1, w1)));
+        vst1q_f32(y + n2 + i, vmulq_f32(x0, w2));
+        vst1q_f32(d + i, x0);
+    }
+
+    for ( ; i < m; i++) {
+        y[n2-1 - i] = d[i] * win[i] - x[m-1 - i] * win[ns-1 - i];
+        y[n2 + i] = (d[i] = x[m + i]) * win[ns + i];
+    }
+
+    /* --- Overlapped samples of the frame --- */
+
+    for ( ; i + 4 <= n2; i += 4) {
+        int j = i - m;
+
+        float32x4_t x0 = vld1q_f32(x + m + i);
+        float32x4_t x1 = vld1q_f32(x + ns-4 - j);
+        float32x4_t d0 = vld1q_f32(d + i);
+        float32x4_t d1 = neon_rev_f32(vld1q_f32(d + nd-4 - j));
+
+        float32x4_t w0 = vld1q_f32(win + i);
+        float32x4_t w1 = neon_rev_f32(vld1q_f32(win + ns-4 - i));
+        float32x4_t w2 = vld1q_f32(win + ns + i);
+        float32x4_t w3 = neon_rev_f32(vld1q_f32(win + ns+nd-4 - j));
+
+        vst1q_f32(y + n2-4 - i,
+            neon_rev_f32(vfmsq_f32(vmulq_f32(d0, w0), d1, w1)));
+        vst1q_f32(y + n2 + i,
+            vfmaq_f32(vmulq_f32(x0, w2), neon_rev_f32(x1), w3));
+
+        vst1q_f32(d + i, x0);
+        vst1q_f32(d + nd-4 - j, x1);
+    }
+
+    for ( ; i < n2; i++) {
+        int j = i - m;
+
+        y[n2-1 - i] = d[i] * win[i] - d[nd-1 - j] * win[ns-1 - i];
+        y[n2 + i] = (d[i] = x[m + i]) * win[ns + i] +
+                    (d[nd-1 - j] = x[ns-1 - j]) * win[ns+nd-1 - j];
+    }
+}
+
+#ifndef TEST_NEON
+#define mdct_window neon_mdct_window
+#endif
+
+#endif /* mdct_window */
+
+
+/**
+ * Pre-rotate MDCT coefficients of N/2 points, before FFT N/4 points FFT
+ *
+ * The rotations are processed by groups of 4, deinterleaving the complex
+ * values on load and store. Each group read and write back the same
+ * location, that allows the in-place operation.
+ */
+#ifndef mdct_pre_fft
+
+LC3_HOT static void neon_mdct_pre_fft(const struct lc3_mdct_rot_def *def,
+    const float *x, struct lc3_complex *y)
+{
+    int n4 = def->n4, n8 = n4 >> 1;
+    const struct lc3_complex *w = def->w;
+    int i = 0;
+
+    for ( ; i + 4 <= n8; i += 4) {
+        float32x4x2_t x0 = vld2q_f32(x + 2*i);
+        float32x4x2_t x1 = vld2q_f32(x + 2*n4-8 - 2*i);
+        float32x4x2_t w0 = vld2q_f32((const float *)(w + i));
+        float32x4x2_t w1 = vld2q_f32((const float *)(w + n4-4 - i));
+
+        float32x4_t u0 = x0.val[0], u1 = neon_rev_f32(x1.val[1]);
+        float32x4_t v0 = x0.val[1], v1 = neon_rev_f32(x1.val[0]);
+        float32x4_t vw_re = neon_rev_f32(w1.val[0]);
+        float32x4_t vw_im = neon_rev_f32(w1.val[1]);
+
+        float32x4x2_t u, v;
+
+        u.val[0] = vfmsq_f32(vmulq_f32(u0, w0.val[1]), u1, w0.val[0]);
+        u.val[1] = vfmaq_f32(vmulq_f32(u0, w0.val[0]), u1, w0.val[1]);
+
+        v.val[0] = neon_rev_f32(vfmsq_f32(vmulq_f32(v0, vw_re), v1, vw_im));
+        v.val[1] = neon_rev_f32(
+            vnegq_f32(vfmaq_f32(vmulq_f32(v0, vw_im), v1, vw_re)));
+
+        vst2q_f32((float *)(y + i), u);
+        vst2q_f32((float *)(y + n4-4 - i), v);
+    }
+
+    for ( ; i < n8; i++) {
+        float u0 = x[2*i], u1 = x[2*n4-1 - 2*i];
+        float v0 = x[2*i+1], v1 = x[2*n4-2 - 2*i];
+        struct lc3_complex uw = w[i], vw = w[n4-1 - i];
+
+        y[i].re = - u1 * uw.re + u0 * uw.im;
+        y[i].im =   u0 * uw.re + u1 * uw.im;
+
+        y[n4-1 - i].re = - v1 * vw.im + v0 * vw.re;
+        y[n4-1 - i].im = - v0 * vw.im - v1 * vw.re;
+    }
+}
+
+#ifndef TEST_NEON
+#define mdct_pre_fft neon_mdct_pre_fft
+#endif
+
+#endif /* mdct_pre_fft */
+
+
+/**
+ * Post-rotate FFT N/4 points coefficients, resulting MDCT N points
+ */
+#ifndef mdct_post_fft
+
+LC3_HOT static void neon_mdct_post_fft(const struct lc3_mdct_rot_def *def,
+    const struct lc3_complex *x, float *y)
+{
+    int n4 = def->n4, n8 = n4 >> 1;
+    const struct lc3_complex *w = def->w;
+    int i = 0;
+
+    for ( ; i + 4 <= n8; i += 4) {
+        float32x4x2_t x0 = vld2q_f32((const float *)(x + n8 + i));
+        float32x4x2_t x1 = vld2q_f32((const float *)(x + n8-4 - i));
+        float32x4x2_t w0 = vld2q_f32((const float *)(w + n8 + i));
+        float32x4x2_t w1 = vld2q_f32((const float *)(w + n8-4 - i));
+
+        float32x4_t x1_re = neon_rev_f32(x1.val[0]);
+        float32x4_t x1_im = neon_rev_f32(x1.val[1]);
+        float32x4_t w1_re = neon_rev_f32(w1.val[0]);
+        float32x4_t w1_im = neon_rev_f32(w1.val[1]);
+
+        float32x4x2_t u, v;
+
+        u.val[0] = vfmaq_f32(
+            vmulq_f32(x0.val[1], w0.val[1]), x0.val[0], w0.val[0]);
+        u.val[1] = vfmsq_f32(vmulq_f32(x1_re, w1_im), x1_im, w1_re);
+
+        v.val[1] = neon_rev_f32(vfmsq_f32(
+            vmulq_f32(x0.val[0], w0.val[1]), x0.val[1], w0.val[0]));
+        v.val[0] = neon_rev_f32(
+            vfmaq_f32(vmulq_f32(x1_im, w1_im), x1_re, w1_re));
+
+        vst2q_f32(y + n4 + 2*i, u);
+        vst2q_f32(y + n4-8 - 2*i, v);
+    }
+
+    for ( ; i < n8; i++) {
+        struct lc3_complex x0 = x[n8 + i], x1 = x[n8-1 - i];
+        struct lc3_complex w0 = w[n8 + i], w1 = w[n8-1 - i];
+
+        y[n4 + 2*i + 0] = x0.im * w0.im + x0.re * w0.re;
+        y[n4 + 2*i + 1] = x1.re * w1.im - x1.im * w1.re;
+
+        y[n4-1 - 2*i] = x0.re * w0.im - x0.im * w0.re;
+        y[n4-2 - 2*i] = x1.im * w1.im + x1.re * w1.re;
+    }
+}
+
+#ifndef TEST_NEON
+#define mdct_post_fft neon_mdct_post_fft
+#endif
+
+#endif /* mdct_post_fft */
+
+
+/**
+ * Pre-rotate IMDCT coefficients of N points, before FFT N/4 points FFT
+ */
+#ifndef imdct_pre_fft
+
+LC3_HOT static void neon_imdct_pre_fft(const struct lc3_mdct_rot_def *def,
+    const float *x, struct lc3_complex *y)
+{
+    int n4 = def->n4, n8 = n4 >> 1;
+    const struct lc3_complex *w = def->w;
+    int i = 0;
+
+    for ( ; i + 4 <= n8; i += 4) {
+        float32x4x2_t x0 = vld2q_f32(x + 2*i);
+        float32x4x2_t x1 = vld2q_f32(x + 2*n4-8 - 2*i);
+        float32x4x2_t w0 = vld2q_f32((const float *)(w + i));
+        float32x4x2_t w1 = vld2q_f32((const float *)(w + n4-4 - i));
+
+        float32x4_t u0 = x0.val[0], u1 = neon_rev_f32(x1.val[1]);
+        float32x4_t v0 = x0.val[1], v1 = neon_rev_f32(x1.val[0]);
+        float32x4_t vw_re = neon_rev_f32(w1.val[0]);
+        float32x4_t vw_im = neon_rev_f32(w1.val[1]);
+
+        float32x4x2_t u, v;
+
+        u.val[0] = vnegq_f32(
+            vfmaq_f32(vmulq_f32(u0, w0.val[0]), u1, w0.val[1]));
+        u.val[1] = vfmsq_f32(vmulq_f32(u0, w0.val[1]), u1, w0.val[0]);
+
+        v.val[0] = neon_rev_f32(
+            vnegq_f32(vfmaq_f32(vmulq_f32(v1, vw_re), v0, vw_im)));
+        v.val[1] = neon_rev_f32(vfmsq_f32(vmulq_f32(v1, vw_im), v0, vw_re));
+
+        vst2q_f32((float *)(y + i), u);
+        vst2q_f32((float *)(y + n4-4 - i), v);
+    }
+
+    for ( ; i < n8; i++) {
+        float u0 = x[2*i], u1 = x[2*n4-1 - 2*i];
+        float v0 = x[2*i+1], v1 = x[2*n4-2 - 2*i];
+        struct lc3_complex uw = w[i], vw = w[n4-1 - i];
+
+        y[i].re = - u0 * uw.re - u1 * uw.im;
+        y[i].im = - u1 * uw.re + u0 * uw.im;
+
+        y[n4-1 - i].re = - v1 * vw.re - v0 * vw.im;
+        y[n4-1 - i].im = - v0 * vw.re + v1 * vw.im;
+    }
+}
+
+#ifndef TEST_NEON
+#define imdct_pre_fft neon_imdct_pre_fft
+#endif
+
+#endif /* imdct_pre_fft */
+
+
+/**
+ * Post-rotate FFT N/4 points coefficients, resulting IMDCT N points
+ */
+#ifndef imdct_post_fft
+
+LC3_HOT static void neon_imdct_post_fft(const struct lc3_mdct_rot_def *def,
+    const struct lc3_complex *x, float *y)
+{
+    int n4 = def->n4, n8 = n4 >> 1;
+    const struct lc3_complex *w = def->w;
+    int i = 0;
+
+    for ( ; i + 4 <= n8; i += 4) {
+        float32x4x2_t x0 = vld2q_f32((const float *)(x + i));
+        float32x4x2_t x1 = vld2q_f32((const float *)(x + n4-4 - i));
+        float32x4x2_t w0 = vld2q_f32((const float *)(w + i));
+        float32x4x2_t w1 = vld2q_f32((const float *)(w + n4-4 - i));
+
+        float32x4_t x1_re = neon_rev_f32(x1.val[0]);
+        float32x4_t x1_im = neon_rev_f32(x1.val[1]);
+        float32x4_t w1_re = neon_rev_f32(w1.val[0]);
+        float32x4_t w1_im = neon_rev_f32(w1.val[1]);
+
+        float32x4x2_t u, v;
+
+        u.val[0] = vfmsq_f32(
+            vmulq_f32(x0.val[0], w0.val[1]), x0.val[1], w0.val[0]);
+        u.val[1] = vfmaq_f32(vmulq_f32(x1_re, w1_re), x1_im, w1_im);
+
+        v.val[1] = neon_rev_f32(vfmaq_f32(
+            vmulq_f32(x0.val[0], w0.val[0]), x0.val[1], w0.val[1]));
+        v.val[0] = neon_rev_f32(
+            vfmsq_f32(vmulq_f32(x1_re, w1_im), x1_im, w1_re));
+
+        vst2q_f32(y + 2*i, u);
+        vst2q_f32(y + 2*n4-8 - 2*i, v);
+    }
+
+    for ( ; i < n8; i++) {
+        struct lc3_complex uz = x[i], vz = x[n4-1 - i];
+        struct lc3_complex uw = w[i], vw = w[n4-1 - i];
+
+        y[2*i + 0] = uz.re * uw.im - uz.im * uw.re;
+        y[2*i + 1] = vz.re * vw.re + vz.im * vw.im;
+
+        y[2*n4-1 - 2*i] = uz.re * uw.re + uz.im * uw.im;
+        y[2*n4-2 - 2*i] = vz.re * vw.im - vz.im * vw.re;
+    }
+}
+
+#ifndef TEST_NEON
+#define imdct_post_fft neon_imdct_post_fft
+#endif
+
+#endif /* imdct_post_fft */
+
+
+/**
+ * Apply windowing of samples
+ *
+ * The samples are processed by groups of 4, the ones read or written
+ * in reverse order are loaded and stored reversed.
+ */
+#ifndef imdct_window
+
+LC3_HOT static void neon_imdct_window(
+    enum lc3_dt dt, enum lc3_srate sr,
+    const float *x, float *d, float *y)
+{
+    const float *win = lc3_mdct_win[dt][sr];
+    int n4 = lc3_ns(dt, sr) >> 1, nd = lc3_nd(dt, sr);
+    int m = nd - n4, c = 3*n4 - nd;
+    int i = 0;
+
+    /* --- Overlap-add with the delayed samples --- */
+
+    for ( ; i + 4 <= m; i += 4) {
+        float32x4_t xi = vld1q_f32(x + i);
+        float32x4_t d0 = neon_rev_f32(vld1q_f32(d + m-4 - i));
+        float32x4_t d1 = vld1q_f32(d + m + i);
+        float32x4_t w0 = neon_rev_f32(vld1q_f32(win + 3*n4-4 - i));
+        float32x4_t w1 = vld1q_f32(win + 3*n4 + i);
+
+        vst1q_f32(y + m-4 - i, neon_rev_f32(vfmsq_f32(d0, xi, w1)));
+        vst1q_f32(y + m + i, vfmaq_f32(d1, xi, w0));
+    }
+
+    for ( ; i < m; i++) {
+        y[m-1 - i] = d[m-1 - i] - x[i] * win[3*n4 + i];
+        y[m + i] = d[m + i] + x[i] * win[3*n4-1 - i];
+    }
+
+    for ( ; i + 4 <= n4; i += 4) {
+        float32x4_t w0 = neon_rev_f32(vld1q_f32(win + 3*n4-4 - i));
+        vst1q_f32(y + m + i,
+            vfmaq_f32(vld1q_f32(d + m + i), vld1q_f32(x + i), w0));
+    }
+
+    for ( ; i < n4; i++)
+        y[m + i] = d[m + i] + x[i] * win[3*n4-1 - i];
+
+    /* --- Last output samples, and first delayed samples --- */
+
+    for ( ; i + 4 <= c; i += 4) {
+        float32x4_t xi = vld1q_f32(x + i);
+        float32x4_t w0 = neon_rev_f32(vld1q_f32(win + 3*n4-4 - i));
+        float32x4_t w2 = vld1q_f32(win + i - n4);
+
+        vst1q_f32(y + m + i, vmulq_f32(xi, w0));
+        vst1q_f32(d + nd+n4-4 - i, neon_rev_f32(vmulq_f32(xi, w2)));
+    }
+
+    for ( ; i < c; i++) {
+        y[m + i] = x[i] * win[3*n4-1 - i];
+        d[nd+n4-1 - i] = x[i] * win[i - n4];
+    }
+
+    /* --- Remaining delayed samples --- */
+
+    for ( ; i + 4 <= 2*n4; i += 4) {
+        float32x4_t xi = vld1q_f32(x + i);
+        float32x4_t w0 = neon_rev_f32(vld1q_f32(win + 3*n4-4 - i));
+        float32x4_t w2 = vld1q_f32(win + i - n4);
+
+        vst1q_f32(d + i - c, vmulq_f32(xi, w0));
+        vst1q_f32(d + nd+n4-4 - i, neon_rev_f32(vmulq_f32(xi, w2)));
+    }
+
+    for ( ; i < 2*n4; i++) {
+        d[i - c] = x[i] * win[3*n4-1 - i];
+        d[nd+n4-1 - i] = x[i] * win[i - n4];
+    }
+}
+
+#ifndef TEST_NEON
+#define imdct_window neon_imdct_window
+#endif
+
+#endif /* imdct_window */
+
 #endif /* __ARM_NEON && __ARM_ARCH_ISA_A64 */
@@ -0,0 +1,198 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if __wasm_simd128__ && !defined(TEST_ARM) && !defined(TEST_NEON) && \
+        !defined(TEST_SSE) || defined(TEST_WASM)
+
+#ifndef TEST_WASM
+#include <wasm_simd128.h>
+#endif /* TEST_WASM */
+
+
+/**
+ * Complex products of a pair of coefficients, by a pair of twiddles
+ */
+#if !defined(fft_bf3) || !defined(fft_bf2)
+
+LC3_HOT static inline v128_t wasm_cmul(v128_t x, v128_t w)
+{
+    v128_t xr = wasm_i32x4_shuffle(wasm_f32x4_neg(x), x, 1, 4, 3, 6);
+
+    v128_t w_re = wasm_i32x4_shuffle(w, w, 0, 0, 2, 2);
+    v128_t w_im = wasm_i32x4_shuffle(w, w, 1, 1, 3, 3);
+
+    return wasm_f32x4_add(wasm_f32x4_mul(x, w_re), wasm_f32x4_mul(xr, w_im));
+}
+
+#endif /* fft_bf3 || fft_bf2 */
+
+/**
+ * FFT Butterfly 3 Points
+ */
+#ifndef fft_bf3
+
+LC3_HOT static inline void wasm_fft_bf3(
+    const struct lc3_fft_bf3_twiddles *twiddles,
+    const struct lc3_complex *x, struct lc3_complex *y, int n)
+{
+    int n3 = twiddles->n3;
+    const struct lc3_complex (*w0_ptr)[2] = twiddles->t;
+    const struct lc3_complex (*w1_ptr)[2] = w0_ptr + n3;
+    const struct lc3_complex (*w2_ptr)[2] = w1_ptr + n3;
+
+    const struct lc3_complex *x0_ptr = x;
+    const struct lc3_complex *x1_ptr = x0_ptr + n*n3;
+    const struct lc3_complex *x2_ptr = x1_ptr + n*n3;
+
+    struct lc3_complex *y0_ptr = y;
+    struct lc3_complex *y1_ptr = y0_ptr + n3;
+    struct lc3_complex *y2_ptr = y1_ptr + n3;
+
+    for (int j, i = 0; i < n; i++,
+            y0_ptr += 3*n3, y1_ptr += 3*n3, y2_ptr += 3*n3) {
+
+        /* --- Process by pair --- */
+
+        for (j = 0; j < (n3 >> 1); j++,
+                x0_ptr += 2, x1_ptr += 2, x2_ptr += 2) {
+
+            v128_t x0 = wasm_v128_load(x0_ptr);
+            v128_t x1 = wasm_v128_load(x1_ptr);
+            v128_t x2 = wasm_v128_load(x2_ptr);
+            v128_t wa, wb, yn;
+
+            wa = wasm_v128_load(w0_ptr + 2*j + 0);
+            wb = wasm_v128_load(w0_ptr + 2*j + 1);
+
+            yn = wasm_f32x4_add(x0,
+                wasm_cmul(x1, wasm_i32x4_shuffle(wa, wb, 0, 1, 4, 5)));
+            yn = wasm_f32x4_add(yn,
+                wasm_cmul(x2, wasm_i32x4_shuffle(wa, wb, 2, 3, 6, 7)));
+            wasm_v128_store(y0_ptr + 2*j, yn);
+
+            wa = wasm_v128_load(w1_ptr + 2*j + 0);
+            wb = wasm_v128_load(w1_ptr + 2*j + 1);
+
+            yn = wasm_f32x4_add(x0,
+                wasm_cmul(x1, wasm_i32x4_shuffle(wa, wb, 0, 1, 4, 5)));
+            yn = wasm_f32x4_add(yn,
+                wasm_cmul(x2, wasm_i32x4_shuffle(wa, wb, 2, 3, 6, 7)));
+            wasm_v128_store(y1_ptr + 2*j, yn);
+
+            wa = wasm_v128_load(w2_ptr + 2*j + 0);
+            wb = wasm_v128_load(w2_ptr + 2*j + 1);
+
+            yn = wasm_f32x4_add(x0,
+                wasm_cmul(x1, wasm_i32x4_shuffle(wa, wb, 0, 1, 4, 5)));
+            yn = wasm_f32x4_add(yn,
+                wasm_cmul(x2, wasm_i32x4_shuffle(wa, wb, 2, 3, 6, 7)));
+            wasm_v128_store(y2_ptr + 2*j, yn);
+        }
+
+        /* --- Last iteration --- */
+
+        if (n3 & 1) {
+            const struct lc3_complex *w0 = w0_ptr[2*j];
+            const struct lc3_complex *w1 = w1_ptr[2*j];
+            const struct lc3_complex *w2 = w2_ptr[2*j];
+
+            const struct lc3_complex *x0 = x0_ptr++;
+            const struct lc3_complex *x1 = x1_ptr++;
+            const struct lc3_complex *x2 = x2_ptr++;
+
+            y0_ptr[2*j].re = x0->re + x1->re * w0[0].re - x1->im * w0[0].im
+                                    + x2->re * w0[1].re - x2->im * w0[1].im;
+
+            y0_ptr[2*j].im = x0->im + x1->im * w0[0].re + x1->re * w0[0].im
+                                    + x2->im * w0[1].re + x2->re * w0[1].im;
+
+            y1_ptr[2*j].re = x0->re + x1->re * w1[0].re - x1->im * w1[0].im
+                                    + x2->re * w1[1].re - x2->im * w1[1].im;
+
+            y1_ptr[2*j].im = x0->im + x1->im * w1[0].re + x1->re * w1[0].im
+                                    + x2->im * w1[1].re + x2->re * w1[1].im;
+
+            y2_ptr[2*j].re = x0->re + x1->re * w2[0].re - x1->im * w2[0].im
+                                    + x2->re * w2[1].re - x2->im * w2[1].im;
+
+            y2_ptr[2*j].im = x0->im + x1->im * w2[0].re + x1->re * w2[0].im
+                                    + x2->im * w2[1].re + x2->re * w2[1].im;
+        }
+    }
+}
+
+#ifndef TEST_WASM
+#define fft_bf3 wasm_fft_bf3
+#endif
+
+#endif /* fft_bf3 */
+
+/**
+ * FFT Butterfly 2 Points
+ */
+#ifndef fft_bf2
+
+LC3_HOT static inline void wasm_fft_bf2(
+    const struct lc3_fft_bf2_twiddles *twiddles,
+    const struct lc3_complex *x, struct lc3_complex *y, int n)
+{
+    int n2 = twiddles->n2;
+    const struct lc3_complex *w_ptr = twiddles->t;
+
+    const struct lc3_complex *x0_ptr = x;
+    const struct lc3_complex *x1_ptr = x0_ptr + n*n2;
+
+    struct lc3_complex *y0_ptr = y;
+    struct lc3_complex *y1_ptr = y0_ptr + n2;
+
+    for (int j, i = 0; i < n; i++, y0_ptr += 2*n2, y1_ptr += 2*n2) {
+
+        /* --- Process by pair --- */
+
+        for (j = 0; j < (n2 >> 1); j++, x0_ptr += 2, x1_ptr += 2) {
+
+            v128_t x0 = wasm_v128_load(x0_ptr);
+            v128_t x1 = wasm_cmul(
+                wasm_v128_load(x1_ptr), wasm_v128_load(w_ptr + 2*j));
+
+            wasm_v128_store(y0_ptr + 2*j, wasm_f32x4_add(x0, x1));
+            wasm_v128_store(y1_ptr + 2*j, wasm_f32x4_sub(x0, x1));
+        }
+
+        /* --- Last iteration --- */
+
+        if (n2 & 1) {
+            const struct lc3_complex *w = w_ptr + 2*j;
+            const struct lc3_complex *x0 = x0_ptr++, *x1 = x1_ptr++;
+
+            y0_ptr[2*j].re = x0->re + x1->re * w->re - x1->im * w->im;
+            y0_ptr[2*j].im = x0->im + x1->im * w->re + x1->re * w->im;
+
+            y1_ptr[2*j].re = x0->re - x1->re * w->re + x1->im * w->im;
+            y1_ptr[2*j].im = x0->im - x1->im * w->re - x1->re * w->im;
+        }
+    }
+}
+
+#ifndef TEST_WASM
+#define fft_bf2 wasm_fft_bf2
+#endif
+
+#endif /* fft_bf2 */
+
+#endif /* __wasm_simd128__ */
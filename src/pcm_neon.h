@@ -0,0 +1,160 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if __ARM_NEON && __ARM_ARCH_ISA_A64 && \
+        !defined(TEST_ARM) && !defined(TEST_WASM) || defined(TEST_NEON)
+
+#ifndef TEST_NEON
+#include <arm_neon.h>
+#endif /* TEST_NEON */
+
+
+/**
+ * Convert PCM samples from signed 16 bits
+ *
+ * Only the contiguous samples are vectorized,
+ * interleaved ones are converted one by one.
+ */
+#ifndef pcm_from_s16
+
+LC3_HOT static void neon_pcm_from_s16(
+    const int16_t *pcm, int stride, int n, int16_t *xt, float *xs)
+{
+    int i = 0;
+
+    for ( ; stride == 1 && i + 8 <= n; i += 8) {
+        int16x8_t v = vld1q_s16(pcm + i);
+        vst1q_s16(xt + i, v);
+
+        vst1q_f32(xs + i + 0, vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))));
+        vst1q_f32(xs + i + 4, vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))));
+    }
+
+    for (pcm += i*stride; i < n; i++, pcm += stride)
+        xt[i] = *pcm, xs[i] = *pcm;
+}
+
+#ifndef TEST_NEON
+#define pcm_from_s16 neon_pcm_from_s16
+#endif
+
+#endif /* pcm_from_s16 */
+
+
+/**
+ * Convert PCM samples from float 32 bits
+ */
+#ifndef pcm_from_float
+
+LC3_HOT static void neon_pcm_from_float(
+    const float *pcm, int stride, int n, int16_t *xt, float *xs)
+{
+    int i = 0;
+
+    for ( ; stride == 1 && i + 8 <= n; i += 8) {
+        float32x4_t v0 = vmulq_n_f32(vld1q_f32(pcm + i + 0), 0x1p15f);
+        float32x4_t v1 = vmulq_n_f32(vld1q_f32(pcm + i + 4), 0x1p15f);
+
+        vst1q_f32(xs + i + 0, v0);
+        vst1q_f32(xs + i + 4, v1);
+
+        vst1q_s16(xt + i, vcombine_s16(
+            vqmovn_s32(vcvtq_s32_f32(v0)), vqmovn_s32(vcvtq_s32_f32(v1)) ));
+    }
+
+    for (pcm += i*stride; i < n; i++, pcm += stride) {
+        xs[i] = lc3_ldexpf(*pcm, 15);
+        xt[i] = LC3_SAT16((int32_t)xs[i]);
+    }
+}
+
+#ifndef TEST_NEON
+#define pcm_from_float neon_pcm_from_float
+#endif
+
+#endif /* pcm_from_float */
+
+
+/**
+ * Convert PCM samples to signed 16 bits
+ *
+ * The rounding half away from zero is done by adding 0.5 with the sign
+ * of the sample, before the conversion that truncates toward zero.
+ */
+#ifndef pcm_to_s16
+
+LC3_HOT static void neon_pcm_to_s16(
+    const float *xs, int n, int16_t *pcm, int stride)
+{
+    const float32x4_t zero = vmovq_n_f32(0);
+    const float32x4_t h_pos = vmovq_n_f32(0.5f), h_neg = vmovq_n_f32(-0.5f);
+    int i = 0;
+
+    for ( ; stride == 1 && i + 8 <= n; i += 8) {
+        float32x4_t v0 = vld1q_f32(xs + i + 0);
+        float32x4_t v1 = vld1q_f32(xs + i + 4);
+
+        v0 = vaddq_f32(v0, vbslq_f32(vcltq_f32(v0, zero), h_neg, h_pos));
+        v1 = vaddq_f32(v1, vbslq_f32(vcltq_f32(v1, zero), h_neg, h_pos));
+
+        vst1q_s16(pcm + i, vcombine_s16(
+            vqmovn_s32(vcvtq_s32_f32(v0)), vqmovn_s32(vcvtq_s32_f32(v1)) ));
+    }
+
+    for (pcm += i*stride; i < n; i++, pcm += stride) {
+        int32_t s = xs[i] >= 0 ? (int)(xs[i] + 0.5f) : (int)(xs[i] - 0.5f);
+        *pcm = LC3_SAT16(s);
+    }
+}
+
+#ifndef TEST_NEON
+#define pcm_to_s16 neon_pcm_to_s16
+#endif
+
+#endif /* pcm_to_s16 */
+
+
+/**
+ * Convert PCM samples to float 32 bits
+ */
+#ifndef pcm_to_float
+
+LC3_HOT static void neon_pcm_to_float(
+    const float *xs, int n, float *pcm, int stride)
+{
+    const float32x4_t one = vmovq_n_f32(1.f), minus_one = vmovq_n_f32(-1.f);
+    int i = 0;
+
+    for ( ; stride == 1 && i + 4 <= n; i += 4) {
+        float32x4_t v = vmulq_n_f32(vld1q_f32(xs + i), 0x1p-15f);
+        vst1q_f32(pcm + i, vminq_f32(vmaxq_f32(v, minus_one), one));
+    }
+
+    for (pcm += i*stride; i < n; i++, pcm += stride) {
+        float s = lc3_ldexpf(xs[i], -15);
+        *pcm = fminf(fmaxf(s, -1.f), 1.f);
+    }
+}
+
+#ifndef TEST_NEON
+#define pcm_to_float neon_pcm_to_float
+#endif
+
+#endif /* pcm_to_float */
+
+#endif /* __ARM_NEON && __ARM_ARCH_ISA_A64 */
@@ -0,0 +1,169 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if __wasm_simd128__ && !defined(TEST_ARM) && !defined(TEST_NEON) && \
+        !defined(TEST_SSE) || defined(TEST_WASM)
+
+#ifndef TEST_WASM
+#include <wasm_simd128.h>
+#endif /* TEST_WASM */
+
+
+/**
+ * Convert PCM samples from signed 16 bits
+ *
+ * Only the contiguous samples are vectorized,
+ * interleaved ones are converted one by one.
+ */
+#ifndef pcm_from_s16
+
+LC3_HOT static void wasm_pcm_from_s16(
+    const int16_t *pcm, int stride, int n, int16_t *xt, float *xs)
+{
+    int i = 0;
+
+    for ( ; stride == 1 && i + 8 <= n; i += 8) {
+        v128_t v = wasm_v128_load(pcm + i);
+        wasm_v128_store(xt + i, v);
+
+        wasm_v128_store(xs + i + 0,
+            wasm_f32x4_convert_i32x4(wasm_i32x4_extend_low_i16x8(v)));
+        wasm_v128_store(xs + i + 4,
+            wasm_f32x4_convert_i32x4(wasm_i32x4_extend_high_i16x8(v)));
+    }
+
+    for (pcm += i*stride; i < n; i++, pcm += stride)
+        xt[i] = *pcm, xs[i] = *pcm;
+}
+
+#ifndef TEST_WASM
+#define pcm_from_s16 wasm_pcm_from_s16
+#endif
+
+#endif /* pcm_from_s16 */
+
+
+/**
+ * Convert PCM samples from float 32 bits
+ */
+#ifndef pcm_from_float
+
+LC3_HOT static void wasm_pcm_from_float(
+    const float *pcm, int stride, int n, int16_t *xt, float *xs)
+{
+    const v128_t scale = wasm_f32x4_splat(0x1p15f);
+    int i = 0;
+
+    for ( ; stride == 1 && i + 8 <= n; i += 8) {
+        v128_t v0 = wasm_f32x4_mul(wasm_v128_load(pcm + i + 0), scale);
+        v128_t v1 = wasm_f32x4_mul(wasm_v128_load(pcm + i + 4), scale);
+
+        wasm_v128_store(xs + i + 0, v0);
+        wasm_v128_store(xs + i + 4, v1);
+
+        wasm_v128_store(xt + i, wasm_i16x8_narrow_i32x4(
+            wasm_i32x4_trunc_sat_f32x4(v0), wasm_i32x4_trunc_sat_f32x4(v1) ));
+    }
+
+    for (pcm += i*stride; i < n; i++, pcm += stride) {
+        xs[i] = lc3_ldexpf(*pcm, 15);
+        xt[i] = LC3_SAT16((int32_t)xs[i]);
+    }
+}
+
+#ifndef TEST_WASM
+#define pcm_from_float wasm_pcm_from_float
+#endif
+
+#endif /* pcm_from_float */
+
+
+/**
+ * Convert PCM samples to signed 16 bits
+ *
+ * The rounding half away from zero is done by adding 0.5 with the sign
+ * of the sample, before the conversion that truncates toward zero.
+ */
+#ifndef pcm_to_s16
+
+LC3_HOT static void wasm_pcm_to_s16(
+    const float *xs, int n, int16_t *pcm, int stride)
+{
+    const v128_t zero = wasm_f32x4_splat(0);
+    const v128_t h_pos = wasm_f32x4_splat(0.5f);
+    const v128_t h_neg = wasm_f32x4_splat(-0.5f);
+    int i = 0;
+
+    for ( ; stride == 1 && i + 8 <= n; i += 8) {
+        v128_t v0 = wasm_v128_load(xs + i + 0);
+        v128_t v1 = wasm_v128_load(xs + i + 4);
+
+        v0 = wasm_f32x4_add(v0,
+            wasm_v128_bitselect(h_neg, h_pos, wasm_f32x4_lt(v0, zero)));
+        v1 = wasm_f32x4_add(v1,
+            wasm_v128_bitselect(h_neg, h_pos, wasm_f32x4_lt(v1, zero)));
+
+        wasm_v128_store(pcm + i, wasm_i16x8_narrow_i32x4(
+            wasm_i32x4_trunc_sat_f32x4(v0), wasm_i32x4_trunc_sat_f32x4(v1) ));
+    }
+
+    for (pcm += i*stride; i < n; i++, pcm += stride) {
+        int32_t s = xs[i] >= 0 ? (int)(xs[i] + 0.5f) : (int)(xs[i] - 0.5f);
+        *pcm = LC3_SAT16(s);
+    }
+}
+
+#ifndef TEST_WASM
+#define pcm_to_s16 wasm_pcm_to_s16
+#endif
+
+#endif /* pcm_to_s16 */
+
+
+/**
+ * Convert PCM samples to float 32 bits
+ */
+#ifndef pcm_to_float
+
+LC3_HOT static void wasm_pcm_to_float(
+    const float *xs, int n, float *pcm, int stride)
+{
+    const v128_t scale = wasm_f32x4_splat(0x1p-15f);
+    const v128_t one = wasm_f32x4_splat(1.f);
+    const v128_t minus_one = wasm_f32x4_splat(-1.f);
+    int i = 0;
+
+    for ( ; stride == 1 && i + 4 <= n; i += 4) {
+        v128_t v = wasm_f32x4_mul(wasm_v128_load(xs + i), scale);
+        wasm_v128_store(pcm + i,
+            wasm_f32x4_min(wasm_f32x4_max(v, minus_one), one));
+    }
+
+    for (pcm += i*stride; i < n; i++, pcm += stride) {
+        float s = lc3_ldexpf(xs[i], -15);
+        *pcm = fminf(fmaxf(s, -1.f), 1.f);
+    }
+}
+
+#ifndef TEST_WASM
+#define pcm_to_float wasm_pcm_to_float
+#endif
+
+#endif /* pcm_to_float */
+
+#endif /* __wasm_simd128__ */
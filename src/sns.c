@@ -19,6 +19,8 @@
 #include "sns.h"
 #include "tables.h"
 
+#include "sns_neon.h"
+
 
 /* ----------------------------------------------------------------------------
  *  DCT-16
@@ -703,27 +705,40 @@ static void deenumerate(int shape,
         memset(c + 10, 0, 6 * sizeof(*c));
 }
 
+/**
+ * Scale factors of the bitstream data
+ * data            Bitstream data
+ * scf             Return the 16 quantized scale factors
+ */
+static void decode_scale_factors(const lc3_sns_data_t *data, float *scf)
+{
+    float cn[16];
+    int c[16];
+
+    deenumerate(data->shape,
+        data->idx_a, data->ls_a, data->idx_b, data->ls_b, c);
+
+    normalize(c, cn);
+
+    unquantize(data->lfcb, data->hfcb, cn, data->shape, data->gain, scf);
+}
+
 
 /* ----------------------------------------------------------------------------
  *  Filtering
  * -------------------------------------------------------------------------- */
 
 /**
- * Spectral shaping
+ * Interpolation of the scale factors to the bands
  * dt, sr          Duration and samplerate of the frame
  * scf_q           Quantized scale factors
  * inv             True on inverse shaping, False otherwise
- * x               Spectral coefficients
- * y               Return shapped coefficients
- *
- * `x` and `y` can be the same buffer
+ * scf             Return the scale factors of the bands
  */
-LC3_HOT static void spectral_shaping(enum lc3_dt dt, enum lc3_srate sr,
-    const float *scf_q, bool inv, const float *x, float *y)
+LC3_HOT static void interpolate_scale_factors(
+    enum lc3_dt dt, enum lc3_srate sr, const float *scf_q, bool inv,
+    float *scf)
 {
-    /* --- Interpolate scale factors --- */
-
-    float scf[LC3_MAX_BANDS];
     float s0, s1 = inv ? -scf_q[0] : scf_q[0];
 
     scf[0] = scf[1] = s1;
@@ -749,10 +764,32 @@ LC3_HOT static void spectral_shaping(enum lc3_dt dt, enum lc3_srate sr,
         scf[i2] = 0.5f * (scf[2*(n4+i2)] + scf[2*(n4+i2)+1]);
 
     memmove(scf + n4 + n2, scf + 4*n4 + 2*n2, (nb - n4 - n2) * sizeof(float));
+}
+
+/**
+ * Spectral shaping
+ * dt, sr          Duration and samplerate of the frame
+ * scf_q           Quantized scale factors
+ * inv             True on inverse shaping, False otherwise
+ * x               Spectral coefficients
+ * y               Return shapped coefficients
+ *
+ * `x` and `y` can be the same buffer
+ */
+#ifndef spectral_shaping
+LC3_HOT static void spectral_shaping(enum lc3_dt dt, enum lc3_srate sr,
+    const float *scf_q, bool inv, const float *x, float *y)
+{
+    /* --- Interpolate scale factors --- */
+
+    float scf[LC3_MAX_BANDS];
+
+    interpolate_scale_factors(dt, sr, scf_q, inv, scf);
 
     /* --- Spectral shaping --- */
 
     const int *lim = lc3_band_lim[dt][sr];
+    int nb = lc3_num_bands[dt][sr];
 
     for (int i = 0, ib = 0; ib < nb; ib++) {
         float g_sns = lc3_exp2f(-scf[ib]);
@@ -761,6 +798,7 @@ LC3_HOT static void spectral_shaping(enum lc3_dt dt, enum lc3_srate sr,
             y[i] = x[i] * g_sns;
     }
 }
+#endif /* spectral_shaping */
 
 
 /* ----------------------------------------------------------------------------
@@ -808,17 +846,27 @@ void lc3_sns_synthesize(
     enum lc3_dt dt, enum lc3_srate sr,
     const lc3_sns_data_t *data, const float *x, float *y)
 {
-    float scf[16], cn[16];
-    int c[16];
+    float scf[16];
 
-    deenumerate(data->shape,
-        data->idx_a, data->ls_a, data->idx_b, data->ls_b, c);
+    decode_scale_factors(data, scf);
 
-    normalize(c, cn);
+    spectral_shaping(dt, sr, scf, true, x, y);
+}
 
-    unquantize(data->lfcb, data->hfcb, cn, data->shape, data->gain, scf);
+/**
+ * SNS synthesis gains
+ */
+void lc3_sns_synthesize_gains(
+    enum lc3_dt dt, enum lc3_srate sr, const lc3_sns_data_t *data, float *g)
+{
+    float scf[16], scf_b[LC3_MAX_BANDS];
 
-    spectral_shaping(dt, sr, scf, true, x, y);
+    decode_scale_factors(data, scf);
+
+    interpolate_scale_factors(dt, sr, scf, true, scf_b);
+
+    for (int ib = 0; ib < lc3_num_bands[dt][sr]; ib++)
+        g[ib] = lc3_exp2f(-scf_b[ib]);
 }
 
 /**
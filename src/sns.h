@@ -94,5 +94,18 @@ int lc3_sns_get_data(lc3_bits_t *bits, lc3_sns_data_t *data);
 void lc3_sns_synthesize(enum lc3_dt dt, enum lc3_srate sr,
     const lc3_sns_data_t *data, const float *x, float *y);
 
+/**
+ * SNS synthesis gains
+ * dt, sr          Duration and samplerate of the frame
+ * data            Bitstream data
+ * g               Return the gains of the bands, `lc3_num_bands[dt][sr]`
+ *
+ * The synthesis shaping multiplies the coefficients of a band by its gain.
+ * The gains are applied by `lc3_tns_synthesize_shaped()`, in the pass
+ * of TNS synthesis filtering.
+ */
+void lc3_sns_synthesize_gains(enum lc3_dt dt, enum lc3_srate sr,
+    const lc3_sns_data_t *data, float *g);
+
 
 #endif /* __LC3_SNS_H */
@@ -0,0 +1,105 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if __ARM_NEON && __ARM_ARCH_ISA_A64 && \
+        !defined(TEST_ARM) && !defined(TEST_WASM) || defined(TEST_NEON)
+
+#ifndef TEST_NEON
+#include <arm_neon.h>
+#endif /* TEST_NEON */
+
+
+/**
+ * Spectral shaping
+ */
+#ifndef spectral_shaping
+
+LC3_HOT static void neon_spectral_shaping(enum lc3_dt dt, enum lc3_srate sr,
+    const float *scf_q, bool inv, const float *x, float *y)
+{
+    /* --- Interpolate scale factors ---
+     * The 4 interpolated values between 4 consecutive scale factors
+     * are computed at once, and interleaved on store. */
+
+    float scf[LC3_MAX_BANDS];
+    float sign = inv ? -1.f : 1.f;
+    float s0, s1;
+    int i;
+
+    for (i = 0; i + 4 <= 15; i += 4) {
+        float32x4_t v0 = vmulq_n_f32(vld1q_f32(scf_q + i + 0), sign);
+        float32x4_t v1 = vmulq_n_f32(vld1q_f32(scf_q + i + 1), sign);
+        float32x4_t dv = vsubq_f32(v1, v0);
+
+        float32x4x4_t r;
+        r.val[0] = vaddq_f32(v0, vmulq_n_f32(dv, 0.125f));
+        r.val[1] = vaddq_f32(v0, vmulq_n_f32(dv, 0.375f));
+        r.val[2] = vaddq_f32(v0, vmulq_n_f32(dv, 0.625f));
+        r.val[3] = vaddq_f32(v0, vmulq_n_f32(dv, 0.875f));
+
+        vst4q_f32(scf + 4*i+2, r);
+    }
+
+    scf[0] = scf[1] = sign * scf_q[0];
+    s1 = sign * scf_q[i];
+
+    for ( ; i < 15; i++) {
+        s0 = s1, s1 = sign * scf_q[i+1];
+        scf[4*i+2] = s0 + 0.125f * (s1 - s0);
+        scf[4*i+3] = s0 + 0.375f * (s1 - s0);
+        scf[4*i+4] = s0 + 0.625f * (s1 - s0);
+        scf[4*i+5] = s0 + 0.875f * (s1 - s0);
+    }
+    scf[62] = s1 + 0.125f * (s1 - s0);
+    scf[63] = s1 + 0.375f * (s1 - s0);
+
+    int nb = lc3_num_bands[dt][sr];
+    int n4 = nb < 32 ? 32 % nb : 0;
+    int n2 = nb < 32 ? nb - n4 : LC3_MAX_BANDS - nb;
+
+    for (int i4 = 0; i4 < n4; i4++)
+        scf[i4] = 0.25f * (scf[4*i4+0] + scf[4*i4+1] +
+                           scf[4*i4+2] + scf[4*i4+3]);
+
+    for (int i2 = n4; i2 < n4+n2; i2++)
+        scf[i2] = 0.5f * (scf[2*(n4+i2)] + scf[2*(n4+i2)+1]);
+
+    memmove(scf + n4 + n2, scf + 4*n4 + 2*n2, (nb - n4 - n2) * sizeof(float));
+
+    /* --- Spectral shaping --- */
+
+    const int *lim = lc3_band_lim[dt][sr];
+
+    for (int i = 0, ib = 0; ib < nb; ib++) {
+        float g_sns = lc3_exp2f(-scf[ib]);
+
+        for ( ; i + 4 <= lim[ib+1]; i += 4)
+            vst1q_f32(y + i, vmulq_n_f32(vld1q_f32(x + i), g_sns));
+
+        for ( ; i < lim[ib+1]; i++)
+            y[i] = x[i] * g_sns;
+    }
+}
+
+#ifndef TEST_NEON
+#define spectral_shaping neon_spectral_shaping
+#endif
+
+#endif /* spectral_shaping */
+
+#endif /* __ARM_NEON && __ARM_ARCH_ISA_A64 */
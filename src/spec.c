@@ -20,6 +20,10 @@
 #include "bits.h"
 #include "tables.h"
 
+#include "spec_sse.h"
+#include "spec_neon.h"
+#include "spec_wasm.h"
+
 
 /* ----------------------------------------------------------------------------
  *  Global Gain / Quantization
@@ -67,6 +71,118 @@ static float unquantize_gain(int g_int)
     return g * iq_table[g_int];
 }
 
+/**
+ * Energy by blocks of 4 coefficients
+ * x, n4           Spectral coefficients, and count of blocks
+ * e               Output the energy of the blocks
+ * return          The maximum of the squared coefficients
+ */
+#ifndef compute_energy4
+LC3_HOT static float compute_energy4(const float *x, int n4, float *e)
+{
+    float x2_max = 0;
+
+    for (int i = 0; i < n4; i++) {
+        float x0 = x[4*i + 0] * x[4*i + 0];
+        float x1 = x[4*i + 1] * x[4*i + 1];
+        float x2 = x[4*i + 2] * x[4*i + 2];
+        float x3 = x[4*i + 3] * x[4*i + 3];
+
+        x2_max = fmaxf(x2_max, x0);
+        x2_max = fmaxf(x2_max, x1);
+        x2_max = fmaxf(x2_max, x2);
+        x2_max = fmaxf(x2_max, x3);
+
+        e[i] = x0 + x1 + x2 + x3;
+    }
+
+    return x2_max;
+}
+#endif /* compute_energy4 */
+
+/**
+ * Convert energies to dB, in fixed Q16
+ * e, n            Energy values, and count
+ * nf              Noise floor added to the energy values
+ * e_db            Output the energies in dB (Q16)
+ */
+#ifndef convert_energy_db
+LC3_HOT static void convert_energy_db(
+    const float *e, int n, float nf, int32_t *e_db)
+{
+    for (int i = 0; i < n; i++)
+        e_db[i] = lc3_db_q16(fmaxf(e[i] + nf, 1e-10f));
+}
+#endif /* convert_energy_db */
+
+/**
+ * Check the bit consumption estimation of a gain against the budget
+ * e_db            Energies in dB (Q16), by 4 MDCT blocks
+ * g_int           Gain index to check
+ * nbits           Number of bits available
+ * j0              Index of the last block to consider, narrowed when
+ *                 the gain does not fit, for the search of upper gains
+ * return          True when the estimation fits in the budget
+ *
+ * The contributions being positive, the accumulation stops as soon as
+ * the budget is exceeded.
+ */
+LC3_HOT static bool fit_gain(
+    const int32_t *e_db, int g_int, int nbits, int *j0)
+{
+    const int k_20_28 = 20.f/28 * 0x1p16f + 0.5f;
+    const int k_2u7 = 2.7f * 0x1p16f + 0.5f;
+    const int k_1u4 = 1.4f * 0x1p16f + 0.5f;
+
+    int gn = g_int * k_20_28;
+    int v = 0, v_max = nbits * k_1u4, j, j1;
+
+    for (j = *j0; j >= 0 && e_db[j] < gn; j--);
+
+    for (j1 = j; j >= 0 && v <= v_max; j--) {
+        int e_diff = e_db[j] - gn;
+
+        v += e_diff < 0 ? k_2u7 :
+             e_diff < 43 << 16 ?   e_diff + ( 7 << 16)
+                               : 2*e_diff - (36 << 16);
+    }
+
+    if (v <= v_max)
+        return true;
+
+    *j0 = j1;
+    return false;
+}
+
+/**
+ * Bit consumption estimation of a gain
+ * e_db, n4        Energies in dB (Q16), by 4 MDCT blocks, and count
+ * g_int           Gain index
+ * return          Estimated number of bits
+ */
+LC3_HOT static int estimate_nbits(const int32_t *e_db, int n4, int g_int)
+{
+    const int k_20_28 = 20.f/28 * 0x1p16f + 0.5f;
+    const int k_2u7 = 2.7f * 0x1p16f + 0.5f;
+    const int k_1u4 = 1.4f * 0x1p16f + 0.5f;
+
+    int gn = g_int * k_20_28;
+    int64_t v = 0;
+    int j;
+
+    for (j = n4 - 1; j >= 0 && e_db[j] < gn; j--);
+
+    for ( ; j >= 0; j--) {
+        int e_diff = e_db[j] - gn;
+
+        v += e_diff < 0 ? k_2u7 :
+             e_diff < 43 << 16 ?   e_diff + ( 7 << 16)
+                               : 2*e_diff - (36 << 16);
+    }
+
+    return (v + k_1u4 - 1) / k_1u4;
+}
+
 /**
  * Global Gain Estimation
  * dt, sr          Duration and samplerate of the frame
@@ -75,6 +191,7 @@ static float unquantize_gain(int g_int)
  * nbits_budget    Number of bits available coding the spectrum
  * nbits_off       Offset on the available bits, temporarily smoothed
  * g_off           Gain index offset
+ * g_idx_prev      Gain index of the previous frame, starting the search
  * reset_off       Return True when the nbits_off must be reset
  * g_min           Return lower bound of quantized gain value
  * return          The quantized gain value
@@ -82,10 +199,11 @@ static float unquantize_gain(int g_int)
 LC3_HOT static int estimate_gain(
     enum lc3_dt dt, enum lc3_srate sr, const float *x,
     int nbytes, int nbits_budget, float nbits_off, int g_off,
-    bool *reset_off, int *g_min)
+    int g_idx_prev, bool *reset_off, int *g_min)
 {
     int n4 = lc3_ne(dt, sr) / 4;
-    union { float f; int32_t q16; } e[LC3_MAX_NE / 4];
+    float e[LC3_MAX_NE / 4];
+    int32_t e_db[LC3_MAX_NE / 4];
 
     /* --- Signal adaptative noise floor --- */
 
@@ -117,58 +235,57 @@ LC3_HOT static int estimate_gain(
 
     /* --- Energy (dB) by 4 MDCT blocks --- */
 
-    float x2_max = 0;
-
-    for (int i = 0; i < n4; i++) {
-        float x0 = x[4*i + 0] * x[4*i + 0];
-        float x1 = x[4*i + 1] * x[4*i + 1];
-        float x2 = x[4*i + 2] * x[4*i + 2];
-        float x3 = x[4*i + 3] * x[4*i + 3];
-
-        x2_max = fmaxf(x2_max, x0);
-        x2_max = fmaxf(x2_max, x1);
-        x2_max = fmaxf(x2_max, x2);
-        x2_max = fmaxf(x2_max, x3);
-
-        e[i].f = x0 + x1 + x2 + x3;
-    }
+    float x2_max = compute_energy4(x, n4, e);
 
     float x_max = sqrtf(x2_max);
     float nf = lc3_hr(sr) ?
         lc3_ldexpf(x_max, -reg_bits) * lc3_exp2f(-low_bits) : 0;
 
-    for (int i = 0; i < n4; i++)
-        e[i].q16 = lc3_db_q16(fmaxf(e[i].f + nf, 1e-10f));
+    convert_energy_db(e, n4, nf, e_db);
 
-    /* --- Determine gain index --- */
+    /* --- Determine gain index ---
+     * The bit consumption estimation decreases with the gain, the smallest
+     * gain index fitting the budget does not depend on the starting point
+     * of the search. Start from the gain of the previous frame, and
+     * enclose the result by exponential steps before the bisection. */
 
     int nbits = nbits_budget + nbits_off + 0.5f;
-    int g_int = 255 - g_off;
+    int j0 = n4 - 1;
 
-    const int k_20_28 = 20.f/28 * 0x1p16f + 0.5f;
-    const int k_2u7 = 2.7f * 0x1p16f + 0.5f;
-    const int k_1u4 = 1.4f * 0x1p16f + 0.5f;
+    int g_lo = -g_off - 1, g_hi = 255 - g_off;
+    int g_int = LC3_CLIP(g_idx_prev - g_off, g_lo + 1, g_hi);
 
-    for (int i = 128, j, j0 = n4-1, j1 ; i > 0; i >>= 1) {
-        int gn = (g_int - i) * k_20_28;
-        int v = 0;
+    bool up = g_int < g_hi && !fit_gain(e_db, g_int, nbits, &j0);
 
-        for (j = j0; j >= 0 && e[j].q16 < gn; j--);
+    if (up)
+        g_lo = g_int;
+    else
+        g_hi = g_int;
 
-        for (j1 = j; j >= 0; j--) {
-            int e_diff = e[j].q16 - gn;
+    for (int i = 1; g_hi - g_lo > i; i <<= 1) {
+        int g = up ? g_lo + i : g_hi - i;
+        bool fit = fit_gain(e_db, g, nbits, &j0);
 
-            v += e_diff < 0 ? k_2u7 :
-                 e_diff < 43 << 16 ?   e_diff + ( 7 << 16)
-                                   : 2*e_diff - (36 << 16);
-        }
+        if (fit)
+            g_hi = g;
+        else
+            g_lo = g;
 
-        if (v > nbits * k_1u4)
-            j0 = j1;
+        if (fit == up)
+            break;
+    }
+
+    while (g_hi - g_lo > 1) {
+        int g = g_lo + ((g_hi - g_lo) >> 1);
+
+        if (fit_gain(e_db, g, nbits, &j0))
+            g_hi = g;
         else
-            g_int = g_int - i;
+            g_lo = g;
     }
 
+    g_int = g_hi;
+
     /* --- Limit gain index --- */
 
     float x_lim = lc3_hr(sr) ? 0x7fffp8f : 0x7fffp0f;
@@ -248,6 +365,7 @@ LC3_HOT static int adjust_gain(
  * x               Spectral coefficients, scaled as output
  * n               Return count of significants
  */
+#ifndef quantize
 LC3_HOT static void quantize(
     enum lc3_dt dt, enum lc3_srate sr, int g_int, float *x, int *n)
 {
@@ -266,6 +384,7 @@ LC3_HOT static void quantize(
              fabsf(x[i+1]) >= xq_min   ? ne : *n - 2;
     }
 }
+#endif /* quantize */
 
 /**
  * Spectrum quantization inverse
@@ -274,6 +393,7 @@ LC3_HOT static void quantize(
  * x, nq           Spectral quantized, and count of significants
  * return          Unquantized gain value
  */
+#ifndef unquantize
 LC3_HOT static float unquantize(
     enum lc3_dt dt, enum lc3_srate sr,
     int g_int, float *x, int nq)
@@ -289,6 +409,7 @@ LC3_HOT static float unquantize(
 
     return g;
 }
+#endif /* unquantize */
 
 
 /* ----------------------------------------------------------------------------
@@ -317,12 +438,15 @@ static bool resolve_modes(enum lc3_srate sr, int nbytes, bool *p_lsb_mode)
  * x               Spectral quantized coefficients
  * n               Count of significant coefficients, updated on truncation
  * nbits_budget    Truncate to stay in budget, when not zero
+ * p_nbits_trunc   Return the number of bits of the truncation, or NULL
  * p_lsb_mode      Return True when LSB's are not AC coded, or NULL
- * return          The number of bits coding the spectrum
+ * return          The number of bits coding the whole spectrum
+ *
+ * The whole spectrum and its truncation are counted in a single pass.
  */
 LC3_HOT static int compute_nbits(
-    enum lc3_dt dt, enum lc3_srate sr, int nbytes,
-    const float *x, int *n, int nbits_budget, bool *p_lsb_mode)
+    enum lc3_dt dt, enum lc3_srate sr, int nbytes, const float *x,
+    int *n, int nbits_budget, int *p_nbits_trunc, bool *p_lsb_mode)
 {
     bool lsb_mode, high_rate = resolve_modes(sr, nbytes, &lsb_mode);
     int ne = lc3_ne(dt, sr);
@@ -332,22 +456,22 @@ LC3_HOT static int compute_nbits(
     int nbits = 0, nbits_lsb = 0;
     uint8_t state = 0;
 
-    int nbits_end = 0;
-    int n_end = 0;
+    int nbits_end = 0, nbits_trunc = 0, nbits_lsb_trunc = 0;
+    int n_trunc = 0;
 
     nbits_budget = nbits_budget ? nbits_budget * 2048 : INT_MAX;
 
     for (int i = 0, h = 0; h < 2; h++) {
         const uint8_t (*lut_coeff)[4] = lc3_spectrum_lookup[high_rate][h];
 
-        for ( ; i < LC3_MIN(*n, (ne + 2) >> (1 - h))
-                && nbits <= nbits_budget; i += 2) {
+        for ( ; i < LC3_MIN(*n, (ne + 2) >> (1 - h)); i += 2) {
 
             float xq_off = lc3_hr(sr) ? 0.5f : 6.f/16;
             uint32_t a = fabsf(x[i+0]) + xq_off;
             uint32_t b = fabsf(x[i+1]) + xq_off;
 
             const uint8_t *lut = lut_coeff[state];
+            bool in_budget = nbits <= nbits_budget;
 
             /* --- Sign values --- */
 
@@ -386,27 +510,34 @@ LC3_HOT static int compute_nbits(
 
             /* --- Update state --- */
 
+            nbits_lsb_trunc = in_budget ? nbits_lsb : nbits_lsb_trunc;
+
             if (s && nbits <= nbits_budget) {
-                n_end = i + 2;
-                nbits_end = nbits;
+                n_trunc = i + 2;
+                nbits_trunc = nbits;
             }
 
+            nbits_end = s ? nbits : nbits_end;
+
             state = (state << 4) + (k > 1 ? 12 + k : 1 + (a + b) * (k + 1));
         }
     }
 
     /* --- Return --- */
 
-    *n = n_end;
+    *n = n_trunc;
 
     if (p_lsb_mode)
         *p_lsb_mode = lsb_mode &&
-            nbits_end + nbits_lsb * 2048 > nbits_budget;
+            nbits_trunc + nbits_lsb_trunc * 2048 > nbits_budget;
 
     if (nbits_budget >= INT_MAX)
-        nbits_end += nbits_lsb * 2048;
+        nbits_trunc += nbits_lsb * 2048;
+
+    if (p_nbits_trunc)
+        *p_nbits_trunc = (nbits_trunc + 2047) / 2048;
 
-    return (nbits_end + 2047) / 2048;
+    return (nbits_end + nbits_lsb * 2048 + 2047) / 2048;
 }
 
 /**
@@ -711,6 +842,7 @@ LC3_HOT static void get_lsb(lc3_bits_t *bits,
  * x, n            Spectral quantized, and count of significants
  * return          Noise factor (0 to 7)
  */
+#ifndef estimate_noise
 LC3_HOT static int estimate_noise(
     enum lc3_dt dt, enum lc3_bandwidth bw, bool hrmode, const float *x, int n)
 {
@@ -735,6 +867,7 @@ LC3_HOT static int estimate_noise(
 
     return LC3_CLIP(nf, 0, 7);
 }
+#endif /* estimate_noise */
 
 /**
  * Noise filling
@@ -814,6 +947,81 @@ static int get_nbits_ac(enum lc3_dt dt, enum lc3_srate sr, int nbytes)
         3 + lc3_hr(sr) + LC3_MIN((nbytes-1) / 160, 2);
 }
 
+/**
+ * Bit consumption of the side data
+ * dt, sr, nbytes  Duration, samplerate and size of the frame
+ * pitch, tns      Pitch present indication and TNS bistream data
+ * return          Bit consumption of the data, other than the spectrum
+ */
+static int get_nbits_side(enum lc3_dt dt, enum lc3_srate sr,
+    int nbytes, bool pitch, const lc3_tns_data_t *tns)
+{
+    const int nbits_gain = 8;
+    const int nbits_nf = 3;
+
+    return get_nbits_ac(dt, sr, nbytes) +
+        lc3_bwdet_get_nbits(sr) + lc3_ltpf_get_nbits(pitch) +
+        lc3_sns_get_nbits() + lc3_tns_get_nbits(tns) + nbits_gain + nbits_nf;
+}
+
+/**
+ * Size of the frame for a quality target
+ */
+int lc3_spec_estimate_nbytes(
+    enum lc3_dt dt, enum lc3_srate sr, enum lc3_bandwidth bw, bool pitch,
+    const lc3_tns_data_t *tns, const lc3_spec_analysis_t *spec,
+    const float *x, float quality, int min_nbytes, int max_nbytes)
+{
+    int n4 = lc3_ne(dt, sr) / 4;
+    int n4b = lc3_ne(dt, (enum lc3_srate)bw) / 4;
+    float e[LC3_MAX_NE / 4];
+    int32_t e_db[LC3_MAX_NE / 4];
+
+    /* --- Energy (dB) by 4 MDCT blocks --- */
+
+    compute_energy4(x, n4, e);
+
+    float e_sum = 0;
+    for (int i = 0; i < n4b; i++)
+        e_sum += e[i];
+
+    if (e_sum <= 0)
+        return min_nbytes;
+
+    convert_energy_db(e, n4, 0, e_db);
+
+    /* --- Gain of the quality target ---
+     * The reference level is the geometric mean of the energies, within
+     * the bandwidth, limited to 30 dB below the arithmetic mean. Tonal
+     * spectra, less masking than noise-like ones, get a lower reference.
+     * The quantization noise of a step `g` is taken as `g^2 / 12`, the
+     * gain index `g_int` gives a step of `10 ^ (g_int / 28)`. */
+
+    int32_t e_mean = lc3_db_q16(e_sum / n4b);
+    int32_t e_floor = e_mean - (30 << 16);
+    int64_t e_geo = 0;
+
+    for (int i = 0; i < n4b; i++)
+        e_geo += LC3_MAX(e_db[i], e_floor);
+    e_geo /= n4b;
+
+    float g_db = e_geo * 0x1p-16f - 6.02f + 10.8f - quality;
+    int g_int = (int)floorf(g_db * (28.f / 20));
+
+    /* --- Bits of the spectrum, corrected by the offset tracked on
+     *     the previous frames, then size of the frame --- */
+
+    int nbits = estimate_nbits(e_db, n4, g_int) - (int)spec->nbits_off;
+    int nbytes = min_nbytes;
+
+    for (int i = 0; i < 2; i++)
+        nbytes = LC3_CLIP(
+            (nbits + get_nbits_side(dt, sr, nbytes, pitch, tns) + 7) / 8,
+            min_nbytes, max_nbytes);
+
+    return nbytes;
+}
+
 /**
  * Spectrum analysis
  */
@@ -827,12 +1035,7 @@ void lc3_spec_analyze(
 
     /* --- Bit budget --- */
 
-    const int nbits_gain = 8;
-    const int nbits_nf = 3;
-
-    int nbits_budget = 8*nbytes - get_nbits_ac(dt, sr, nbytes) -
-        lc3_bwdet_get_nbits(sr) - lc3_ltpf_get_nbits(pitch) -
-        lc3_sns_get_nbits() - lc3_tns_get_nbits(tns) - nbits_gain - nbits_nf;
+    int nbits_budget = 8*nbytes - get_nbits_side(dt, sr, nbytes, pitch, tns);
 
     /* --- Global gain --- */
 
@@ -842,29 +1045,34 @@ void lc3_spec_analyze(
 
     int g_off = resolve_gain_offset(sr, nbytes);
 
-    int g_min, g_int = estimate_gain(dt, sr,
-        x, nbytes, nbits_budget, nbits_off, g_off, &reset_off, &g_min);
+    int g_min, g_int = estimate_gain(dt, sr, x, nbytes, nbits_budget,
+        nbits_off, g_off, spec->g_idx, &reset_off, &g_min);
+
+    spec->g_idx = g_off + g_int;
 
     /* --- Quantization --- */
 
     quantize(dt, sr, g_int, x, &side->nq);
 
-    int nbits = compute_nbits(dt, sr, nbytes, x, &side->nq, 0, NULL);
+    int nbits = compute_nbits(dt, sr, nbytes,
+        x, &side->nq, nbits_budget, NULL, &side->lsb_mode);
 
     spec->nbits_off = reset_off ? 0 : nbits_off;
     spec->nbits_spare = reset_off ? 0 : nbits_budget - nbits;
 
-    /* --- Adjust gain and requantize --- */
+    /* --- Adjust gain and requantize ---
+     * The truncation in budget is counted again only on requantization */
 
     int g_adj = adjust_gain(dt, sr,
         g_off + g_int, nbits, nbits_budget, g_off + g_min);
 
-    if (g_adj)
-        quantize(dt, sr, g_adj, x, &side->nq);
-
     side->g_idx = g_int + g_adj + g_off;
-    nbits = compute_nbits(dt, sr, nbytes,
-        x, &side->nq, nbits_budget, &side->lsb_mode);
+
+    if (g_adj) {
+        quantize(dt, sr, g_adj, x, &side->nq);
+        compute_nbits(dt, sr, nbytes,
+            x, &side->nq, nbits_budget, NULL, &side->lsb_mode);
+    }
 }
 
 /**
@@ -924,6 +1132,29 @@ int lc3_spec_get_side(lc3_bits_t *bits,
     return side->nq > ne ? (side->nq = ne), -1 : 0;
 }
 
+/**
+ * Get the noise factor
+ */
+int lc3_spec_get_noise_factor(lc3_bits_t *bits)
+{
+    return get_noise_factor(bits);
+}
+
+/**
+ * Rewrite the global gain index of a frame
+ */
+void lc3_spec_set_gain_index(enum lc3_dt dt, enum lc3_srate sr,
+    void *data, int nbytes, int g_idx)
+{
+    uint8_t *p = (uint8_t *)data + nbytes - 1;
+    int pos = lc3_bwdet_get_nbits(sr) + get_nbits_nq(dt, sr) + 1;
+
+    for (int i = pos; i < pos + 8; i++, g_idx >>= 1) {
+        uint8_t mask = 1 << (i & 7);
+        p[-(i >> 3)] = (p[-(i >> 3)] & ~mask) | (g_idx & 1) << (i & 7);
+    }
+}
+
 /**
  * Decode spectral coefficients
  */
@@ -40,6 +40,28 @@ typedef struct lc3_spec_side {
  *  Encoding
  * -------------------------------------------------------------------------- */
 
+/**
+ * Size of the frame for a quality target
+ * dt, sr, bw      Duration, samplerate and bandwidth of the frame
+ * pitch, tns      Pitch present indication and TNS bistream data
+ * spec            Context of analysis
+ * x               Spectral coefficients, shaped by SNS and TNS
+ * quality         Target signal to quantization noise ratio, in dB
+ * min_nbytes      Minimum size of the frame
+ * max_nbytes      Maximum size of the frame
+ * return          Size of the frame, in range `min_nbytes` to `max_nbytes`
+ *
+ * The signal level is the geometric mean of the energies, so that tonal
+ * spectra get a higher ratio than noise-like ones. The bit consumption is
+ * estimated at the gain meeting the target, as done by the global gain
+ * estimation. The noise floor of the high-resolution mode is not taken
+ * into account.
+ */
+int lc3_spec_estimate_nbytes(
+    enum lc3_dt dt, enum lc3_srate sr, enum lc3_bandwidth bw, bool pitch,
+    const lc3_tns_data_t *tns, const lc3_spec_analysis_t *spec,
+    const float *x, float quality, int min_nbytes, int max_nbytes);
+
 /**
  * Spectrum analysis
  * dt, sr, nbytes  Duration, samplerate and size of the frame
@@ -88,6 +110,29 @@ void lc3_spec_encode(lc3_bits_t *bits,
 int lc3_spec_get_side(lc3_bits_t *bits,
     enum lc3_dt dt, enum lc3_srate sr, lc3_spec_side_t *side);
 
+/**
+ * Get the noise factor
+ * bits            Bitstream context
+ * return          The noise factor (0 to 7)
+ *
+ * The noise factor follows the side data of the frame, and is read back
+ * by `lc3_spec_decode()`. It's used for the inspection of frames only.
+ */
+int lc3_spec_get_noise_factor(lc3_bits_t *bits);
+
+/**
+ * Rewrite the global gain index of a frame
+ * dt, sr          Duration and samplerate of the frame
+ * data, nbytes    The frame, rewritten in place, and its size in bytes
+ * g_idx           The new global gain index (0 to 255)
+ *
+ * The plain bits are written backward from the end of the frame, least
+ * significant bit first. The gain index follows the bandwidth, the number
+ * of coded coefficients and the LSB mode indications.
+ */
+void lc3_spec_set_gain_index(enum lc3_dt dt, enum lc3_srate sr,
+    void *data, int nbytes, int g_idx);
+
 /**
  * Decode spectral coefficients
  * bits            Bitstream context
@@ -0,0 +1,286 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if __ARM_NEON && __ARM_ARCH_ISA_A64 && \
+        !defined(TEST_ARM) && !defined(TEST_WASM) || defined(TEST_NEON)
+
+#ifndef TEST_NEON
+#include <arm_neon.h>
+#endif /* TEST_NEON */
+
+
+/**
+ * Import
+ */
+
+static float unquantize_gain(int);
+
+
+/**
+ * Energy by blocks of 4 coefficients
+ */
+#ifndef compute_energy4
+
+LC3_HOT static float neon_compute_energy4(const float *x, int n4, float *e)
+{
+    float32x4_t x2_max = vmovq_n_f32(0);
+    int i;
+
+    /* The coefficients are deinterleaved by 4 on load, so that the
+     * energy of the blocks are computed in the same order as the
+     * scalar version. */
+
+    for (i = 0; i + 4 <= n4; i += 4) {
+        float32x4x4_t v = vld4q_f32(x + 4*i);
+
+        float32x4_t x0 = vmulq_f32(v.val[0], v.val[0]);
+        float32x4_t x1 = vmulq_f32(v.val[1], v.val[1]);
+        float32x4_t x2 = vmulq_f32(v.val[2], v.val[2]);
+        float32x4_t x3 = vmulq_f32(v.val[3], v.val[3]);
+
+        x2_max = vmaxq_f32(x2_max,
+            vmaxq_f32(vmaxq_f32(x0, x1), vmaxq_f32(x2, x3)));
+
+        vst1q_f32(e + i, vaddq_f32(vaddq_f32(vaddq_f32(x0, x1), x2), x3));
+    }
+
+    float x2_max_f = vmaxvq_f32(x2_max);
+
+    for ( ; i < n4; i++) {
+        float x0 = x[4*i + 0] * x[4*i + 0];
+        float x1 = x[4*i + 1] * x[4*i + 1];
+        float x2 = x[4*i + 2] * x[4*i + 2];
+        float x3 = x[4*i + 3] * x[4*i + 3];
+
+        x2_max_f = fmaxf(x2_max_f, fmaxf(fmaxf(x0, x1), fmaxf(x2, x3)));
+
+        e[i] = x0 + x1 + x2 + x3;
+    }
+
+    return x2_max_f;
+}
+
+#ifndef TEST_NEON
+#define compute_energy4 neon_compute_energy4
+#endif
+
+#endif /* compute_energy4 */
+
+
+/**
+ * Convert energies to dB, in fixed Q16
+ */
+#ifndef convert_energy_db
+
+LC3_HOT static void neon_convert_energy_db(
+    const float *e, int n, float nf, int32_t *e_db)
+{
+    const uint16_t (*t)[2] = lc3_db_q16_table;
+    int i;
+
+    /* Same approximation as `lc3_db_q16()` :
+     * - The product by the exponent remains under 2^24, and is exact
+     *   as a floating point operation.
+     * - The interpolation term is the high part of the product of
+     *   two 16 bits unsigned values, that fits on 32 bits. */
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        float32x4_t x = vmaxq_f32(
+            vaddq_f32(vld1q_f32(e + i), vmovq_n_f32(nf)), vmovq_n_f32(1e-10f));
+        uint32x4_t u = vreinterpretq_u32_f32(vmulq_f32(x, x));
+
+        int32x4_t e2 = vsubq_s32(
+            vreinterpretq_s32_u32(vshrq_n_u32(u, 22)), vmovq_n_s32(2*127));
+        e2 = vcvtq_s32_f32(vmulq_n_f32(vcvtq_f32_s32(e2), 49321));
+
+        uint32_t hi[4], t0[4], t1[4];
+        vst1q_u32(hi, vandq_u32(vshrq_n_u32(u, 18), vmovq_n_u32(0x1f)));
+
+        for (int j = 0; j < 4; j++)
+            t0[j] = t[hi[j]][0], t1[j] = t[hi[j]][1];
+
+        uint32x4_t lo = vandq_u32(vshrq_n_u32(u, 2), vmovq_n_u32(0xffff));
+        uint32x4_t dy = vshrq_n_u32(vmulq_u32(vld1q_u32(t1), lo), 16);
+
+        vst1q_s32(e_db + i, vaddq_s32(e2,
+            vreinterpretq_s32_u32(vaddq_u32(vld1q_u32(t0), dy))));
+    }
+
+    for ( ; i < n; i++)
+        e_db[i] = lc3_db_q16(fmaxf(e[i] + nf, 1e-10f));
+}
+
+#ifndef TEST_NEON
+#define convert_energy_db neon_convert_energy_db
+#endif
+
+#endif /* convert_energy_db */
+
+
+/**
+ * Spectrum quantization
+ */
+#ifndef quantize
+
+LC3_HOT static void neon_quantize(
+    enum lc3_dt dt, enum lc3_srate sr, int g_int, float *x, int *n)
+{
+    float g_inv = unquantize_gain(-g_int);
+    float xq_min = lc3_hr(sr) ? 0.5f : 10.f/16;
+    int i, ne = lc3_ne(dt, sr);
+
+    const float32x4_t q_min = vmovq_n_f32(xq_min);
+
+    /* The count of significants ends on the last pair
+     * of coefficients with a significant value */
+
+    *n = 0;
+
+    for (i = 0; i + 4 <= ne; i += 4) {
+        float32x4_t xi = vmulq_n_f32(vld1q_f32(x + i), g_inv);
+        vst1q_f32(x + i, xi);
+
+        uint64x2_t m = vreinterpretq_u64_u32(vcgeq_f32(vabsq_f32(xi), q_min));
+
+        *n = vgetq_lane_u64(m, 1) ? i + 4 :
+             vgetq_lane_u64(m, 0) ? i + 2 : *n;
+    }
+
+    for ( ; i < ne; i += 2) {
+        x[i+0] *= g_inv;
+        x[i+1] *= g_inv;
+
+        *n = fabsf(x[i+0]) >= xq_min ||
+             fabsf(x[i+1]) >= xq_min   ? i + 2 : *n;
+    }
+}
+
+#ifndef TEST_NEON
+#define quantize neon_quantize
+#endif
+
+#endif /* quantize */
+
+
+/**
+ * Spectrum quantization inverse
+ */
+#ifndef unquantize
+
+LC3_HOT static float neon_unquantize(
+    enum lc3_dt dt, enum lc3_srate sr,
+    int g_int, float *x, int nq)
+{
+    float g = unquantize_gain(g_int);
+    int i, ne = lc3_ne(dt, sr);
+
+    for (i = 0; i + 4 <= nq; i += 4)
+        vst1q_f32(x + i, vmulq_n_f32(vld1q_f32(x + i), g));
+
+    for ( ; i < nq; i++)
+        x[i] = x[i] * g;
+
+    memset(x + nq, 0, (ne - nq) * sizeof(*x));
+
+    return g;
+}
+
+#ifndef TEST_NEON
+#define unquantize neon_unquantize
+#endif
+
+#endif /* unquantize */
+
+
+/**
+ * Estimate noise level
+ */
+#ifndef estimate_noise
+
+LC3_HOT static int neon_estimate_noise(
+    enum lc3_dt dt, enum lc3_bandwidth bw, bool hrmode, const float *x, int n)
+{
+    int bw_stop = lc3_ne(dt, (enum lc3_srate)LC3_MIN(bw, LC3_BANDWIDTH_FB));
+    int w = 1 + (dt >= LC3_DT_7M5) + (dt>= LC3_DT_10M);
+
+    float xq_lim = hrmode ? 0.5f : 10.f/16;
+    int i0 = 6 * (1 + dt) - w, ie = bw_stop + w;
+    int i, iq = LC3_MAX(LC3_MIN(n, bw_stop), i0);
+
+    /* --- Mask of zero quantized coefficients ---
+     * The coefficients before the start of the range are considered
+     * as significants, and the ones after the last significant as
+     * zeros. */
+
+    uint32_t z[LC3_MAX_NE + 4];
+
+    const float32x4_t q_lim = vmovq_n_f32(xq_lim);
+
+    for (i = i0 - 2*w; i < i0; i++)
+        z[i] = 0;
+
+    for ( ; i + 4 <= iq; i += 4)
+        vst1q_u32(z + i, vcltq_f32(vabsq_f32(vld1q_f32(x + i)), q_lim));
+
+    for ( ; i < iq; i++)
+        z[i] = -(uint32_t)(fabsf(x[i]) < xq_lim);
+
+    for ( ; i < ie; i++)
+        z[i] = -1;
+
+    /* --- Sum the middle of runs of zeros of length 2*w + 1 --- */
+
+    float32x4_t sum4 = vmovq_n_f32(0);
+    uint32x4_t ns4 = vmovq_n_u32(0);
+
+    for (i = i0; i + 4 <= ie; i += 4) {
+        uint32x4_t zi = vld1q_u32(z + i);
+
+        for (int k = 1; k <= 2*w; k++)
+            zi = vandq_u32(zi, vld1q_u32(z + i - k));
+
+        uint32x4_t xi = vreinterpretq_u32_f32(vabsq_f32(vld1q_f32(x + i - w)));
+        sum4 = vaddq_f32(sum4, vreinterpretq_f32_u32(vandq_u32(xi, zi)));
+        ns4 = vsubq_u32(ns4, zi);
+    }
+
+    float sum = vaddvq_f32(sum4);
+    int ns = vaddvq_u32(ns4);
+
+    for ( ; i < ie; i++) {
+        uint32_t zi = z[i];
+
+        for (int k = 1; k <= 2*w; k++)
+            zi &= z[i - k];
+
+        if (zi)
+            sum += fabsf(x[i - w]), ns++;
+    }
+
+    int nf = ns ? 8 - (int)((16 * sum) / ns + 0.5f) : 8;
+
+    return LC3_CLIP(nf, 0, 7);
+}
+
+#ifndef TEST_NEON
+#define estimate_noise neon_estimate_noise
+#endif
+
+#endif /* estimate_noise */
+
+#endif /* __ARM_NEON && __ARM_ARCH_ISA_A64 */
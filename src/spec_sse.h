@@ -0,0 +1,315 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if __SSE2__ && !defined(TEST_ARM) && !defined(TEST_NEON) && \
+        !defined(TEST_WASM) || defined(TEST_SSE)
+
+#ifndef TEST_SSE
+#include <emmintrin.h>
+#endif /* TEST_SSE */
+
+
+/**
+ * Import
+ */
+
+static float unquantize_gain(int);
+
+
+/**
+ * Energy by blocks of 4 coefficients
+ */
+#ifndef compute_energy4
+
+LC3_HOT static float sse_compute_energy4(const float *x, int n4, float *e)
+{
+    __m128 x2_max = _mm_setzero_ps();
+    int i;
+
+    /* The squared values of 4 blocks are transposed, so that the
+     * energy of the blocks are computed in the same order as the
+     * scalar version. */
+
+    for (i = 0; i + 4 <= n4; i += 4) {
+        __m128 x0 = _mm_loadu_ps(x + 4*i +  0);
+        __m128 x1 = _mm_loadu_ps(x + 4*i +  4);
+        __m128 x2 = _mm_loadu_ps(x + 4*i +  8);
+        __m128 x3 = _mm_loadu_ps(x + 4*i + 12);
+
+        x0 = _mm_mul_ps(x0, x0), x1 = _mm_mul_ps(x1, x1);
+        x2 = _mm_mul_ps(x2, x2), x3 = _mm_mul_ps(x3, x3);
+
+        x2_max = _mm_max_ps(x2_max,
+            _mm_max_ps(_mm_max_ps(x0, x1), _mm_max_ps(x2, x3)));
+
+        __m128 t0 = _mm_unpacklo_ps(x0, x1);
+        __m128 t1 = _mm_unpackhi_ps(x0, x1);
+        __m128 t2 = _mm_unpacklo_ps(x2, x3);
+        __m128 t3 = _mm_unpackhi_ps(x2, x3);
+
+        __m128 e0 = _mm_add_ps(_mm_movelh_ps(t0, t2), _mm_movehl_ps(t2, t0));
+        e0 = _mm_add_ps(e0, _mm_movelh_ps(t1, t3));
+        e0 = _mm_add_ps(e0, _mm_movehl_ps(t3, t1));
+
+        _mm_storeu_ps(e + i, e0);
+    }
+
+    float v[4];
+
+    _mm_storeu_ps(v, x2_max);
+    float x2_max_f = fmaxf(fmaxf(v[0], v[1]), fmaxf(v[2], v[3]));
+
+    for ( ; i < n4; i++) {
+        float x0 = x[4*i + 0] * x[4*i + 0];
+        float x1 = x[4*i + 1] * x[4*i + 1];
+        float x2 = x[4*i + 2] * x[4*i + 2];
+        float x3 = x[4*i + 3] * x[4*i + 3];
+
+        x2_max_f = fmaxf(x2_max_f, fmaxf(fmaxf(x0, x1), fmaxf(x2, x3)));
+
+        e[i] = x0 + x1 + x2 + x3;
+    }
+
+    return x2_max_f;
+}
+
+#ifndef TEST_SSE
+#define compute_energy4 sse_compute_energy4
+#endif
+
+#endif /* compute_energy4 */
+
+
+/**
+ * Convert energies to dB, in fixed Q16
+ */
+#ifndef convert_energy_db
+
+LC3_HOT static void sse_convert_energy_db(
+    const float *e, int n, float nf, int32_t *e_db)
+{
+    const uint16_t (*t)[2] = lc3_db_q16_table;
+
+    const __m128 e_min = _mm_set1_ps(1e-10f);
+    const __m128i mask_hi = _mm_set1_epi32(0x1f);
+    const __m128i mask_lo = _mm_set1_epi32(0xffff);
+    int i;
+
+    /* Same approximation as `lc3_db_q16()` :
+     * - The product by the exponent remains under 2^24, and is exact
+     *   as a floating point operation.
+     * - The interpolation term is the high part of a 16 bits
+     *   unsigned multiplication. */
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128 x = _mm_max_ps(_mm_add_ps(_mm_loadu_ps(e + i),
+                                         _mm_set1_ps(nf)), e_min);
+        __m128i u = _mm_castps_si128(_mm_mul_ps(x, x));
+
+        __m128i e2 = _mm_sub_epi32(
+            _mm_srli_epi32(u, 22), _mm_set1_epi32(2*127));
+        e2 = _mm_cvttps_epi32(
+            _mm_mul_ps(_mm_cvtepi32_ps(e2), _mm_set1_ps(49321)));
+
+        int32_t hi[4];
+        _mm_storeu_si128((__m128i *)hi,
+            _mm_and_si128(_mm_srli_epi32(u, 18), mask_hi));
+
+        __m128i t0 = _mm_setr_epi32(
+            t[hi[0]][0], t[hi[1]][0], t[hi[2]][0], t[hi[3]][0]);
+        __m128i t1 = _mm_setr_epi32(
+            t[hi[0]][1], t[hi[1]][1], t[hi[2]][1], t[hi[3]][1]);
+        __m128i lo = _mm_and_si128(_mm_srli_epi32(u, 2), mask_lo);
+
+        _mm_storeu_si128((__m128i *)(e_db + i),
+            _mm_add_epi32(_mm_add_epi32(e2, t0), _mm_mulhi_epu16(t1, lo)));
+    }
+
+    for ( ; i < n; i++)
+        e_db[i] = lc3_db_q16(fmaxf(e[i] + nf, 1e-10f));
+}
+
+#ifndef TEST_SSE
+#define convert_energy_db sse_convert_energy_db
+#endif
+
+#endif /* convert_energy_db */
+
+
+/**
+ * Spectrum quantization
+ */
+#ifndef quantize
+
+LC3_HOT static void sse_quantize(
+    enum lc3_dt dt, enum lc3_srate sr, int g_int, float *x, int *n)
+{
+    float g_inv = unquantize_gain(-g_int);
+    float xq_min = lc3_hr(sr) ? 0.5f : 10.f/16;
+    int i, ne = lc3_ne(dt, sr);
+
+    const __m128 g = _mm_set1_ps(g_inv);
+    const __m128 q_min = _mm_set1_ps(xq_min);
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(INT32_MAX));
+
+    /* The count of significants ends on the last pair
+     * of coefficients with a significant value */
+
+    *n = 0;
+
+    for (i = 0; i + 4 <= ne; i += 4) {
+        __m128 xi = _mm_mul_ps(_mm_loadu_ps(x + i), g);
+        _mm_storeu_ps(x + i, xi);
+
+        int m = _mm_movemask_ps(
+            _mm_cmpge_ps(_mm_and_ps(xi, abs_mask), q_min));
+
+        *n = m ? i + 2 + 2*(m >> 2 != 0) : *n;
+    }
+
+    for ( ; i < ne; i += 2) {
+        x[i+0] *= g_inv;
+        x[i+1] *= g_inv;
+
+        *n = fabsf(x[i+0]) >= xq_min ||
+             fabsf(x[i+1]) >= xq_min   ? i + 2 : *n;
+    }
+}
+
+#ifndef TEST_SSE
+#define quantize sse_quantize
+#endif
+
+#endif /* quantize */
+
+
+/**
+ * Spectrum quantization inverse
+ */
+#ifndef unquantize
+
+LC3_HOT static float sse_unquantize(
+    enum lc3_dt dt, enum lc3_srate sr,
+    int g_int, float *x, int nq)
+{
+    float g = unquantize_gain(g_int);
+    int i, ne = lc3_ne(dt, sr);
+
+    for (i = 0; i + 4 <= nq; i += 4)
+        _mm_storeu_ps(x + i, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_set1_ps(g)));
+
+    for ( ; i < nq; i++)
+        x[i] = x[i] * g;
+
+    memset(x + nq, 0, (ne - nq) * sizeof(*x));
+
+    return g;
+}
+
+#ifndef TEST_SSE
+#define unquantize sse_unquantize
+#endif
+
+#endif /* unquantize */
+
+
+/**
+ * Estimate noise level
+ */
+#ifndef estimate_noise
+
+LC3_HOT static int sse_estimate_noise(
+    enum lc3_dt dt, enum lc3_bandwidth bw, bool hrmode, const float *x, int n)
+{
+    int bw_stop = lc3_ne(dt, (enum lc3_srate)LC3_MIN(bw, LC3_BANDWIDTH_FB));
+    int w = 1 + (dt >= LC3_DT_7M5) + (dt>= LC3_DT_10M);
+
+    float xq_lim = hrmode ? 0.5f : 10.f/16;
+    int i0 = 6 * (1 + dt) - w, ie = bw_stop + w;
+    int i, iq = LC3_MAX(LC3_MIN(n, bw_stop), i0);
+
+    /* --- Mask of zero quantized coefficients ---
+     * The coefficients before the start of the range are considered
+     * as significants, and the ones after the last significant as
+     * zeros. */
+
+    int32_t z[LC3_MAX_NE + 4];
+
+    const __m128 q_lim = _mm_set1_ps(xq_lim);
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(INT32_MAX));
+
+    for (i = i0 - 2*w; i < i0; i++)
+        z[i] = 0;
+
+    for ( ; i + 4 <= iq; i += 4)
+        _mm_storeu_si128((__m128i *)(z + i), _mm_castps_si128(
+            _mm_cmplt_ps(_mm_and_ps(_mm_loadu_ps(x + i), abs_mask), q_lim)));
+
+    for ( ; i < iq; i++)
+        z[i] = -(fabsf(x[i]) < xq_lim);
+
+    for ( ; i < ie; i++)
+        z[i] = -1;
+
+    /* --- Sum the middle of runs of zeros of length 2*w + 1 --- */
+
+    __m128 sum4 = _mm_setzero_ps();
+    __m128i ns4 = _mm_setzero_si128();
+
+    for (i = i0; i + 4 <= ie; i += 4) {
+        __m128i zi = _mm_loadu_si128((const __m128i *)(z + i));
+
+        for (int k = 1; k <= 2*w; k++)
+            zi = _mm_and_si128(zi,
+                _mm_loadu_si128((const __m128i *)(z + i - k)));
+
+        __m128 xi = _mm_and_ps(_mm_loadu_ps(x + i - w), abs_mask);
+        sum4 = _mm_add_ps(sum4, _mm_and_ps(xi, _mm_castsi128_ps(zi)));
+        ns4 = _mm_sub_epi32(ns4, zi);
+    }
+
+    float v_sum[4]; int32_t v_ns[4];
+
+    _mm_storeu_ps(v_sum, sum4);
+    _mm_storeu_si128((__m128i *)v_ns, ns4);
+
+    float sum = (v_sum[0] + v_sum[1]) + (v_sum[2] + v_sum[3]);
+    int ns = (v_ns[0] + v_ns[1]) + (v_ns[2] + v_ns[3]);
+
+    for ( ; i < ie; i++) {
+        int zi = z[i];
+
+        for (int k = 1; k <= 2*w; k++)
+            zi &= z[i - k];
+
+        if (zi)
+            sum += fabsf(x[i - w]), ns++;
+    }
+
+    int nf = ns ? 8 - (int)((16 * sum) / ns + 0.5f) : 8;
+
+    return LC3_CLIP(nf, 0, 7);
+}
+
+#ifndef TEST_SSE
+#define estimate_noise sse_estimate_noise
+#endif
+
+#endif /* estimate_noise */
+
+#endif /* __SSE2__ */
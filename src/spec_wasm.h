@@ -0,0 +1,180 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if __wasm_simd128__ && !defined(TEST_ARM) && !defined(TEST_NEON) && \
+        !defined(TEST_SSE) || defined(TEST_WASM)
+
+#ifndef TEST_WASM
+#include <wasm_simd128.h>
+#endif /* TEST_WASM */
+
+
+/**
+ * Import
+ */
+
+static float unquantize_gain(int);
+
+
+/**
+ * Energy by blocks of 4 coefficients
+ */
+#ifndef compute_energy4
+
+LC3_HOT static float wasm_compute_energy4(const float *x, int n4, float *e)
+{
+    v128_t x2_max = wasm_f32x4_splat(0);
+    int i;
+
+    /* The groups of 4 blocks are transposed on load, so that the
+     * energy of the blocks are computed in the same order as the
+     * scalar version. */
+
+    for (i = 0; i + 4 <= n4; i += 4) {
+        v128_t a0 = wasm_v128_load(x + 4*i +  0);
+        v128_t a1 = wasm_v128_load(x + 4*i +  4);
+        v128_t a2 = wasm_v128_load(x + 4*i +  8);
+        v128_t a3 = wasm_v128_load(x + 4*i + 12);
+
+        v128_t t0 = wasm_i32x4_shuffle(a0, a1, 0, 4, 1, 5);
+        v128_t t1 = wasm_i32x4_shuffle(a0, a1, 2, 6, 3, 7);
+        v128_t t2 = wasm_i32x4_shuffle(a2, a3, 0, 4, 1, 5);
+        v128_t t3 = wasm_i32x4_shuffle(a2, a3, 2, 6, 3, 7);
+
+        v128_t x0 = wasm_i32x4_shuffle(t0, t2, 0, 1, 4, 5);
+        v128_t x1 = wasm_i32x4_shuffle(t0, t2, 2, 3, 6, 7);
+        v128_t x2 = wasm_i32x4_shuffle(t1, t3, 0, 1, 4, 5);
+        v128_t x3 = wasm_i32x4_shuffle(t1, t3, 2, 3, 6, 7);
+
+        x0 = wasm_f32x4_mul(x0, x0);
+        x1 = wasm_f32x4_mul(x1, x1);
+        x2 = wasm_f32x4_mul(x2, x2);
+        x3 = wasm_f32x4_mul(x3, x3);
+
+        x2_max = wasm_f32x4_max(x2_max, wasm_f32x4_max(
+            wasm_f32x4_max(x0, x1), wasm_f32x4_max(x2, x3)));
+
+        wasm_v128_store(e + i, wasm_f32x4_add(
+            wasm_f32x4_add(wasm_f32x4_add(x0, x1), x2), x3));
+    }
+
+    float x2_max_f = fmaxf(
+        fmaxf(wasm_f32x4_extract_lane(x2_max, 0),
+              wasm_f32x4_extract_lane(x2_max, 1)),
+        fmaxf(wasm_f32x4_extract_lane(x2_max, 2),
+              wasm_f32x4_extract_lane(x2_max, 3)) );
+
+    for ( ; i < n4; i++) {
+        float x0 = x[4*i + 0] * x[4*i + 0];
+        float x1 = x[4*i + 1] * x[4*i + 1];
+        float x2 = x[4*i + 2] * x[4*i + 2];
+        float x3 = x[4*i + 3] * x[4*i + 3];
+
+        x2_max_f = fmaxf(x2_max_f, fmaxf(fmaxf(x0, x1), fmaxf(x2, x3)));
+
+        e[i] = x0 + x1 + x2 + x3;
+    }
+
+    return x2_max_f;
+}
+
+#ifndef TEST_WASM
+#define compute_energy4 wasm_compute_energy4
+#endif
+
+#endif /* compute_energy4 */
+
+
+/**
+ * Spectrum quantization
+ */
+#ifndef quantize
+
+LC3_HOT static void wasm_quantize(
+    enum lc3_dt dt, enum lc3_srate sr, int g_int, float *x, int *n)
+{
+    float g_inv = unquantize_gain(-g_int);
+    float xq_min = lc3_hr(sr) ? 0.5f : 10.f/16;
+    int i, ne = lc3_ne(dt, sr);
+
+    const v128_t g = wasm_f32x4_splat(g_inv);
+    const v128_t q_min = wasm_f32x4_splat(xq_min);
+
+    /* The count of significants ends on the last pair
+     * of coefficients with a significant value */
+
+    *n = 0;
+
+    for (i = 0; i + 4 <= ne; i += 4) {
+        v128_t xi = wasm_f32x4_mul(wasm_v128_load(x + i), g);
+        wasm_v128_store(x + i, xi);
+
+        v128_t m = wasm_f32x4_ge(wasm_f32x4_abs(xi), q_min);
+
+        *n = wasm_i64x2_extract_lane(m, 1) ? i + 4 :
+             wasm_i64x2_extract_lane(m, 0) ? i + 2 : *n;
+    }
+
+    for ( ; i < ne; i += 2) {
+        x[i+0] *= g_inv;
+        x[i+1] *= g_inv;
+
+        *n = fabsf(x[i+0]) >= xq_min ||
+             fabsf(x[i+1]) >= xq_min   ? i + 2 : *n;
+    }
+}
+
+#ifndef TEST_WASM
+#define quantize wasm_quantize
+#endif
+
+#endif /* quantize */
+
+
+/**
+ * Spectrum quantization inverse
+ */
+#ifndef unquantize
+
+LC3_HOT static float wasm_unquantize(
+    enum lc3_dt dt, enum lc3_srate sr,
+    int g_int, float *x, int nq)
+{
+    float g = unquantize_gain(g_int);
+    int i, ne = lc3_ne(dt, sr);
+
+    const v128_t gv = wasm_f32x4_splat(g);
+
+    for (i = 0; i + 4 <= nq; i += 4)
+        wasm_v128_store(x + i, wasm_f32x4_mul(wasm_v128_load(x + i), gv));
+
+    for ( ; i < nq; i++)
+        x[i] = x[i] * g;
+
+    memset(x + nq, 0, (ne - nq) * sizeof(*x));
+
+    return g;
+}
+
+#ifndef TEST_WASM
+#define unquantize wasm_unquantize
+#endif
+
+#endif /* unquantize */
+
+#endif /* __wasm_simd128__ */
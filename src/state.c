@@ -0,0 +1,678 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include <lc3.h>
+
+#include "common.h"
+#include "tables.h"
+
+
+/**
+ * Serialized form
+ *
+ * The fields are packed in little endian order, following a header:
+ *
+ *   - The tag "LC3", followed by 'E' (encoder) or 'D' (decoder)
+ *   - The version of the form, and the flags `LC3_STATE_QUANTIZED`
+ *   - The frame duration, the sample rate and the PCM sample rate
+ *
+ * The fields that are derived from the setup of the encoder or decoder,
+ * and the buffers holding only the current frame, are left out.
+ * The histories of samples are given as 32 bits floats, or quantized on
+ * 16 bits, sharing an exponent.
+ */
+
+#define STATE_VERSION  1
+
+
+/* ----------------------------------------------------------------------------
+ *  Packing
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Packing context
+ * p, size         Buffer, and its size (NULL when only sizing)
+ * n               Count of bytes packed, or unpacked
+ * error           Unpacking out of the buffer
+ */
+
+struct pack {
+    uint8_t *p;
+    int size, n;
+    bool error;
+};
+
+/**
+ * Put / Get an unsigned value on `nbytes`
+ * pack            Packing context
+ * v, nbytes       Value, and count of bytes
+ * return          The value, 0 on error
+ */
+
+static void put_bytes(struct pack *pack, uint64_t v, int nbytes)
+{
+    for (int i = 0; i < nbytes; i++, pack->n++, v >>= 8)
+        if (pack->p && pack->n < pack->size)
+            pack->p[pack->n] = v & 0xff;
+}
+
+static uint64_t get_bytes(struct pack *pack, int nbytes)
+{
+    uint64_t v = 0;
+
+    if (pack->n + nbytes > pack->size) {
+        pack->error = true;
+        return 0;
+    }
+
+    for (int i = 0; i < nbytes; i++)
+        v |= (uint64_t)pack->p[pack->n++] << (8*i);
+
+    return v;
+}
+
+/**
+ * Put / Get signed values, and floats
+ * pack            Packing context
+ * v               Value to put
+ * return          Value got
+ *
+ * Getting an infinite or NaN float is an error.
+ */
+
+static void put_i16(struct pack *pack, int v)
+{
+    put_bytes(pack, (uint16_t)v, 2);
+}
+
+static void put_i32(struct pack *pack, int32_t v)
+{
+    put_bytes(pack, (uint32_t)v, 4);
+}
+
+static void put_i64(struct pack *pack, int64_t v)
+{
+    put_bytes(pack, (uint64_t)v, 8);
+}
+
+static void put_f32(struct pack *pack, float v)
+{
+    uint32_t u;
+
+    memcpy(&u, &v, sizeof(u));
+    put_bytes(pack, u, 4);
+}
+
+static int get_i16(struct pack *pack)
+{
+    return (int16_t)get_bytes(pack, 2);
+}
+
+static int32_t get_i32(struct pack *pack)
+{
+    return (int32_t)get_bytes(pack, 4);
+}
+
+static int64_t get_i64(struct pack *pack)
+{
+    return (int64_t)get_bytes(pack, 8);
+}
+
+static float get_f32(struct pack *pack)
+{
+    uint32_t u = get_bytes(pack, 4);
+    float v;
+
+    memcpy(&v, &u, sizeof(v));
+    pack->error |= (u & LC3_IEEE754_EXP_MASK) == LC3_IEEE754_EXP_MASK;
+
+    return v;
+}
+
+/**
+ * Put / Get a history of samples
+ * pack            Packing context
+ * x, n            Samples, and count
+ * quantized       Quantize on 16 bits, sharing an exponent
+ *
+ * The samples are scaled, so that the greatest magnitude fits on 16 bits.
+ * The shared exponent is bounded, so that the scale factors, and the
+ * unscaled samples, are normal floats. The scaling is a multiplication,
+ * that handles the denormal samples.
+ */
+
+#define HISTORY_EXP_MIN  (15 - 126)
+#define HISTORY_EXP_MAX   127
+
+static void put_history(struct pack *pack,
+    const float *x, int n, bool quantized)
+{
+    if (!quantized) {
+        for (int i = 0; i < n; i++)
+            put_f32(pack, x[i]);
+        return;
+    }
+
+    float m = 0;
+    for (int i = 0; i < n; i++)
+        m = LC3_MAX(m, LC3_ABS(x[i]));
+
+    int e = HISTORY_EXP_MIN;
+    if (m >= FLT_MIN) {
+        lc3_frexpf(m, &e);
+        e = LC3_CLIP(e, HISTORY_EXP_MIN, HISTORY_EXP_MAX);
+    }
+
+    put_bytes(pack, (uint8_t)(int8_t)e, 1);
+
+    float scale = lc3_ldexpf(1.f, 15 - e);
+
+    for (int i = 0; i < n; i++) {
+        float v = x[i] * scale;
+        put_i16(pack, LC3_SAT16((int32_t)(v >= 0 ? v + 0.5f : v - 0.5f)));
+    }
+}
+
+static void get_history(struct pack *pack,
+    float *x, int n, bool quantized)
+{
+    if (!quantized) {
+        for (int i = 0; i < n; i++)
+            x[i] = get_f32(pack);
+        return;
+    }
+
+    int e = (int8_t)get_bytes(pack, 1);
+    pack->error |= e < HISTORY_EXP_MIN;
+
+    float scale = lc3_ldexpf(1.f, e - 15);
+
+    for (int i = 0; i < n; i++)
+        x[i] = get_i16(pack) * scale;
+}
+
+/**
+ * Skip a history of samples, checking it
+ * pack            Packing context
+ * n               Count of samples
+ * quantized       The samples are quantized on 16 bits
+ */
+
+static void skip_history(struct pack *pack, int n, bool quantized)
+{
+    if (!quantized) {
+        for (int i = 0; i < n; i++)
+            get_f32(pack);
+        return;
+    }
+
+    int e = (int8_t)get_bytes(pack, 1);
+    pack->error |= e < HISTORY_EXP_MIN;
+
+    for (int i = 0; i < n; i++)
+        get_i16(pack);
+}
+
+/**
+ * Put / Get the header
+ * pack            Packing context
+ * kind            'E' for an encoder, 'D' for a decoder
+ * flags           Flags of the form
+ * dt, sr, sr_pcm  Frame duration, sample rate and PCM sample rate
+ * return          Get: 0 when the header matches, -1 otherwise
+ */
+
+static void put_header(struct pack *pack, int kind, int flags,
+    enum lc3_dt dt, enum lc3_srate sr, enum lc3_srate sr_pcm)
+{
+    put_bytes(pack, 'L', 1);
+    put_bytes(pack, 'C', 1);
+    put_bytes(pack, '3', 1);
+    put_bytes(pack, kind, 1);
+    put_bytes(pack, STATE_VERSION, 1);
+    put_bytes(pack, flags, 1);
+
+    put_bytes(pack, dt, 1);
+    put_bytes(pack, sr, 1);
+    put_bytes(pack, sr_pcm, 1);
+}
+
+static int get_header(struct pack *pack, int kind, int *flags,
+    enum lc3_dt dt, enum lc3_srate sr, enum lc3_srate sr_pcm)
+{
+    bool match =
+        get_bytes(pack, 1) == 'L'  && get_bytes(pack, 1) == 'C' &&
+        get_bytes(pack, 1) == '3'  && get_bytes(pack, 1) == (unsigned)kind &&
+        get_bytes(pack, 1) == STATE_VERSION;
+
+    *flags = get_bytes(pack, 1);
+
+    match = match && !(*flags & ~LC3_STATE_QUANTIZED) &&
+        get_bytes(pack, 1) == dt && get_bytes(pack, 1) == sr &&
+        get_bytes(pack, 1) == sr_pcm;
+
+    return match && !pack->error ? 0 : -1;
+}
+
+
+/* ----------------------------------------------------------------------------
+ *  Encoder
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Put / Get the spectral rate control state
+ * pack            Packing context
+ * spec            Spectral analysis state
+ */
+
+static void put_spec(struct pack *pack, const lc3_spec_analysis_t *spec)
+{
+    put_f32(pack, spec->nbits_off);
+    put_i16(pack, spec->nbits_spare);
+    put_i16(pack, spec->g_idx);
+}
+
+static void get_spec(struct pack *pack, lc3_spec_analysis_t *spec)
+{
+    spec->nbits_off = get_f32(pack);
+    spec->nbits_spare = get_i16(pack);
+    spec->g_idx = get_i16(pack);
+}
+
+/**
+ * Check the range of the spectral rate control state
+ * spec            Spectral analysis state
+ * return          True when the state is in range
+ *
+ * The offset on the available bits is smoothed within +/- 40 bits,
+ * the gain index is a global one, coded on 8 bits.
+ */
+
+static bool check_spec(const lc3_spec_analysis_t *spec)
+{
+    return LC3_ABS(spec->nbits_off) <= 40 &&
+        spec->g_idx >= 0 && spec->g_idx <= 255;
+}
+
+/**
+ * Put / Get the state of an encoder
+ * pack            Packing context
+ * encoder         Encoder state
+ * quantized       Quantize the histories
+ *
+ * The oldest samples of the LTPF buffers, dropped on the next frame,
+ * are left out.
+ */
+
+static void put_encoder(struct pack *pack,
+    const struct lc3_encoder *encoder, bool quantized)
+{
+    enum lc3_dt dt = encoder->dt;
+    enum lc3_srate sr_pcm = encoder->sr_pcm;
+    const lc3_ltpf_analysis_t *ltpf = &encoder->ltpf;
+
+    int z_12k8 = sizeof(ltpf->x_12k8) / sizeof(*ltpf->x_12k8);
+    int z_6k4 = sizeof(ltpf->x_6k4) / sizeof(*ltpf->x_6k4);
+    int n_12k8 = (1 + dt) * 32, n_6k4 = n_12k8 >> 1;
+
+    put_bytes(pack, (encoder->ltpf_bypass << 0) | (ltpf->track << 1) |
+                    (ltpf->active << 2), 1);
+
+    put_i32(pack, encoder->attdet.en1);
+    put_i32(pack, encoder->attdet.an1);
+    put_i16(pack, encoder->attdet.p_att);
+
+    put_i16(pack, ltpf->pitch);
+    put_f32(pack, ltpf->nc[0]);
+    put_f32(pack, ltpf->nc[1]);
+    put_i64(pack, ltpf->hp50.s1);
+    put_i64(pack, ltpf->hp50.s2);
+    put_i16(pack, ltpf->tc);
+
+    for (int i = n_12k8; i < z_12k8; i++)
+        put_i16(pack, ltpf->x_12k8[i]);
+
+    for (int i = n_6k4; i < z_6k4; i++)
+        put_i16(pack, ltpf->x_6k4[i]);
+
+    put_spec(pack, &encoder->spec);
+
+    const int16_t *xt = (const int16_t *)encoder->x + encoder->xt_off;
+    for (int i = -lc3_nt(sr_pcm); i < 0; i++)
+        put_i16(pack, xt[i]);
+
+    put_history(pack, encoder->x + encoder->xd_off,
+        lc3_nd(dt, sr_pcm), quantized);
+}
+
+static void get_encoder(struct pack *pack,
+    struct lc3_encoder *encoder, bool quantized)
+{
+    enum lc3_dt dt = encoder->dt;
+    enum lc3_srate sr_pcm = encoder->sr_pcm;
+    lc3_ltpf_analysis_t *ltpf = &encoder->ltpf;
+
+    int z_12k8 = sizeof(ltpf->x_12k8) / sizeof(*ltpf->x_12k8);
+    int z_6k4 = sizeof(ltpf->x_6k4) / sizeof(*ltpf->x_6k4);
+    int n_12k8 = (1 + dt) * 32, n_6k4 = n_12k8 >> 1;
+
+    int flags = get_bytes(pack, 1);
+    encoder->ltpf_bypass = (flags >> 0) & 1;
+    ltpf->track = (flags >> 1) & 1;
+    ltpf->active = (flags >> 2) & 1;
+    pack->error |= (flags >> 3) != 0;
+
+    encoder->attdet.en1 = get_i32(pack);
+    encoder->attdet.an1 = get_i32(pack);
+    encoder->attdet.p_att = get_i16(pack);
+
+    ltpf->pitch = get_i16(pack);
+    ltpf->nc[0] = get_f32(pack);
+    ltpf->nc[1] = get_f32(pack);
+    ltpf->hp50.s1 = get_i64(pack);
+    ltpf->hp50.s2 = get_i64(pack);
+    ltpf->tc = get_i16(pack);
+
+    for (int i = n_12k8; i < z_12k8; i++)
+        ltpf->x_12k8[i] = get_i16(pack);
+
+    for (int i = n_6k4; i < z_6k4; i++)
+        ltpf->x_6k4[i] = get_i16(pack);
+
+    get_spec(pack, &encoder->spec);
+
+    int16_t *xt = (int16_t *)encoder->x + encoder->xt_off;
+    for (int i = -lc3_nt(sr_pcm); i < 0; i++)
+        xt[i] = get_i16(pack);
+
+    get_history(pack, encoder->x + encoder->xd_off,
+        lc3_nd(dt, sr_pcm), quantized);
+}
+
+/**
+ * Check the range of the state of an encoder
+ * encoder         Encoder state
+ * return          True when the state is in range
+ *
+ * The attack block is one of the 4 blocks, or 3 on 7.5 ms frames, or 0.
+ * The LTPF pitch, in quarter of samples at 12.8 KHz, lies from a lag of
+ * 32 to 228 samples, 0 before the first detection. The index `tc` of the
+ * 6.4 KHz lag is taken within the 98 correlations.
+ */
+
+static bool check_encoder(const struct lc3_encoder *encoder)
+{
+    const lc3_attdet_analysis_t *attdet = &encoder->attdet;
+    const lc3_ltpf_analysis_t *ltpf = &encoder->ltpf;
+
+    int nblk = 4 - (encoder->dt == LC3_DT_7M5);
+
+    return attdet->en1 >= 0 && attdet->an1 >= 0 &&
+        attdet->p_att >= 0 && attdet->p_att <= nblk &&
+
+        (ltpf->pitch == 0 || (ltpf->pitch >= 4*32 &&
+                              ltpf->pitch <= 4*228 + 3)) &&
+        ltpf->tc >= 0 && ltpf->tc < 98 &&
+
+        check_spec(&encoder->spec);
+}
+
+/**
+ * Export the state of an encoder
+ */
+LC3_EXPORT int lc3_encoder_export(
+    const struct lc3_encoder *encoder, int flags, void *buffer, int size)
+{
+    if (!encoder || (flags & ~LC3_STATE_QUANTIZED))
+        return -1;
+
+    struct pack pack = { .p = buffer, .size = size };
+
+    put_header(&pack, 'E', flags,
+        encoder->dt, encoder->sr, encoder->sr_pcm);
+
+    put_encoder(&pack, encoder, flags & LC3_STATE_QUANTIZED);
+
+    return buffer && pack.n > size ? -1 : pack.n;
+}
+
+/**
+ * Import the state of an encoder
+ */
+LC3_EXPORT int lc3_encoder_import(
+    struct lc3_encoder *encoder, const void *buffer, int size)
+{
+    if (!encoder || !buffer)
+        return -1;
+
+    struct pack pack = { .p = (uint8_t *)buffer, .size = size };
+    int flags;
+
+    if (get_header(&pack, 'E', &flags,
+            encoder->dt, encoder->sr, encoder->sr_pcm) < 0)
+        return -1;
+
+    LC3_ENCODER_SNAPSHOT_MEM_T(10000, LC3_MAX_SRATE_HZ) snapshot;
+    lc3_encoder_snapshot(encoder, &snapshot);
+    bool ltpf_bypass = encoder->ltpf_bypass;
+
+    get_encoder(&pack, encoder, flags & LC3_STATE_QUANTIZED);
+
+    if (pack.error || pack.n != size || !check_encoder(encoder)) {
+        lc3_encoder_restore(encoder, &snapshot);
+        encoder->ltpf_bypass = ltpf_bypass;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/* ----------------------------------------------------------------------------
+ *  Decoder
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Put / Get the state of a decoder
+ * pack            Packing context
+ * decoder         Decoder state
+ * quantized       Quantize the histories
+ *
+ * The history ring buffer is put in chronological order, and got back
+ * as after the setup of the decoder. The output samples of the current
+ * frame, in the ring buffer, are left out.
+ */
+
+/**
+ * Check the range of the LTPF synthesis and PLC states
+ * sr              Samplerate of the decoder
+ * ltpf, plc       LTPF synthesis and PLC states
+ * return          True when the state is in range
+ *
+ * The LTPF pitch, in quarter of samples at the samplerate, is derived
+ * from a pitch index, giving lags from 32 to 228 samples at 12.8 KHz,
+ * or is 0 after the setup. The filter is not active in high-resolution
+ * mode. The gains of the filter coefficients are under 0.4.
+ */
+
+static bool check_ltpf_synthesis(
+    enum lc3_srate sr, const lc3_ltpf_synthesis_t *ltpf)
+{
+    int ns = lc3_ns(LC3_DT_10M, sr);
+    int pitch_min = (128 * ns + 64) / 128;
+    int pitch_max = (912 * ns + 64) / 128;
+
+    if (ltpf->active && (lc3_hr(sr) || ltpf->pitch < pitch_min))
+        return false;
+
+    if (ltpf->pitch < 0 || ltpf->pitch > pitch_max)
+        return false;
+
+    for (int i = 0; i < (int)(sizeof(ltpf->c) / sizeof(float)); i++)
+        if (LC3_ABS(ltpf->c[i]) > 1)
+            return false;
+
+    return true;
+}
+
+static bool check_plc(const lc3_plc_state_t *plc)
+{
+    return plc->count >= 1 && plc->alpha >= 0 && plc->alpha <= 1;
+}
+
+static void put_decoder(struct pack *pack,
+    const struct lc3_decoder *decoder, bool quantized)
+{
+    enum lc3_dt dt = decoder->dt;
+    enum lc3_srate sr = decoder->sr;
+    enum lc3_srate sr_pcm = decoder->sr_pcm;
+    int nh = lc3_nh(dt, sr_pcm), ns = lc3_ns(dt, sr_pcm);
+
+    put_bytes(pack, decoder->ltpf.active, 1);
+    put_i16(pack, decoder->ltpf.pitch);
+
+    for (int i = 0; i < (int)(sizeof(decoder->ltpf.c) / sizeof(float)); i++)
+        put_f32(pack, decoder->ltpf.c[i]);
+
+    for (int i = 0; i < (int)(sizeof(decoder->ltpf.x) / sizeof(float)); i++)
+        put_f32(pack, decoder->ltpf.x[i]);
+
+    put_bytes(pack, decoder->plc.seed, 2);
+    put_i16(pack, LC3_MIN(decoder->plc.count, INT16_MAX));
+    put_f32(pack, decoder->plc.alpha);
+
+    const float *xh = decoder->x + decoder->xh_off;
+    int i0 = decoder->xs_off - decoder->xh_off + ns;
+    float x[LC3_NH(7500, 48000)];
+
+    for (int i = 0; i < nh; i++)
+        x[i] = xh[(i0 + i) % (nh + ns)];
+
+    put_history(pack, x, nh, quantized);
+
+    put_history(pack, decoder->x + decoder->xd_off,
+        lc3_nd(dt, sr_pcm), quantized);
+
+    put_history(pack, decoder->x + decoder->xg_off,
+        lc3_ne(dt, sr), quantized);
+}
+
+static void get_decoder(struct pack *pack,
+    struct lc3_decoder *decoder, bool quantized)
+{
+    enum lc3_dt dt = decoder->dt;
+    enum lc3_srate sr = decoder->sr;
+    enum lc3_srate sr_pcm = decoder->sr_pcm;
+    int nh = lc3_nh(dt, sr_pcm);
+
+    /* --- LTPF and PLC states, checked before being set --- */
+
+    lc3_ltpf_synthesis_t ltpf;
+    lc3_plc_state_t plc;
+
+    int active = get_bytes(pack, 1);
+    ltpf.active = active;
+    ltpf.pitch = get_i16(pack);
+
+    for (int i = 0; i < (int)(sizeof(ltpf.c) / sizeof(float)); i++)
+        ltpf.c[i] = get_f32(pack);
+
+    for (int i = 0; i < (int)(sizeof(ltpf.x) / sizeof(float)); i++)
+        ltpf.x[i] = get_f32(pack);
+
+    plc.seed = get_bytes(pack, 2);
+    plc.count = get_i16(pack);
+    plc.alpha = get_f32(pack);
+
+    struct pack histories = *pack;
+
+    skip_history(&histories, nh, quantized);
+    skip_history(&histories, lc3_nd(dt, sr_pcm), quantized);
+    skip_history(&histories, lc3_ne(dt, sr), quantized);
+
+    pack->error |= histories.error || active > 1 ||
+        !check_ltpf_synthesis(sr, &ltpf) || !check_plc(&plc);
+
+    if (pack->error)
+        return;
+
+    decoder->ltpf = ltpf;
+    decoder->plc = plc;
+
+    /* --- Histories --- */
+
+    decoder->xs_off = decoder->xh_off + nh;
+
+    get_history(pack, decoder->x + decoder->xh_off, nh, quantized);
+
+    get_history(pack, decoder->x + decoder->xd_off,
+        lc3_nd(dt, sr_pcm), quantized);
+
+    get_history(pack, decoder->x + decoder->xg_off,
+        lc3_ne(dt, sr), quantized);
+}
+
+/**
+ * Export the state of a decoder
+ */
+LC3_EXPORT int lc3_decoder_export(
+    const struct lc3_decoder *decoder, int flags, void *buffer, int size)
+{
+    if (!decoder || (flags & ~LC3_STATE_QUANTIZED))
+        return -1;
+
+    struct pack pack = { .p = buffer, .size = size };
+
+    put_header(&pack, 'D', flags,
+        decoder->dt, decoder->sr, decoder->sr_pcm);
+
+    put_decoder(&pack, decoder, flags & LC3_STATE_QUANTIZED);
+
+    return buffer && pack.n > size ? -1 : pack.n;
+}
+
+/**
+ * Import the state of a decoder
+ */
+LC3_EXPORT int lc3_decoder_import(
+    struct lc3_decoder *decoder, const void *buffer, int size)
+{
+    if (!decoder || !buffer)
+        return -1;
+
+    struct pack pack = { .p = (uint8_t *)buffer, .size = size };
+    int flags;
+
+    if (get_header(&pack, 'D', &flags,
+            decoder->dt, decoder->sr, decoder->sr_pcm) < 0)
+        return -1;
+
+    struct pack sizing = { 0 };
+
+    put_header(&sizing, 'D', flags,
+        decoder->dt, decoder->sr, decoder->sr_pcm);
+
+    put_decoder(&sizing, decoder, flags & LC3_STATE_QUANTIZED);
+
+    if (sizing.n != size)
+        return -1;
+
+    get_decoder(&pack, decoder, flags & LC3_STATE_QUANTIZED);
+
+    return pack.error ? -1 : 0;
+}
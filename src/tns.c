@@ -19,6 +19,9 @@
 #include "tns.h"
 #include "tables.h"
 
+#include "tns_sse.h"
+#include "tns_neon.h"
+
 
 /* ----------------------------------------------------------------------------
  *  Filter Coefficients
@@ -49,6 +52,21 @@ LC3_HOT static inline float dot(const float *a, const float *b, int n)
     return v;
 }
 
+/**
+ * Autocorrelation of a vector
+ * x, n            The vector of size `n`
+ * maxorder        Maximum lag of the autocorrelation, 4 or 8
+ * r               Output the `maxorder + 1` autocorrelation values
+ */
+#ifndef autocorrelate
+LC3_HOT static void autocorrelate(
+    const float *x, int n, int maxorder, float *r)
+{
+    for (int k = 0; k <= maxorder; k++)
+        r[k] = dot(x, x + k, n - k);
+}
+#endif /* autocorrelate */
+
 /**
  * LPC Coefficients
  * dt, bw          Duration and bandwidth of the frame
@@ -128,27 +146,25 @@ LC3_HOT static void compute_lpc_coeffs(
     float r[2][9];
 
     for (int f = 0; f < nfilters; f++) {
-        float c[9][3] = { 0 };
+        float c[3][9];
 
         for (int s = 0; s < nsubdivisions; s++) {
             xs = xe, xe = x + *(++sub);
-
-            for (int k = 0; k <= maxorder; k++)
-                c[k][s] = dot(xs, xs + k, (xe - xs) - k);
+            autocorrelate(xs, xe - xs, maxorder, c[s]);
         }
 
         r[f][0] = nsubdivisions;
         if (nsubdivisions == 2) {
-            float e0 = c[0][0], e1 = c[0][1];
+            float e0 = c[0][0], e1 = c[1][0];
             for (int k = 1; k <= maxorder; k++)
                 r[f][k] = e0 == 0 || e1 == 0 ? 0 :
-                  (c[k][0]/e0 + c[k][1]/e1) * lag_window[k];
+                  (c[0][k]/e0 + c[1][k]/e1) * lag_window[k];
 
         } else {
-            float e0 = c[0][0], e1 = c[0][1], e2 = c[0][2];
+            float e0 = c[0][0], e1 = c[1][0], e2 = c[2][0];
             for (int k = 1; k <= maxorder; k++)
                 r[f][k] = e0 == 0 || e1 == 0 || e2 == 0 ? 0 :
-                  (c[k][0]/e0 + c[k][1]/e1 + c[k][2]/e2) * lag_window[k];
+                  (c[0][k]/e0 + c[1][k]/e1 + c[2][k]/e2) * lag_window[k];
         }
     }
 
@@ -298,6 +314,7 @@ static void unquantize_rc(const int *rc_q, int order, float rc[8])
  * rc_order, rc    Order of coefficients, and coefficients
  * x               Spectral coefficients, filtered as output
  */
+#ifndef forward_filtering
 LC3_HOT static void forward_filtering(
     enum lc3_dt dt, enum lc3_bandwidth bw,
     const int rc_order[2], float (* const rc)[8], float *x)
@@ -333,6 +350,7 @@ LC3_HOT static void forward_filtering(
         }
     }
 }
+#endif /* forward_filtering */
 
 /**
  * Inverse filtering
@@ -356,14 +374,18 @@ LC3_HOT static void inverse_filtering(
         i0 = ie;
         ie = nf * (1 + f);
 
-        if (!rc_order[f])
+        int order = rc_order[f];
+        if (!order)
             continue;
 
+        /* The stages above the order of the filter have null coefficients,
+         * and leave the output unchanged, they are simply skipped. */
+
         for (int i = i0; i < ie; i++) {
             float xi = x[i];
 
-            xi -= s[7] * rc[f][7];
-            for (int k = 6; k >= 0; k--) {
+            xi -= s[order-1] * rc[f][order-1];
+            for (int k = order-2; k >= 0; k--) {
                 xi -= s[k] * rc[f][k];
                 s[k+1] = s[k] + rc[f][k] * xi;
             }
@@ -371,11 +393,78 @@ LC3_HOT static void inverse_filtering(
             x[i] = xi;
         }
 
-        for (int k = 7; k >= rc_order[f]; k--)
+        for (int k = 7; k >= order; k--)
             s[k] = 0;
     }
 }
 
+/**
+ * Inverse filtering, and spectral shaping
+ * dt, sr, bw      Duration, samplerate and bandwidth of the frame
+ * rc_order, rc    Order of coefficients, and unquantized coefficients
+ * g               Gains of the shaping bands
+ * x, y            Spectral coefficients, and shaped ones as output
+ *
+ * The coefficients are filtered then shaped in a single pass, band by
+ * band. The bands, or parts of bands, out of an active filter are only
+ * scaled. `x` and `y` can be the same buffer.
+ */
+LC3_HOT static void inverse_filtering_shaping(
+    enum lc3_dt dt, enum lc3_srate sr, enum lc3_bandwidth bw,
+    const int rc_order[2], float (* const rc)[8],
+    const float *g, const float *x, float *y)
+{
+    int nfilters = 1 + (dt >= LC3_DT_5M && bw >= LC3_BANDWIDTH_SWB);
+    int nf = lc3_ne(dt, (enum lc3_srate)LC3_MIN(bw, LC3_BANDWIDTH_FB))
+                >> (nfilters - 1);
+
+    const int *lim = lc3_band_lim[dt][sr];
+    int nb = lc3_num_bands[dt][sr];
+
+    float s[8] = { 0 };
+    int f = -1, order = 0, ie = 3*(1 + dt);
+
+    for (int i = 0, ib = 0; ib < nb; ib++) {
+        float g_sns = g[ib];
+
+        while (i < lim[ib+1]) {
+
+            /* --- Switch to the next filter --- */
+
+            if (i >= ie) {
+                for (int k = 7; k >= order; k--)
+                    s[k] = 0;
+
+                f++;
+                order = f < nfilters ? rc_order[f] : 0;
+                ie = f < nfilters ? nf * (1 + f) : INT_MAX;
+            }
+
+            int n = LC3_MIN(lim[ib+1], ie);
+
+            /* --- Filtering and shaping --- */
+
+            if (!order) {
+                for ( ; i < n; i++)
+                    y[i] = x[i] * g_sns;
+                continue;
+            }
+
+            for ( ; i < n; i++) {
+                float xi = x[i];
+
+                xi -= s[order-1] * rc[f][order-1];
+                for (int k = order-2; k >= 0; k--) {
+                    xi -= s[k] * rc[f][k];
+                    s[k+1] = s[k] + rc[f][k] * xi;
+                }
+                s[0] = xi;
+                y[i] = xi * g_sns;
+            }
+        }
+    }
+}
+
 
 /* ----------------------------------------------------------------------------
  *  Interface
@@ -421,6 +510,14 @@ void lc3_tns_analyze(enum lc3_dt dt, enum lc3_bandwidth bw,
     forward_filtering(dt, bw, data->rc_order, rc, x);
 }
 
+/**
+ * Resize the bitstream data
+ */
+void lc3_tns_resize(enum lc3_dt dt, int nbytes, lc3_tns_data_t *data)
+{
+    data->lpc_weighting = resolve_lpc_weighting(dt, nbytes);
+}
+
 /**
  * TNS synthesis
  */
@@ -436,6 +533,23 @@ void lc3_tns_synthesize(enum lc3_dt dt, enum lc3_bandwidth bw,
     inverse_filtering(dt, bw, data->rc_order, rc, x);
 }
 
+/**
+ * TNS synthesis, and spectral shaping
+ */
+void lc3_tns_synthesize_shaped(
+    enum lc3_dt dt, enum lc3_srate sr, enum lc3_bandwidth bw,
+    const struct lc3_tns_data *data, const float *g,
+    const float *x, float *y)
+{
+    float rc[2][8] = { 0 };
+
+    for (int f = 0; f < data->nfilters; f++)
+        if (data->rc_order[f])
+            unquantize_rc(data->rc[f], data->rc_order[f], rc[f]);
+
+    inverse_filtering_shaping(dt, sr, bw, data->rc_order, rc, g, x, y);
+}
+
 /**
  * Bit consumption of bitstream data
  */
@@ -50,6 +50,16 @@ typedef struct lc3_tns_data {
 void lc3_tns_analyze(enum lc3_dt dt, enum lc3_bandwidth bw,
     bool nn_flag, int nbytes, lc3_tns_data_t *data, float *x);
 
+/**
+ * Resize the bitstream data
+ * dt, nbytes      Duration and size of the frame
+ * data            Bitstream data, analyzed for another size
+ *
+ * The coding of the filter orders depends on the size of the frame,
+ * the LPC weighting indication is resolved as done by the decoder.
+ */
+void lc3_tns_resize(enum lc3_dt dt, int nbytes, lc3_tns_data_t *data);
+
 /**
  * Return number of bits coding the data
  * data            Bitstream data
@@ -89,5 +99,22 @@ int lc3_tns_get_data(lc3_bits_t *bits,
 void lc3_tns_synthesize(enum lc3_dt dt, enum lc3_bandwidth bw,
     const lc3_tns_data_t *data, float *x);
 
+/**
+ * TNS synthesis, and spectral shaping
+ * dt, sr, bw      Duration, samplerate and bandwidth of the frame
+ * data            Bitstream data
+ * g               Gains of the SNS bands, see `lc3_sns_synthesize_gains()`
+ * x               Spectral coefficients
+ * y               Return filtered and shaped coefficients
+ *
+ * This is equivalent to `lc3_tns_synthesize()` followed by the SNS
+ * synthesis shaping, done in a single pass over the spectrum.
+ * `x` and `y` can be the same buffer
+ */
+void lc3_tns_synthesize_shaped(
+    enum lc3_dt dt, enum lc3_srate sr, enum lc3_bandwidth bw,
+    const lc3_tns_data_t *data, const float *g,
+    const float *x, float *y);
+
 
 #endif /* __LC3_TNS_H */
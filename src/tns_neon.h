@@ -0,0 +1,146 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if __ARM_NEON && __ARM_ARCH_ISA_A64 && \
+        !defined(TEST_ARM) && !defined(TEST_WASM) || defined(TEST_NEON)
+
+#ifndef TEST_NEON
+#include <arm_neon.h>
+#endif /* TEST_NEON */
+
+
+/**
+ * Autocorrelation of a vector
+ */
+#ifndef autocorrelate
+
+LC3_HOT static inline void neon_autocorrelate_k(
+    const float *x, int n, const int maxorder, float *r)
+{
+    float32x4_t c[9];
+    int i = 0;
+
+    for (int k = 0; k <= maxorder; k++)
+        c[k] = vmovq_n_f32(0);
+
+    for ( ; i + 4 + maxorder <= n; i += 4) {
+        float32x4_t x0 = vld1q_f32(x + i);
+
+        for (int k = 0; k <= maxorder; k++)
+            c[k] = vfmaq_f32(c[k], x0, vld1q_f32(x + i + k));
+    }
+
+    for (int k = 0; k <= maxorder; k++) {
+        r[k] = vaddvq_f32(c[k]);
+
+        for (int j = i; j < n - k; j++)
+            r[k] += x[j] * x[j + k];
+    }
+}
+
+LC3_HOT static void neon_autocorrelate(
+    const float *x, int n, int maxorder, float *r)
+{
+    if (maxorder <= 4)
+        neon_autocorrelate_k(x, n, 4, r);
+    else
+        neon_autocorrelate_k(x, n, 8, r);
+}
+
+#ifndef TEST_NEON
+#define autocorrelate neon_autocorrelate
+#endif
+
+#endif /* autocorrelate */
+
+
+/**
+ * Forward filtering
+ */
+#ifndef forward_filtering
+
+LC3_HOT static void neon_forward_filtering(
+    enum lc3_dt dt, enum lc3_bandwidth bw,
+    const int rc_order[2], float (* const rc)[8], float *x)
+{
+    int nfilters = 1 + (dt >= LC3_DT_5M && bw >= LC3_BANDWIDTH_SWB);
+    int nf = lc3_ne(dt, (enum lc3_srate)LC3_MIN(bw, LC3_BANDWIDTH_FB))
+                >> (nfilters - 1);
+    int i0, ie = 3*(1 + dt);
+
+    float s[8] = { 0 };
+
+    for (int f = 0; f < nfilters; f++) {
+
+        i0 = ie;
+        ie = nf * (1 + f);
+
+        if (!rc_order[f])
+            continue;
+
+        /* The lattice is run over blocks of 4 samples, the backward
+         * predictions delayed by one sample are rebuilt from the block
+         * of the previous iteration, kept for each stage. */
+
+        int order = rc_order[f], i = i0;
+        float32x4_t bp[8];
+
+        for (int k = 0; k < order; k++)
+            bp[k] = vmovq_n_f32(s[k]);
+
+        for ( ; i + 4 <= ie; i += 4) {
+            float32x4_t fi = vld1q_f32(x + i), bi = fi;
+
+            for (int k = 0; k < order; k++) {
+                float32x4_t bs = vextq_f32(bp[k], bi, 3);
+                bp[k] = bi;
+
+                bi = vfmaq_n_f32(bs, fi, rc[f][k]);
+                fi = vfmaq_n_f32(fi, bs, rc[f][k]);
+            }
+
+            vst1q_f32(x + i, fi);
+        }
+
+        for (int k = 0; k < order; k++)
+            s[k] = vgetq_lane_f32(bp[k], 3);
+
+        for ( ; i < ie; i++) {
+            float xi = x[i];
+            float s0, s1 = xi;
+
+            for (int k = 0; k < order; k++) {
+                s0 = s[k];
+                s[k] = s1;
+
+                s1  = rc[f][k] * xi + s0;
+                xi += rc[f][k] * s0;
+            }
+
+            x[i] = xi;
+        }
+    }
+}
+
+#ifndef TEST_NEON
+#define forward_filtering neon_forward_filtering
+#endif
+
+#endif /* forward_filtering */
+
+#endif /* __ARM_NEON && __ARM_ARCH_ISA_A64 */
@@ -0,0 +1,156 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if __SSE2__ && !defined(TEST_ARM) && !defined(TEST_NEON) && \
+        !defined(TEST_WASM) || defined(TEST_SSE)
+
+#ifndef TEST_SSE
+#include <emmintrin.h>
+#endif /* TEST_SSE */
+
+
+/**
+ * Autocorrelation of a vector
+ */
+#ifndef autocorrelate
+
+LC3_HOT static inline void sse_autocorrelate_k(
+    const float *x, int n, const int maxorder, float *r)
+{
+    __m128 c[9];
+    int i = 0;
+
+    for (int k = 0; k <= maxorder; k++)
+        c[k] = _mm_setzero_ps();
+
+    for ( ; i + 4 + maxorder <= n; i += 4) {
+        __m128 x0 = _mm_loadu_ps(x + i);
+
+        for (int k = 0; k <= maxorder; k++)
+            c[k] = _mm_add_ps(c[k], _mm_mul_ps(x0, _mm_loadu_ps(x + i + k)));
+    }
+
+    for (int k = 0; k <= maxorder; k++) {
+        float v[4];
+
+        _mm_storeu_ps(v, c[k]);
+        r[k] = (v[0] + v[1]) + (v[2] + v[3]);
+
+        for (int j = i; j < n - k; j++)
+            r[k] += x[j] * x[j + k];
+    }
+}
+
+LC3_HOT static void sse_autocorrelate(
+    const float *x, int n, int maxorder, float *r)
+{
+    if (maxorder <= 4)
+        sse_autocorrelate_k(x, n, 4, r);
+    else
+        sse_autocorrelate_k(x, n, 8, r);
+}
+
+#ifndef TEST_SSE
+#define autocorrelate sse_autocorrelate
+#endif
+
+#endif /* autocorrelate */
+
+
+/**
+ * Forward filtering
+ */
+#ifndef forward_filtering
+
+LC3_HOT static void sse_forward_filtering(
+    enum lc3_dt dt, enum lc3_bandwidth bw,
+    const int rc_order[2], float (* const rc)[8], float *x)
+{
+    int nfilters = 1 + (dt >= LC3_DT_5M && bw >= LC3_BANDWIDTH_SWB);
+    int nf = lc3_ne(dt, (enum lc3_srate)LC3_MIN(bw, LC3_BANDWIDTH_FB))
+                >> (nfilters - 1);
+    int i0, ie = 3*(1 + dt);
+
+    float s[8] = { 0 };
+
+    for (int f = 0; f < nfilters; f++) {
+
+        i0 = ie;
+        ie = nf * (1 + f);
+
+        if (!rc_order[f])
+            continue;
+
+        /* The lattice is run over blocks of 4 samples, the backward
+         * predictions delayed by one sample are rebuilt from the block
+         * of the previous iteration, kept for each stage. */
+
+        int order = rc_order[f], i = i0;
+        __m128 bp[8];
+
+        for (int k = 0; k < order; k++)
+            bp[k] = _mm_set1_ps(s[k]);
+
+        for ( ; i + 4 <= ie; i += 4) {
+            __m128 fi = _mm_loadu_ps(x + i), bi = fi;
+
+            for (int k = 0; k < order; k++) {
+                __m128 rck = _mm_set1_ps(rc[f][k]);
+
+                __m128 bs = _mm_shuffle_ps(bp[k], bi, _MM_SHUFFLE(1, 0, 3, 3));
+                bs = _mm_shuffle_ps(bs, bi, _MM_SHUFFLE(2, 1, 2, 0));
+                bp[k] = bi;
+
+                bi = _mm_add_ps(_mm_mul_ps(rck, fi), bs);
+                fi = _mm_add_ps(fi, _mm_mul_ps(rck, bs));
+            }
+
+            _mm_storeu_ps(x + i, fi);
+        }
+
+        for (int k = 0; k < order; k++) {
+            float v[4];
+
+            _mm_storeu_ps(v, bp[k]);
+            s[k] = v[3];
+        }
+
+        for ( ; i < ie; i++) {
+            float xi = x[i];
+            float s0, s1 = xi;
+
+            for (int k = 0; k < order; k++) {
+                s0 = s[k];
+                s[k] = s1;
+
+                s1  = rc[f][k] * xi + s0;
+                xi += rc[f][k] * s0;
+            }
+
+            x[i] = xi;
+        }
+    }
+}
+
+#ifndef TEST_SSE
+#define forward_filtering sse_forward_filtering
+#endif
+
+#endif /* forward_filtering */
+
+#endif /* __SSE2__ */
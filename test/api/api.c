@@ -0,0 +1,144 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "api.h"
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+const struct config configs[] = {
+    { false,  2500,  8000 }, { false,  2500, 16000 }, { false,  2500, 24000 },
+    { false,  2500, 32000 }, { false,  2500, 48000 },
+    { false,  5000,  8000 }, { false,  5000, 16000 }, { false,  5000, 24000 },
+    { false,  5000, 32000 }, { false,  5000, 48000 },
+    { false,  7500,  8000 }, { false,  7500, 16000 }, { false,  7500, 24000 },
+    { false,  7500, 32000 }, { false,  7500, 48000 },
+    { false, 10000,  8000 }, { false, 10000, 16000 }, { false, 10000, 24000 },
+    { false, 10000, 32000 }, { false, 10000, 48000 },
+
+    { true ,  2500, 48000 }, { true ,  2500, 96000 },
+    { true ,  5000, 48000 }, { true ,  5000, 96000 },
+    { true , 10000, 48000 }, { true , 10000, 96000 },
+};
+
+const int num_configs = sizeof(configs) / sizeof(*configs);
+
+/**
+ * Generate the test signal
+ */
+void generate_signal(int sr_hz, int16_t *x, int n)
+{
+    const float pi = 3.14159265f;
+
+    float phase = 0;
+    uint32_t seed = 1;
+
+    for (int i = 0; i < n; i++) {
+        float t = (float)i / sr_hz;
+
+        /* --- Harmonics of a gliding pitch, by syllables --- */
+
+        float f0 = 140 + 60 * sinf(2 * pi * 0.7f * t);
+        float env = fmaxf(sinf(2 * pi * 3 * t), 0);
+
+        phase += 2 * pi * f0 / sr_hz;
+        if (phase > 2 * pi)
+            phase -= 2 * pi;
+
+        float v = 0;
+        for (int k = 1; k <= 24 && k * f0 < 0.45f * sr_hz; k++)
+            v += sinf(k * phase) / k;
+
+        v *= env;
+
+        /* --- Bursts of noise and clicks --- */
+
+        seed = seed * 1664525 + 1013904223;
+        float noise = (float)(int32_t)seed / 0x1p31f;
+
+        if (fmodf(t, 0.35f) < 0.04f)
+            v += 0.5f * noise;
+
+        if (i % (sr_hz / 4) < sr_hz / 1000)
+            v += 0.8f * (1 - (float)(i % (sr_hz / 4)) / (sr_hz / 1000));
+
+        x[i] = (int16_t)lrintf(fmaxf(fminf(0.4f * v, 1), -1) * 32767);
+    }
+}
+
+/**
+ * Signal to noise ratio of a signal against a reference
+ */
+double snr(const float *ref, const float *x, int n)
+{
+    double se = 0, ne = 0;
+
+    for (int i = 0; i < n; i++) {
+        double r = ref[i], d = (double)x[i] - r;
+        se += r * r, ne += d * d;
+    }
+
+    return ne > 0 ? 10 * log10(se / ne) : (double)INFINITY;
+}
+
+/**
+ * Report a failure of a check
+ */
+int fail(const struct config *config, const char *fmt, ...)
+{
+    va_list ap;
+
+    if (config)
+        fprintf(stderr, "\n  [%s%d us, %d Hz] ", config->hrmode ? "HR, " : "",
+            config->dt_us, config->sr_hz);
+    else
+        fprintf(stderr, "\n  ");
+
+    va_start(ap, fmt);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+
+    return -1;
+}
+
+/**
+ * Run a check on the test signal of each configuration
+ */
+int for_each_config(int (*check)(const struct config *, const int16_t *))
+{
+    int ret = 0;
+
+    for (int i = 0; i < num_configs; i++) {
+        const struct config *config = configs + i;
+
+        int ns = lc3_hr_frame_samples(
+            config->hrmode, config->dt_us, config->sr_hz);
+
+        int16_t *x = malloc(NUM_FRAMES * ns * sizeof(*x));
+        generate_signal(config->sr_hz, x, NUM_FRAMES * ns);
+
+        ret = check(config, x) || ret;
+
+        free(x);
+    }
+
+    return ret ? -1 : 0;
+}
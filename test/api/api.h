@@ -0,0 +1,81 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#ifndef __API_H
+#define __API_H
+
+#include <lc3.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/**
+ * Configurations of the codec
+ * hrmode          High-Resolution mode
+ * dt_us, sr_hz    Frame duration and samplerate
+ */
+struct config {
+    bool hrmode;
+    int dt_us, sr_hz;
+};
+
+extern const struct config configs[];
+extern const int num_configs;
+
+/**
+ * Number of frames encoded by configuration
+ */
+#define NUM_FRAMES  100
+
+/**
+ * Generate the test signal
+ * sr_hz           Samplerate of the signal
+ * x, n            Output `n` samples, from the start of the signal
+ *
+ * The signal mixes the harmonics of a gliding pitch, shaped by syllables,
+ * with bursts of noise and clicks. It's deterministic, so that bitstreams
+ * of independent runs can be compared.
+ */
+void generate_signal(int sr_hz, int16_t *x, int n);
+
+/**
+ * Signal to noise ratio of a signal against a reference
+ * ref, x, n       Reference and signal to check, of `n` samples
+ * return          The ratio in dB, `INFINITY` when identical
+ */
+double snr(const float *ref, const float *x, int n);
+
+/**
+ * Report a failure of a check
+ * config          The configuration, or NULL
+ * fmt, ...        Formatted description of the failure
+ * return          -1
+ */
+int fail(const struct config *config, const char *fmt, ...);
+
+/**
+ * Run a check on the test signal of each configuration
+ * check           Check of a configuration, on `NUM_FRAMES` frames of
+ *                 the test signal, returning 0 when Ok
+ * return          0: All the checks are Ok  -1: Failure
+ */
+int for_each_config(int (*check)(const struct config *, const int16_t *));
+
+
+#endif /* __API_H */
@@ -0,0 +1,207 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "api.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * Size of the packets buffers
+ */
+#define MAX_PACKET_BYTES  (LC3_HR_MAX_FRAME_BYTES + 256)
+
+/**
+ * Check that a frame has been output
+ * y, n            Output samples of the frame, filled by `0x7fff` before
+ * return          True when the samples have been written
+ */
+static bool is_output(const int16_t *y, int n)
+{
+    for (int i = 0; i < n; i++)
+        if (y[i] != 0x7fff)
+            return true;
+
+    return false;
+}
+
+/**
+ * Check the decoding of a packet
+ * config          Configuration
+ * decoder         Decoder
+ * in, size        Packet, NULL when lost
+ * next, next_size Next packet, NULL when not available
+ * expected        Expected return of the decoding
+ * y               Output samples of the frame
+ * return          0: Ok  -1: Failure
+ */
+static int check_decode(const struct config *config, lc3_decoder_t decoder,
+    const uint8_t *in, int size, const uint8_t *next, int next_size,
+    int expected, int16_t *y)
+{
+    int ns = lc3_hr_frame_samples(
+        config->hrmode, config->dt_us, config->sr_hz);
+
+    for (int i = 0; i < ns; i++)
+        y[i] = 0x7fff;
+
+    int ret = lc3_decode_fec(decoder,
+        in, size, next, next_size, LC3_PCM_FORMAT_S16, y, 1);
+
+    if (ret != expected)
+        return fail(config, "decoding returns %d, %d expected", ret, expected);
+
+    if (!is_output(y, ns))
+        return fail(config, "no samples output");
+
+    return 0;
+}
+
+/**
+ * Check the packet loss recovery of a configuration
+ * config          Configuration
+ * x               Input signal of `NUM_FRAMES` frames
+ * return          0: Ok  -1: Failure
+ *
+ * In each group of 10 packets, the 4th is lost, and recovered from the
+ * next packet. The 7th and 8th are lost; the 7th is concealed, and the
+ * 8th recovered. The 10th packet gets a corrupted size trailer.
+ */
+static int check_config(const struct config *config, const int16_t *x)
+{
+    bool hr = config->hrmode;
+    int dt_us = config->dt_us, sr_hz = config->sr_hz;
+    int ns = lc3_hr_frame_samples(hr, dt_us, sr_hz);
+
+    int min_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, 0);
+    int max_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, INT_MAX);
+    int nbytes = 3 * min_nbytes < max_nbytes ? 3 * min_nbytes : max_nbytes;
+    int fec_nbytes = min_nbytes;
+
+    /* --- Encode the packets --- */
+
+    void *enc_mem = malloc(lc3_hr_encoder_size(hr, dt_us, sr_hz));
+    lc3_encoder_t encoder =
+        lc3_hr_setup_encoder(hr, dt_us, sr_hz, sr_hz, enc_mem);
+
+    lc3_fec_encoder_t fec;
+    lc3_setup_fec_encoder(&fec);
+
+    uint8_t (*packets)[MAX_PACKET_BYTES] =
+        malloc(NUM_FRAMES * sizeof(*packets));
+    int size[NUM_FRAMES], ret = 0;
+
+    if (lc3_encode_fec(encoder, NULL, LC3_PCM_FORMAT_S16,
+            x, 1, nbytes, fec_nbytes, packets[0]) != -1)
+        ret = fail(config, "encoding accepted without redundant copy state");
+
+    for (int i = 0; ret == 0 && i < NUM_FRAMES; i++) {
+        size[i] = lc3_encode_fec(encoder, &fec, LC3_PCM_FORMAT_S16,
+            x + i * ns, 1, nbytes, fec_nbytes, packets[i]);
+
+        if (size[i] != nbytes + (i > 0 ? fec_nbytes : 0) + 1)
+            ret = fail(config, "packet %d of %d bytes", i, size[i]);
+    }
+
+    free(enc_mem);
+
+    /* --- Decode with losses --- */
+
+    void *dec_mem = malloc(lc3_hr_decoder_size(hr, dt_us, sr_hz));
+    lc3_decoder_t decoder =
+        lc3_hr_setup_decoder(hr, dt_us, sr_hz, sr_hz, dec_mem);
+
+    int16_t *y = malloc(ns * sizeof(*y));
+
+    for (int i = 0; ret == 0 && i < NUM_FRAMES - 1; i++) {
+        const uint8_t *in = packets[i], *next = packets[i+1];
+        int next_size = size[i+1];
+
+        switch (i % 10) {
+
+        case 3: case 7:
+            ret = check_decode(config, decoder,
+                NULL, 0, next, next_size, 2, y);
+            break;
+
+        case 6:
+            ret = check_decode(config, decoder,
+                NULL, 0, NULL, 0, 1, y);
+            break;
+
+        case 9: {
+            uint8_t corrupted[MAX_PACKET_BYTES];
+            memcpy(corrupted, in, size[i]);
+
+            /* Frames too small, then too large, then lost without copy */
+
+            if (size[i] - min_nbytes <= UINT8_MAX) {
+                corrupted[size[i]-1] = size[i] - min_nbytes;
+                ret = check_decode(config, decoder,
+                    corrupted, size[i], NULL, 0, 1, y);
+            }
+
+            corrupted[size[i]-1] = 0;
+            if (ret == 0 && size[i] - 1 > max_nbytes)
+                ret = check_decode(config, decoder,
+                    corrupted, size[i], NULL, 0, 1, y);
+
+            /* Redundant copy of size under the minimum */
+
+            memcpy(corrupted, next, next_size);
+            for (int n = 1; ret == 0 && n < min_nbytes; n++) {
+                corrupted[next_size-1] = n;
+                ret = check_decode(config, decoder,
+                    NULL, 0, corrupted, next_size, 1, y);
+            }
+
+            /* Redundant copy larger than the packet */
+
+            corrupted[next_size-1] = next_size - min_nbytes;
+            if (ret == 0 && next_size - min_nbytes <= UINT8_MAX)
+                ret = check_decode(config, decoder,
+                    NULL, 0, corrupted, next_size, 1, y);
+
+        } break;
+
+        default:
+            ret = check_decode(config, decoder,
+                in, size[i], next, next_size, 0, y);
+            break;
+        }
+
+        if (ret < 0)
+            fail(config, "packet %d", i);
+    }
+
+    free(dec_mem);
+    free(packets);
+    free(y);
+
+    return ret;
+}
+
+/**
+ * Check the packet loss recovery
+ */
+int check_fec(void)
+{
+    return for_each_config(check_config);
+}
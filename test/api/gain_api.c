@@ -0,0 +1,195 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "api.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * Gain applied to the frames, as an exact count of steps of 20/28 dB
+ */
+#define GAIN_DB  -5.f
+
+/**
+ * Check the clamping of the gain of a frame
+ * config          Configuration
+ * frame, nbytes   The frame, and its size in bytes
+ * return          0: Ok  -1: Failure
+ *
+ * The frame is rewritten with the extreme gains, reaching the bounds of
+ * the range of the global gain index, from 1 to 255.
+ */
+static int check_clamping(
+    const struct config *config, const uint8_t *frame, int nbytes)
+{
+    bool hr = config->hrmode;
+    int dt_us = config->dt_us, sr_hz = config->sr_hz;
+
+    struct lc3_frame_info info;
+    lc3_hr_frame_inspect(hr, dt_us, sr_hz, frame, nbytes, &info);
+    int g_idx = info.global_gain;
+
+    static const struct { float gain_db; int g_idx; } bounds[] = {
+        { 1000.f, 255 }, { -1000.f, 1 } };
+
+    for (int i = 0; i < (int)(sizeof(bounds) / sizeof(*bounds)); i++) {
+        uint8_t clamped[LC3_HR_MAX_FRAME_BYTES];
+        float applied_db;
+
+        memcpy(clamped, frame, nbytes);
+
+        int ret = lc3_hr_frame_apply_gain(hr, dt_us, sr_hz,
+            clamped, nbytes, bounds[i].gain_db, &applied_db);
+
+        float expected_db = (bounds[i].g_idx - g_idx) * (20.f/28);
+
+        if (ret != 1 || fabsf(applied_db - expected_db) > 1e-3f)
+            return fail(config, "gain of %g dB, clamped with return %d "
+                "and %g dB applied", (double)bounds[i].gain_db,
+                ret, (double)applied_db);
+
+        if (lc3_hr_frame_inspect(
+                hr, dt_us, sr_hz, clamped, nbytes, &info) < 0 ||
+                info.global_gain != bounds[i].g_idx)
+            return fail(config, "gain of %g dB, global gain "
+                "not clamped to %d", (double)bounds[i].gain_db,
+                bounds[i].g_idx);
+    }
+
+    return 0;
+}
+
+/**
+ * Check the gain control of a configuration
+ * config          Configuration
+ * x               Input signal of `NUM_FRAMES` frames
+ * return          0: Ok  -1: Failure
+ *
+ * The frames are decoded as encoded, and after the gain is applied. The
+ * second decoded signal shall be the first one, scaled by the gain.
+ * The clamping of the gain is checked on each frame, and the frames of
+ * silence of the signal, coded with the null global gain index, shall be
+ * left unchanged.
+ */
+static int check_config(const struct config *config, const int16_t *x)
+{
+    bool hr = config->hrmode;
+    int dt_us = config->dt_us, sr_hz = config->sr_hz;
+    int ns = lc3_hr_frame_samples(hr, dt_us, sr_hz);
+
+    int min_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, 0);
+    int max_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, INT_MAX);
+
+    void *encoder_mem = malloc(lc3_hr_encoder_size(hr, dt_us, sr_hz));
+    void *ref_mem = malloc(lc3_hr_decoder_size(hr, dt_us, sr_hz));
+    void *gain_mem = malloc(lc3_hr_decoder_size(hr, dt_us, sr_hz));
+
+    lc3_encoder_t encoder =
+        lc3_hr_setup_encoder(hr, dt_us, sr_hz, sr_hz, encoder_mem);
+    lc3_decoder_t ref_decoder =
+        lc3_hr_setup_decoder(hr, dt_us, sr_hz, sr_hz, ref_mem);
+    lc3_decoder_t gain_decoder =
+        lc3_hr_setup_decoder(hr, dt_us, sr_hz, sr_hz, gain_mem);
+
+    float *y_ref = malloc(NUM_FRAMES * ns * sizeof(float));
+    float *y_gain = malloc(NUM_FRAMES * ns * sizeof(float));
+
+    int nsilences = 0;
+    int ret = 0;
+
+    /* --- Encoding, and decoding with and without the gain --- */
+
+    for (int i = 0; ret == 0 && i < NUM_FRAMES; i++) {
+        uint8_t frame[LC3_HR_MAX_FRAME_BYTES], ref[LC3_HR_MAX_FRAME_BYTES];
+        struct lc3_frame_info info;
+        float applied_db;
+
+        int nbytes = min_nbytes + (i * 37) % (max_nbytes - min_nbytes + 1);
+
+        lc3_encode(encoder, LC3_PCM_FORMAT_S16, x + i * ns, 1, nbytes, frame);
+        lc3_decode(ref_decoder, frame, nbytes,
+            LC3_PCM_FORMAT_FLOAT, y_ref + i * ns, 1);
+
+        memcpy(ref, frame, nbytes);
+
+        if (lc3_hr_frame_inspect(
+                hr, dt_us, sr_hz, frame, nbytes, &info) < 0) {
+            ret = fail(config, "frame %d not inspected", i);
+            break;
+        }
+
+        bool silence = info.global_gain == 0;
+        nsilences += silence;
+
+        if (!silence)
+            ret = check_clamping(config, frame, nbytes);
+
+        int r = lc3_hr_frame_apply_gain(hr, dt_us, sr_hz,
+            frame, nbytes, GAIN_DB, &applied_db);
+
+        if (ret == 0 && silence &&
+                (r != 1 || applied_db != 0 || memcmp(frame, ref, nbytes)))
+            ret = fail(config, "frame %d of silence changed "
+                "by the gain", i);
+
+        if (ret == 0 && !silence && (r != 0 || applied_db != GAIN_DB))
+            ret = fail(config, "frame %d, gain of %g dB applied "
+                "with return %d and %g dB", i, (double)GAIN_DB,
+                r, (double)applied_db);
+
+        lc3_decode(gain_decoder, frame, nbytes,
+            LC3_PCM_FORMAT_FLOAT, y_gain + i * ns, 1);
+    }
+
+    if (ret == 0 && (nsilences == 0 || nsilences == NUM_FRAMES))
+        ret = fail(config, "%d frames of silence", nsilences);
+
+    /* --- Scaling of the decoded signal --- */
+
+    if (ret == 0) {
+        float g = powf(10.f, GAIN_DB / 20);
+
+        for (int i = 0; i < NUM_FRAMES * ns; i++)
+            y_ref[i] *= g;
+
+        double q = snr(y_ref, y_gain, NUM_FRAMES * ns);
+        if (q < 100)
+            ret = fail(config, "decoding not scaled by the gain, "
+                "SNR of %.1f dB", q);
+    }
+
+    free(encoder_mem);
+    free(ref_mem);
+    free(gain_mem);
+    free(y_ref);
+    free(y_gain);
+
+    return ret;
+}
+
+/**
+ * Check the gain control in the compressed domain
+ */
+int check_gain(void)
+{
+    return for_each_config(check_config);
+}
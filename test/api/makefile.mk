@@ -0,0 +1,39 @@
+#
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at:
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+
+test_api_src += \
+    $(TEST_DIR)/api/test_api.c \
+    $(TEST_DIR)/api/api.c \
+    $(TEST_DIR)/api/fec_api.c \
+    $(TEST_DIR)/api/gain_api.c \
+    $(TEST_DIR)/api/multi_api.c \
+    $(TEST_DIR)/api/pool_api.c \
+    $(TEST_DIR)/api/rc_api.c \
+    $(TEST_DIR)/api/snapshot_api.c \
+    $(TEST_DIR)/api/state_api.c \
+    $(TEST_DIR)/api/vbr_api.c
+
+test_api_ldlibs += lc3 m
+test_api_dependencies += liblc3
+
+$(eval $(call add-bin,test_api))
+
+test_api: $(test_api_bin)
+	@echo "  RUN     $(notdir $<)"
+	$(V)LD_LIBRARY_PATH=$(BIN_DIR) $<
+
+test: test_api
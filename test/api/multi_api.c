@@ -0,0 +1,115 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "api.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * Check the renditions of a configuration, against independent encoders
+ * config          Configuration, giving the samplerate of the input
+ * x               Input signal of `NUM_FRAMES` frames
+ * return          0: Ok  -1: Failure
+ */
+static int check_renditions(const struct config *config, const int16_t *x)
+{
+    static const int srates[] = { 8000, 16000, 24000, 32000, 48000, 96000 };
+
+    bool hr = config->hrmode;
+    int dt_us = config->dt_us, sr_pcm_hz = config->sr_hz;
+    int ns = lc3_hr_frame_samples(hr, dt_us, sr_pcm_hz);
+
+    /* --- Renditions of each samplerate, and 2 sizes at the highest --- */
+
+    int nr = 0, sr_hz[LC3_MAX_RENDITIONS], nbytes[LC3_MAX_RENDITIONS];
+
+    for (int i = 0; i < (int)(sizeof(srates) / sizeof(*srates)); i++)
+        if (LC3_HR_CHECK_SR_HZ(hr, srates[i]) && srates[i] <= sr_pcm_hz) {
+            sr_hz[nr] = srates[i];
+            nbytes[nr++] = lc3_hr_frame_bytes(
+                hr, dt_us, srates[i], 2 * srates[i]);
+        }
+
+    sr_hz[nr] = sr_pcm_hz;
+    nbytes[nr++] = lc3_hr_frame_bytes(hr, dt_us, sr_pcm_hz, sr_pcm_hz);
+
+    /* --- Setup the encoders --- */
+
+    void *multi_mem = malloc(lc3_hr_multi_encoder_size(hr, dt_us, sr_pcm_hz));
+    lc3_multi_encoder_t multi = lc3_hr_setup_multi_encoder(
+        hr, dt_us, sr_pcm_hz, nr, sr_hz, multi_mem);
+
+    void *mem[LC3_MAX_RENDITIONS];
+    lc3_encoder_t encoders[LC3_MAX_RENDITIONS];
+    uint8_t *out[LC3_MAX_RENDITIONS], ref[LC3_HR_MAX_FRAME_BYTES];
+
+    for (int i = 0; i < nr; i++) {
+        mem[i] = malloc(lc3_hr_encoder_size(hr, dt_us, sr_pcm_hz));
+        encoders[i] = lc3_hr_setup_encoder(
+            hr, dt_us, sr_hz[i], sr_pcm_hz, mem[i]);
+        out[i] = malloc(LC3_HR_MAX_FRAME_BYTES);
+    }
+
+    int ret = multi ? 0 : fail(config, "multi-rendition encoder setup");
+
+    /* --- Encode and compare --- */
+
+    for (int i = 0; ret == 0 && i < NUM_FRAMES; i++) {
+        const int16_t *pcm = x + i * ns;
+
+        if (lc3_multi_encode(multi, LC3_PCM_FORMAT_S16,
+                pcm, 1, nbytes, (void * const *)out) < 0) {
+            ret = fail(config, "multi-rendition encoding of frame %d", i);
+            break;
+        }
+
+        for (int j = 0; ret == 0 && j < nr; j++) {
+            lc3_encode(encoders[j], LC3_PCM_FORMAT_S16, pcm, 1, nbytes[j], ref);
+
+            if (memcmp(out[j], ref, nbytes[j]) != 0)
+                ret = fail(config, "rendition %d Hz, %d bytes "
+                    "differs at frame %d", sr_hz[j], nbytes[j], i);
+        }
+    }
+
+    /* --- Wrong parameters --- */
+
+    if (ret == 0 && (
+            lc3_multi_encode(multi, LC3_PCM_FORMAT_S16, x, 1, NULL,
+                (void * const *)out) != -1 ||
+            lc3_multi_encode(multi, LC3_PCM_FORMAT_S16, x, 1, nbytes,
+                NULL) != -1 ))
+        ret = fail(config, "null sizes or output buffers accepted");
+
+    for (int i = 0; i < nr; i++)
+        free(mem[i]), free(out[i]);
+
+    free(multi_mem);
+
+    return ret;
+}
+
+/**
+ * Check the multi-rendition encoder
+ */
+int check_multi(void)
+{
+    return for_each_config(check_renditions);
+}
@@ -0,0 +1,155 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "api.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+
+/**
+ * Number of channels of the block
+ */
+#define NUM_CHANNELS  3
+
+/**
+ * Check the sharing of blocks of a configuration, at a bitrate
+ * config          Configuration
+ * x               Input signal of `NUM_FRAMES` frames
+ * bitrate         Bitrate of the block
+ * return          0: Ok  -1: Failure
+ *
+ * The channels take the signal, the signal delayed and attenuated,
+ * and the silence.
+ */
+static int check_bitrate(
+    const struct config *config, const int16_t *x, int bitrate)
+{
+    bool hr = config->hrmode;
+    int dt_us = config->dt_us, sr_hz = config->sr_hz;
+    int ns = lc3_hr_frame_samples(hr, dt_us, sr_hz);
+
+    int min_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, 0);
+    int max_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, INT_MAX);
+    int block_bytes = lc3_hr_frame_block_bytes(
+        hr, dt_us, sr_hz, NUM_CHANNELS, bitrate);
+
+    /* --- Setup --- */
+
+    void *enc_mem[NUM_CHANNELS], *dec_mem[NUM_CHANNELS];
+    lc3_encoder_t encoders[NUM_CHANNELS];
+    lc3_decoder_t decoders[NUM_CHANNELS];
+    int16_t *pcm[NUM_CHANNELS];
+
+    for (int ich = 0; ich < NUM_CHANNELS; ich++) {
+        enc_mem[ich] = malloc(lc3_hr_encoder_size(hr, dt_us, sr_hz));
+        dec_mem[ich] = malloc(lc3_hr_decoder_size(hr, dt_us, sr_hz));
+
+        encoders[ich] = lc3_hr_setup_encoder(
+            hr, dt_us, sr_hz, sr_hz, enc_mem[ich]);
+        decoders[ich] = lc3_hr_setup_decoder(
+            hr, dt_us, sr_hz, sr_hz, dec_mem[ich]);
+
+        pcm[ich] = calloc(NUM_FRAMES * ns, sizeof(*pcm[ich]));
+    }
+
+    for (int i = 0; i < NUM_FRAMES * ns; i++)
+        pcm[0][i] = x[i], pcm[1][i] = i < ns / 3 ? 0 : x[i - ns / 3] / 4;
+
+    uint8_t *block = malloc(block_bytes);
+    int16_t *y = malloc(ns * sizeof(*y));
+
+    /* --- Encode and decode --- */
+
+    int ret = 0;
+
+    for (int i = 0; ret == 0 && i < NUM_FRAMES; i++) {
+        const void *frame_pcm[NUM_CHANNELS];
+        int nbytes[NUM_CHANNELS], total = 0;
+
+        for (int ich = 0; ich < NUM_CHANNELS; ich++)
+            frame_pcm[ich] = pcm[ich] + i * ns;
+
+        if (lc3_encode_pool(encoders, NUM_CHANNELS, LC3_PCM_FORMAT_S16,
+                frame_pcm, 1, block_bytes, nbytes, block) < 0) {
+            ret = fail(config, "encoding of block %d", i);
+            break;
+        }
+
+        for (int ich = 0; ret == 0 && ich < NUM_CHANNELS; ich++) {
+            if (nbytes[ich] < min_nbytes || nbytes[ich] > max_nbytes)
+                ret = fail(config, "block %d, channel %d of %d bytes, "
+                    "out of [%d, %d]", i, ich, nbytes[ich],
+                    min_nbytes, max_nbytes);
+
+            else if (lc3_decode(decoders[ich], block + total,
+                    nbytes[ich], LC3_PCM_FORMAT_S16, y, 1) != 0)
+                ret = fail(config, "block %d, channel %d of %d bytes "
+                    "not decoded", i, ich, nbytes[ich]);
+
+            total += nbytes[ich];
+        }
+
+        if (ret == 0 && total != block_bytes)
+            ret = fail(config, "block %d, %d bytes used out of %d",
+                i, total, block_bytes);
+    }
+
+    /* --- Wrong parameters --- */
+
+    const void *frame_pcm[NUM_CHANNELS] = { pcm[0], pcm[1], pcm[2] };
+    int nbytes[NUM_CHANNELS];
+
+    if (ret == 0 && (
+            lc3_encode_pool(NULL, NUM_CHANNELS, LC3_PCM_FORMAT_S16,
+                frame_pcm, 1, block_bytes, nbytes, block) != -1 ||
+            lc3_encode_pool(encoders, NUM_CHANNELS, LC3_PCM_FORMAT_S16,
+                frame_pcm, 1, block_bytes, NULL, block) != -1 ||
+            lc3_encode_pool(encoders, NUM_CHANNELS, LC3_PCM_FORMAT_S16,
+                frame_pcm, 1, block_bytes, nbytes, NULL) != -1 ))
+        ret = fail(config, "null encoders, sizes or output accepted");
+
+    for (int ich = 0; ich < NUM_CHANNELS; ich++)
+        free(enc_mem[ich]), free(dec_mem[ich]), free(pcm[ich]);
+
+    free(block);
+    free(y);
+
+    return ret;
+}
+
+/**
+ * Check the sharing of blocks of a configuration
+ * config          Configuration
+ * x               Input signal of `NUM_FRAMES` frames
+ * return          0: Ok  -1: Failure
+ */
+static int check_config(const struct config *config, const int16_t *x)
+{
+    int ret = check_bitrate(config, x, NUM_CHANNELS * 48000);
+
+    return check_bitrate(config, x, NUM_CHANNELS * 128000) || ret ? -1 : 0;
+}
+
+/**
+ * Check the sharing of the bytes of blocks between channels
+ */
+int check_pool(void)
+{
+    return for_each_config(check_config);
+}
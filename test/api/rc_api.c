@@ -0,0 +1,233 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "api.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+
+
+/**
+ * Number of frames between feedbacks
+ */
+#define INTERVAL_FRAMES  10
+
+/**
+ * Context of the check of a configuration
+ */
+struct context {
+    const struct config *config;
+    const int16_t *x;
+    int ns, pos;
+
+    lc3_encoder_t encoder;
+    lc3_decoder_t decoder;
+    lc3_rate_control_t rc;
+};
+
+/**
+ * Encode and decode the frames of an interval
+ * ctx             Context of the check
+ * avg, max        Return the average and maximum size of the frames
+ * return          0: Ok  -1: Failure
+ */
+static int run_interval(struct context *ctx, float *avg, int *max)
+{
+    int total = 0;
+    *max = 0;
+
+    for (int i = 0; i < INTERVAL_FRAMES; i++) {
+        uint8_t frame[LC3_HR_MAX_FRAME_BYTES];
+        int16_t y[LC3_HR_MAX_FRAME_SAMPLES];
+
+        const int16_t *pcm = ctx->x + ctx->pos * ctx->ns;
+        ctx->pos = (ctx->pos + 1) % NUM_FRAMES;
+
+        int nbytes = lc3_encode_rate_control(
+            ctx->encoder, &ctx->rc, LC3_PCM_FORMAT_S16, pcm, 1, frame);
+
+        if (nbytes < 0)
+            return fail(ctx->config, "encoding of frame %d", ctx->pos);
+
+        if (lc3_decode(ctx->decoder,
+                frame, nbytes, LC3_PCM_FORMAT_S16, y, 1) != 0)
+            return fail(ctx->config, "frame %d of %d bytes not decoded",
+                ctx->pos, nbytes);
+
+        total += nbytes;
+        *max = nbytes > *max ? nbytes : *max;
+    }
+
+    *avg = (float)total / INTERVAL_FRAMES;
+
+    return 0;
+}
+
+/**
+ * Send a feedback, and run the following interval
+ * ctx             Context of the check
+ * loss_rate       Loss rate of the feedback
+ * delay_us        Queuing delay of the feedback
+ * budget          Budget of the feedback, in bytes by frame
+ * avg, max        Return the average and maximum size of the frames
+ * return          0: Ok  -1: Failure
+ */
+static int run_feedback(struct context *ctx,
+    float loss_rate, int delay_us, int budget, float *avg, int *max)
+{
+    int interval_us = INTERVAL_FRAMES * ctx->config->dt_us;
+
+    if (lc3_encoder_rate_feedback(ctx->encoder, &ctx->rc,
+            loss_rate, delay_us, INTERVAL_FRAMES * budget, interval_us) < 0)
+        return fail(ctx->config, "feedback not accepted");
+
+    return run_interval(ctx, avg, max);
+}
+
+/**
+ * Check the rate control of a configuration
+ * config          Configuration
+ * x               Input signal of `NUM_FRAMES` frames
+ * return          0: Ok  -1: Failure
+ */
+static int check_config(const struct config *config, const int16_t *x)
+{
+    bool hr = config->hrmode;
+    int dt_us = config->dt_us, sr_hz = config->sr_hz;
+
+    int min_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, 0);
+    int max_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, INT_MAX);
+    int budget = 4 * min_nbytes < max_nbytes ? 4 * min_nbytes : max_nbytes;
+
+    void *enc_mem = malloc(lc3_hr_encoder_size(hr, dt_us, sr_hz));
+    void *dec_mem = malloc(lc3_hr_decoder_size(hr, dt_us, sr_hz));
+
+    struct context ctx = {
+        .config = config, .x = x,
+        .ns = lc3_hr_frame_samples(hr, dt_us, sr_hz),
+        .encoder = lc3_hr_setup_encoder(hr, dt_us, sr_hz, sr_hz, enc_mem),
+        .decoder = lc3_hr_setup_decoder(hr, dt_us, sr_hz, sr_hz, dec_mem),
+    };
+
+    lc3_setup_rate_control(&ctx.rc);
+
+    float avg, prev_avg;
+    int max, ret = 0;
+
+    /* --- No encoding before feedback, and wrong feedbacks --- */
+
+    uint8_t frame[LC3_HR_MAX_FRAME_BYTES];
+    lc3_encoder_t enc = ctx.encoder;
+    lc3_rate_control_t *rc = &ctx.rc;
+
+    if (lc3_encode_rate_control(
+            enc, rc, LC3_PCM_FORMAT_S16, x, 1, frame) != -1)
+        ret = fail(config, "encoding accepted without feedback");
+
+    if (ret == 0 && (
+            lc3_encoder_rate_feedback(enc, rc, -0.1f, 0, budget, dt_us)
+                != -1 ||
+            lc3_encoder_rate_feedback(enc, rc, 1.1f, 0, budget, dt_us)
+                != -1 ||
+            lc3_encoder_rate_feedback(enc, rc, 0, 0, -1, dt_us) != -1 ||
+            lc3_encoder_rate_feedback(enc, rc, 0, 0, budget, 0) != -1 ||
+            lc3_encoder_rate_feedback(enc, NULL, 0, 0, budget, dt_us)
+                != -1 ))
+        ret = fail(config, "wrong feedback accepted");
+
+    /* --- Budget tracked on average, and not exceeded by probing --- */
+
+    float sum = 0;
+
+    for (int i = 0; ret == 0 && i < 20; i++) {
+        ret = run_feedback(&ctx, 0, 0, budget, &avg, &max);
+        sum += avg;
+    }
+
+    if (ret == 0 && fabsf(sum / 20 - (float)budget) > 0.5f)
+        ret = fail(config, "average of %.1f bytes, budget of %d",
+            (double)(sum / 20), budget);
+
+    /* --- Backoff on loss, down to the minimum size --- */
+
+    prev_avg = avg;
+
+    for (int i = 0; ret == 0 && i < 5; i++) {
+        if ((ret = run_feedback(&ctx, 0.3f, 0, budget, &avg, &max)) < 0)
+            break;
+
+        if (avg >= prev_avg && prev_avg > (float)min_nbytes + 1)
+            ret = fail(config, "no backoff on loss, from %.1f to %.1f bytes",
+                (double)prev_avg, (double)avg);
+
+        prev_avg = avg;
+    }
+
+    /* --- Probing up, without loss --- */
+
+    for (int i = 0; ret == 0 && i < 5; i++) {
+        if ((ret = run_feedback(&ctx, 0, 0, budget, &avg, &max)) < 0)
+            break;
+
+        if (avg <= prev_avg)
+            ret = fail(config, "no probing, from %.1f to %.1f bytes",
+                (double)prev_avg, (double)avg);
+
+        prev_avg = avg;
+    }
+
+    /* --- Backoff on queuing delay, frames held to the target --- */
+
+    for (int i = 0; ret == 0 && i < 40; i++)
+        ret = run_feedback(&ctx, 0, 0, budget, &avg, &max);
+
+    for (int i = 0, target = budget; ret == 0 && i < 5; i++) {
+        int delay_us = 2 * LC3_RATE_CONTROL_MAX_DELAY_US;
+
+        if ((ret = run_feedback(&ctx, 0, delay_us, budget, &avg, &max)) < 0)
+            break;
+
+        if (max >= target && max > min_nbytes)
+            ret = fail(config, "frame of %d bytes on queuing delay, "
+                "over the previous target of %d bytes", max, target);
+
+        target = max;
+    }
+
+    /* --- Budget lowered --- */
+
+    for (int i = 0; ret == 0 && i < 5; i++)
+        if ((ret = run_feedback(&ctx, 0, 0, budget / 2, &avg, &max)) == 0
+                && max > budget / 2 + 8)
+            ret = fail(config, "frame of %d bytes, budget of %d",
+                max, budget / 2);
+
+    free(enc_mem);
+    free(dec_mem);
+
+    return ret;
+}
+
+/**
+ * Check the rate control
+ */
+int check_rate_control(void)
+{
+    return for_each_config(check_config);
+}
@@ -0,0 +1,116 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "api.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * Check the trial encodings of a configuration
+ * config          Configuration
+ * x               Input signal of `NUM_FRAMES` frames
+ * return          0: Ok  -1: Failure
+ *
+ * Each frame is encoded at the minimum and maximum sizes, and in variable
+ * bitrate mode, from a snapshot, then encoded back at a size varying from
+ * frame to frame. The result is compared to an encoder running the last
+ * encodings only.
+ */
+static int check_config(const struct config *config, const int16_t *x)
+{
+    bool hr = config->hrmode;
+    int dt_us = config->dt_us, sr_hz = config->sr_hz;
+    int ns = lc3_hr_frame_samples(hr, dt_us, sr_hz);
+
+    int min_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, 0);
+    int max_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, INT_MAX);
+
+    void *trial_mem = malloc(lc3_hr_encoder_size(hr, dt_us, sr_hz));
+    void *direct_mem = malloc(lc3_hr_encoder_size(hr, dt_us, sr_hz));
+    void *snapshot = malloc(lc3_hr_encoder_snapshot_size(hr, dt_us, sr_hz));
+
+    lc3_encoder_t trial =
+        lc3_hr_setup_encoder(hr, dt_us, sr_hz, sr_hz, trial_mem);
+    lc3_encoder_t direct =
+        lc3_hr_setup_encoder(hr, dt_us, sr_hz, sr_hz, direct_mem);
+
+    int ret = 0;
+
+    for (int i = 0; ret == 0 && i < NUM_FRAMES; i++) {
+        const int16_t *pcm = x + i * ns;
+        uint8_t frame[LC3_HR_MAX_FRAME_BYTES], ref[LC3_HR_MAX_FRAME_BYTES];
+
+        int nbytes = min_nbytes + (i * 37) % (max_nbytes - min_nbytes + 1);
+
+        /* --- Trial encodings, and encoding back from the snapshot --- */
+
+        lc3_encoder_snapshot(trial, snapshot);
+
+        lc3_encode(trial, LC3_PCM_FORMAT_S16, pcm, 1, min_nbytes, frame);
+        lc3_encoder_restore(trial, snapshot);
+
+        lc3_encode(trial, LC3_PCM_FORMAT_S16, pcm, 1, max_nbytes, frame);
+        lc3_encoder_restore(trial, snapshot);
+
+        lc3_encode_vbr(trial, LC3_PCM_FORMAT_S16,
+            pcm, 1, 30, min_nbytes, max_nbytes, frame);
+        lc3_encoder_restore(trial, snapshot);
+
+        lc3_encode(trial, LC3_PCM_FORMAT_S16, pcm, 1, nbytes, frame);
+
+        /* --- Direct encoding --- */
+
+        lc3_encode(direct, LC3_PCM_FORMAT_S16, pcm, 1, nbytes, ref);
+
+        if (memcmp(frame, ref, nbytes) != 0)
+            ret = fail(config, "frame %d of %d bytes differs "
+                "from the direct encoding", i, nbytes);
+    }
+
+    /* --- Wrong parameters --- */
+
+    int other_dt_us = dt_us == 10000 ? 5000 : 10000;
+    void *other_mem = malloc(lc3_hr_encoder_size(hr, other_dt_us, sr_hz));
+    lc3_encoder_t other =
+        lc3_hr_setup_encoder(hr, other_dt_us, sr_hz, sr_hz, other_mem);
+
+    if (ret == 0 && (
+            lc3_encoder_snapshot(NULL, snapshot) != -1 ||
+            lc3_encoder_snapshot(trial, NULL) != -1 ||
+            lc3_encoder_restore(trial, NULL) != -1 ||
+            lc3_encoder_restore(other, snapshot) != -1 ))
+        ret = fail(config, "wrong snapshot or encoder accepted");
+
+    free(trial_mem);
+    free(direct_mem);
+    free(other_mem);
+    free(snapshot);
+
+    return ret;
+}
+
+/**
+ * Check the snapshot and restore of the encoder
+ */
+int check_snapshot(void)
+{
+    return for_each_config(check_config);
+}
@@ -0,0 +1,364 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "api.h"
+
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * Offsets of fields in the serialized states, following the header
+ */
+#define HEADER_SIZE         9
+
+#define ENCODER_FLAGS       (HEADER_SIZE +  0)
+#define ENCODER_P_ATT       (HEADER_SIZE + 9)
+#define ENCODER_PITCH       (HEADER_SIZE + 11)
+#define ENCODER_NC          (HEADER_SIZE + 13)
+#define ENCODER_TC          (HEADER_SIZE + 37)
+
+#define DECODER_ACTIVE      (HEADER_SIZE +  0)
+#define DECODER_PITCH       (HEADER_SIZE +  1)
+#define DECODER_C           (HEADER_SIZE +  3)
+#define DECODER_PLC_COUNT   (HEADER_SIZE + 149)
+#define DECODER_PLC_ALPHA   (HEADER_SIZE + 151)
+#define DECODER_HISTORIES   (HEADER_SIZE + 155)
+
+/**
+ * Write a field of a serialized state
+ * buffer, offset  Serialized state, and offset of the field
+ * v, nbytes       Value, and count of bytes
+ */
+static void put_field(uint8_t *buffer, int offset, uint32_t v, int nbytes)
+{
+    for (int i = 0; i < nbytes; i++, v >>= 8)
+        buffer[offset + i] = v & 0xff;
+}
+
+static void put_float(uint8_t *buffer, int offset, float v)
+{
+    uint32_t u;
+    memcpy(&u, &v, sizeof(u));
+    put_field(buffer, offset, u, 4);
+}
+
+/**
+ * Check the rejection of corrupted states of an encoder
+ * config          Configuration
+ * encoder         Encoder in a running state
+ * return          0: Ok  -1: Failure
+ *
+ * Each corruption of the exported state shall be rejected, leaving the
+ * encoder unchanged.
+ */
+static int check_encoder_corruption(
+    const struct config *config, lc3_encoder_t encoder)
+{
+    int size = lc3_encoder_export(encoder, 0, NULL, 0);
+    uint8_t *ref = malloc(size), *state = malloc(size), *back = malloc(size);
+
+    lc3_encoder_export(encoder, 0, ref, size);
+
+    enum { FLAGS, P_ATT, PITCH_LOW, PITCH_HIGH, TC, NAN_NC, TRUNCATED,
+           NUM_CORRUPTIONS };
+
+    int ret = 0;
+
+    for (int c = 0; ret == 0 && c < NUM_CORRUPTIONS; c++) {
+        int state_size = size;
+        memcpy(state, ref, size);
+
+        switch (c) {
+        case FLAGS: put_field(state, ENCODER_FLAGS, 1 << 3, 1); break;
+        case P_ATT: put_field(state, ENCODER_P_ATT, 5, 2); break;
+        case PITCH_LOW: put_field(state, ENCODER_PITCH, 4*32 - 1, 2); break;
+        case PITCH_HIGH: put_field(state, ENCODER_PITCH, 30000, 2); break;
+        case TC: put_field(state, ENCODER_TC, 98, 2); break;
+        case NAN_NC: put_field(state, ENCODER_NC, 0x7fc00000, 4); break;
+        case TRUNCATED: state_size -= 1; break;
+        }
+
+        if (lc3_encoder_import(encoder, state, state_size) != -1)
+            ret = fail(config, "corrupted encoder state %d accepted", c);
+
+        lc3_encoder_export(encoder, 0, back, size);
+        if (ret == 0 && memcmp(back, ref, size) != 0)
+            ret = fail(config, "encoder changed by the corrupted "
+                "state %d", c);
+    }
+
+    free(ref);
+    free(state);
+    free(back);
+
+    return ret;
+}
+
+/**
+ * Check the rejection of corrupted states of a decoder
+ * config          Configuration
+ * decoder         Decoder in a running state
+ * return          0: Ok  -1: Failure
+ */
+static int check_decoder_corruption(
+    const struct config *config, lc3_decoder_t decoder)
+{
+    int size = lc3_decoder_export(decoder, 0, NULL, 0);
+    uint8_t *ref = malloc(size), *state = malloc(size), *back = malloc(size);
+
+    lc3_decoder_export(decoder, 0, ref, size);
+
+    enum { ACTIVE, ACTIVE_PITCH, PITCH, COEF, COUNT, ALPHA, NAN_HISTORY,
+           TRUNCATED, NUM_CORRUPTIONS };
+
+    int ret = 0;
+
+    for (int c = 0; ret == 0 && c < NUM_CORRUPTIONS; c++) {
+        int state_size = size;
+        memcpy(state, ref, size);
+
+        switch (c) {
+        case ACTIVE: put_field(state, DECODER_ACTIVE, 2, 1); break;
+
+        case ACTIVE_PITCH:
+            put_field(state, DECODER_ACTIVE, 1, 1);
+            put_field(state, DECODER_PITCH, config->hrmode ? 400 : 0, 2);
+            break;
+
+        case PITCH: put_field(state, DECODER_PITCH, 30000, 2); break;
+        case COEF: put_float(state, DECODER_C + 4*5, 2.f); break;
+        case COUNT: put_field(state, DECODER_PLC_COUNT, 0, 2); break;
+        case ALPHA: put_float(state, DECODER_PLC_ALPHA, 1.5f); break;
+        case NAN_HISTORY: put_field(state, size - 4, 0x7f800000, 4); break;
+        case TRUNCATED: state_size -= 1; break;
+        }
+
+        if (lc3_decoder_import(decoder, state, state_size) != -1)
+            ret = fail(config, "corrupted decoder state %d accepted", c);
+
+        lc3_decoder_export(decoder, 0, back, size);
+        if (ret == 0 && memcmp(back, ref, size) != 0)
+            ret = fail(config, "decoder changed by the corrupted "
+                "state %d", c);
+    }
+
+    free(ref);
+    free(state);
+    free(back);
+
+    return ret;
+}
+
+/**
+ * Check the quantization of histories of tiny samples
+ * config          Configuration
+ * decoder         Decoder in a running state, changed
+ * return          0: Ok  -1: Failure
+ *
+ * The histories of samples are set to magnitudes near the smallest normal
+ * float, and denormals. The quantized transfer of the state shall keep the
+ * samples within half of the smallest normal float, the exponent shared
+ * by the quantized samples being bounded. A quantized state with an
+ * exponent under this bound shall be rejected.
+ */
+static int check_tiny_history(
+    const struct config *config, lc3_decoder_t decoder)
+{
+    static const float tiny[] = {
+        3e-37f, -2e-36f, 1e-38f, -1e-40f, 0, 7e-38f, -5e-37f };
+
+    int size = lc3_decoder_export(decoder, 0, NULL, 0);
+    int qsize = lc3_decoder_export(decoder, LC3_STATE_QUANTIZED, NULL, 0);
+    uint8_t *state = malloc(size), *qstate = malloc(qsize);
+    float *x = malloc(size), *y = malloc(size);
+    int n = (size - DECODER_HISTORIES) / 4;
+
+    lc3_decoder_export(decoder, 0, state, size);
+
+    for (int i = 0; i < n; i++) {
+        x[i] = tiny[i % (sizeof(tiny) / sizeof(*tiny))];
+        put_float(state, DECODER_HISTORIES + 4*i, x[i]);
+    }
+
+    int ret = 0;
+
+    if (lc3_decoder_import(decoder, state, size) != 0 ||
+        lc3_decoder_export(
+            decoder, LC3_STATE_QUANTIZED, qstate, qsize) != qsize ||
+        lc3_decoder_import(decoder, qstate, qsize) != 0)
+        ret = fail(config, "tiny histories not transferred");
+
+    put_field(qstate, DECODER_HISTORIES, (uint8_t)-112, 1);
+
+    if (ret == 0 && lc3_decoder_import(decoder, qstate, qsize) != -1)
+        ret = fail(config, "quantized history, exponent out of range "
+            "accepted");
+
+    lc3_decoder_export(decoder, 0, state, size);
+    memcpy(y, state + DECODER_HISTORIES, n * sizeof(float));
+
+    for (int i = 0; ret == 0 && i < n; i++)
+        if (fabsf(y[i] - x[i]) > FLT_MIN / 2)
+            ret = fail(config, "tiny history sample %g, "
+                "transferred as %g", (double)x[i], (double)y[i]);
+
+    free(state);
+    free(qstate);
+    free(x);
+    free(y);
+
+    return ret;
+}
+
+/**
+ * Check the export and import of the states of a configuration
+ * config          Configuration
+ * x               Input signal of `NUM_FRAMES` frames
+ * return          0: Ok  -1: Failure
+ *
+ * In the middle of the signal, the states of a reference encoder and
+ * decoder are exported, and imported in new instances, which continue the
+ * encoding and decoding. Without quantization of the histories, the
+ * continuation is bit-exact. With quantization, the decoded signal shall
+ * stay close to the reference.
+ */
+static int check_config(const struct config *config, const int16_t *x)
+{
+    bool hr = config->hrmode;
+    int dt_us = config->dt_us, sr_hz = config->sr_hz;
+    int ns = lc3_hr_frame_samples(hr, dt_us, sr_hz);
+
+    int min_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, 0);
+    int max_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, INT_MAX);
+
+    enum { REF, EXACT, QUANTIZED, NUM_INSTANCES };
+    void *encoder_mem[NUM_INSTANCES], *decoder_mem[NUM_INSTANCES];
+    lc3_encoder_t encoder[NUM_INSTANCES];
+    lc3_decoder_t decoder[NUM_INSTANCES];
+
+    for (int k = 0; k < NUM_INSTANCES; k++) {
+        encoder_mem[k] = malloc(lc3_hr_encoder_size(hr, dt_us, sr_hz));
+        decoder_mem[k] = malloc(lc3_hr_decoder_size(hr, dt_us, sr_hz));
+
+        encoder[k] = lc3_hr_setup_encoder(
+            hr, dt_us, sr_hz, sr_hz, encoder_mem[k]);
+        decoder[k] = lc3_hr_setup_decoder(
+            hr, dt_us, sr_hz, sr_hz, decoder_mem[k]);
+    }
+
+    int n = (NUM_FRAMES / 2) * ns;
+    float *y[NUM_INSTANCES];
+    for (int k = 0; k < NUM_INSTANCES; k++)
+        y[k] = malloc(n * sizeof(float));
+
+    int ret = 0;
+
+    for (int i = 0; ret == 0 && i < NUM_FRAMES; i++) {
+        const int16_t *pcm = x + i * ns;
+        uint8_t frame[NUM_INSTANCES][LC3_HR_MAX_FRAME_BYTES];
+
+        int nbytes = min_nbytes + (i * 37) % (max_nbytes - min_nbytes + 1);
+        bool lost = i % 11 == 5;
+
+        /* --- Transfer of the states, in the middle of the signal --- */
+
+        if (i == NUM_FRAMES / 2) {
+            int flags[NUM_INSTANCES] = {
+                [EXACT] = 0, [QUANTIZED] = LC3_STATE_QUANTIZED };
+
+            for (int k = EXACT; ret == 0 && k <= QUANTIZED; k++) {
+                int size = lc3_encoder_export(encoder[REF], flags[k], NULL, 0);
+                uint8_t *state = malloc(size);
+
+                if (lc3_encoder_export(
+                        encoder[REF], flags[k], state, size) != size ||
+                    lc3_encoder_import(encoder[k], state, size) != 0)
+                    ret = fail(config, "encoder state not transferred");
+
+                free(state);
+
+                size = lc3_decoder_export(decoder[REF], flags[k], NULL, 0);
+                state = malloc(size);
+
+                if (ret == 0 && (lc3_decoder_export(
+                        decoder[REF], flags[k], state, size) != size ||
+                    lc3_decoder_import(decoder[k], state, size) != 0))
+                    ret = fail(config, "decoder state not transferred");
+
+                free(state);
+            }
+        }
+
+        /* --- Encoding and decoding --- */
+
+        int nk = i < NUM_FRAMES / 2 ? 1 : NUM_INSTANCES;
+
+        for (int k = 0; k < nk; k++) {
+            lc3_encode(encoder[k], LC3_PCM_FORMAT_S16,
+                pcm, 1, nbytes, frame[k]);
+
+            float *out = i < NUM_FRAMES / 2 ?
+                y[k] : y[k] + (i - NUM_FRAMES / 2) * ns;
+
+            lc3_decode(decoder[k], lost ? NULL : frame[k], nbytes,
+                LC3_PCM_FORMAT_FLOAT, out, 1);
+        }
+
+        if (ret == 0 && nk > EXACT &&
+                memcmp(frame[EXACT], frame[REF], nbytes) != 0)
+            ret = fail(config, "frame %d differs after the transfer "
+                "of the encoder state", i);
+    }
+
+    /* --- Decoded signals --- */
+
+    if (ret == 0 && memcmp(y[EXACT], y[REF], n * sizeof(float)) != 0)
+        ret = fail(config, "decoding differs after the transfer "
+            "of the decoder state");
+
+    double q = snr(y[REF], y[QUANTIZED], n);
+    if (ret == 0 && q < 70)
+        ret = fail(config, "quantized transfer of the states, "
+            "SNR of %.1f dB", q);
+
+    /* --- Corrupted states --- */
+
+    ret = ret || check_encoder_corruption(config, encoder[EXACT]);
+    ret = ret || check_decoder_corruption(config, decoder[EXACT]);
+    ret = ret || check_tiny_history(config, decoder[EXACT]);
+
+    for (int k = 0; k < NUM_INSTANCES; k++) {
+        free(encoder_mem[k]);
+        free(decoder_mem[k]);
+        free(y[k]);
+    }
+
+    return ret;
+}
+
+/**
+ * Check the export and import of the states
+ */
+int check_state(void)
+{
+    return for_each_config(check_config);
+}
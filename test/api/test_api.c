@@ -0,0 +1,72 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include <stdio.h>
+
+int check_multi(void);
+int check_vbr(void);
+int check_estimate(void);
+int check_pool(void);
+int check_rate_control(void);
+int check_fec(void);
+int check_snapshot(void);
+int check_state(void);
+int check_gain(void);
+
+int main()
+{
+    int r, ret = 0;
+
+    printf("Checking Multi-rendition encoder... "); fflush(stdout);
+    printf("%s\n", (r = check_multi()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking Variable bitrate encoding... "); fflush(stdout);
+    printf("%s\n", (r = check_vbr()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking Size estimation... "); fflush(stdout);
+    printf("%s\n", (r = check_estimate()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking Block sharing between channels... "); fflush(stdout);
+    printf("%s\n", (r = check_pool()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking Rate control... "); fflush(stdout);
+    printf("%s\n", (r = check_rate_control()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking Packet loss recovery... "); fflush(stdout);
+    printf("%s\n", (r = check_fec()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking Encoder snapshot... "); fflush(stdout);
+    printf("%s\n", (r = check_snapshot()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking State export and import... "); fflush(stdout);
+    printf("%s\n", (r = check_state()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking Gain control... "); fflush(stdout);
+    printf("%s\n", (r = check_gain()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    return ret;
+}
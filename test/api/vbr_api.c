@@ -0,0 +1,259 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "api.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * Quality targets checked, in increasing order
+ */
+static const float qualities[] = { 0, 10, 20, 30, 40, 60 };
+
+#define NUM_QUALITIES  (int)(sizeof(qualities) / sizeof(*qualities))
+
+/**
+ * Encode and decode a signal at a quality target
+ * config          Configuration
+ * x               Input signal of `NUM_FRAMES` frames
+ * quality         Quality target
+ * min_nbytes      Minimum size of the frames
+ * max_nbytes      Maximum size of the frames
+ * total           Output the total size of the frames
+ * return          0: Ok  -1: Failure
+ */
+static int check_quality(const struct config *config, const int16_t *x,
+    float quality, int min_nbytes, int max_nbytes, long *total)
+{
+    bool hr = config->hrmode;
+    int dt_us = config->dt_us, sr_hz = config->sr_hz;
+    int ns = lc3_hr_frame_samples(hr, dt_us, sr_hz);
+
+    void *enc_mem = malloc(lc3_hr_encoder_size(hr, dt_us, sr_hz));
+    void *dec_mem = malloc(lc3_hr_decoder_size(hr, dt_us, sr_hz));
+    int16_t *y = malloc(ns * sizeof(*y));
+
+    lc3_encoder_t encoder =
+        lc3_hr_setup_encoder(hr, dt_us, sr_hz, sr_hz, enc_mem);
+    lc3_decoder_t decoder =
+        lc3_hr_setup_decoder(hr, dt_us, sr_hz, sr_hz, dec_mem);
+
+    int ret = 0;
+    *total = 0;
+
+    for (int i = 0; ret == 0 && i < NUM_FRAMES; i++) {
+        uint8_t frame[LC3_HR_MAX_FRAME_BYTES];
+
+        int nbytes = lc3_encode_vbr(encoder, LC3_PCM_FORMAT_S16,
+            x + i * ns, 1, quality, min_nbytes, max_nbytes, frame);
+
+        if (nbytes < min_nbytes || nbytes > max_nbytes)
+            ret = fail(config, "quality %g dB, frame %d of %d bytes, "
+                "out of [%d, %d]", (double)quality, i, nbytes,
+                min_nbytes, max_nbytes);
+
+        else if (lc3_decode(decoder,
+                frame, nbytes, LC3_PCM_FORMAT_S16, y, 1) != 0)
+            ret = fail(config, "quality %g dB, frame %d of %d bytes "
+                "not decoded", (double)quality, i, nbytes);
+
+        *total += nbytes;
+    }
+
+    free(enc_mem);
+    free(dec_mem);
+    free(y);
+
+    return ret;
+}
+
+/**
+ * Check that a range reduced to a size gives the constant bitrate frames
+ * config          Configuration
+ * x               Input signal of `NUM_FRAMES` frames
+ * nbytes          Size of the frames
+ * return          0: Ok  -1: Failure
+ */
+static int check_cbr(const struct config *config, const int16_t *x, int nbytes)
+{
+    bool hr = config->hrmode;
+    int dt_us = config->dt_us, sr_hz = config->sr_hz;
+    int ns = lc3_hr_frame_samples(hr, dt_us, sr_hz);
+
+    void *vbr_mem = malloc(lc3_hr_encoder_size(hr, dt_us, sr_hz));
+    void *cbr_mem = malloc(lc3_hr_encoder_size(hr, dt_us, sr_hz));
+
+    lc3_encoder_t vbr = lc3_hr_setup_encoder(hr, dt_us, sr_hz, sr_hz, vbr_mem);
+    lc3_encoder_t cbr = lc3_hr_setup_encoder(hr, dt_us, sr_hz, sr_hz, cbr_mem);
+
+    int ret = 0;
+
+    for (int i = 0; ret == 0 && i < NUM_FRAMES; i++) {
+        uint8_t vbr_frame[LC3_HR_MAX_FRAME_BYTES];
+        uint8_t cbr_frame[LC3_HR_MAX_FRAME_BYTES];
+
+        int vbr_nbytes = lc3_encode_vbr(vbr, LC3_PCM_FORMAT_S16,
+            x + i * ns, 1, qualities[NUM_QUALITIES-1], nbytes, nbytes,
+            vbr_frame);
+
+        lc3_encode(cbr, LC3_PCM_FORMAT_S16, x + i * ns, 1, nbytes, cbr_frame);
+
+        if (vbr_nbytes != nbytes || memcmp(vbr_frame, cbr_frame, nbytes) != 0)
+            ret = fail(config, "frame %d of %d bytes differs "
+                "from constant bitrate", i, nbytes);
+    }
+
+    free(vbr_mem);
+    free(cbr_mem);
+
+    return ret;
+}
+
+/**
+ * Check the variable bitrate encoding of a configuration
+ * config          Configuration
+ * x               Input signal of `NUM_FRAMES` frames
+ * return          0: Ok  -1: Failure
+ */
+static int check_config(const struct config *config, const int16_t *x)
+{
+    bool hr = config->hrmode;
+    int dt_us = config->dt_us, sr_hz = config->sr_hz;
+
+    int min_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, 0);
+    int max_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, INT_MAX);
+
+    /* --- Sizes in range, and growing with the quality --- */
+
+    long total[NUM_QUALITIES];
+
+    for (int i = 0; i < NUM_QUALITIES; i++) {
+        if (check_quality(config, x,
+                qualities[i], min_nbytes, max_nbytes, &total[i]) < 0)
+            return -1;
+
+        if (i > 0 && total[i] < total[i-1])
+            return fail(config, "%ld bytes at %g dB, less than %ld at %g dB",
+                total[i], (double)qualities[i],
+                total[i-1], (double)qualities[i-1]);
+    }
+
+    if (total[NUM_QUALITIES-1] <= total[0])
+        return fail(config, "sizes do not follow the quality");
+
+    /* --- Narrow range, and range reduced to a size --- */
+
+    int nbytes = (min_nbytes + max_nbytes) / 2;
+    long narrow_total;
+
+    if (check_quality(config, x, qualities[NUM_QUALITIES / 2],
+            nbytes - 10, nbytes + 10, &narrow_total) < 0)
+        return -1;
+
+    return check_cbr(config, x, nbytes);
+}
+
+/**
+ * Check the size estimation for quality targets of a configuration
+ * config          Configuration
+ * x               Input signal of `NUM_FRAMES` frames
+ * return          0: Ok  -1: Failure
+ */
+static int check_estimate_config(const struct config *config, const int16_t *x)
+{
+    bool hr = config->hrmode;
+    int dt_us = config->dt_us, sr_hz = config->sr_hz;
+    int ns = lc3_hr_frame_samples(hr, dt_us, sr_hz);
+
+    int min_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, 0);
+    int max_nbytes = lc3_hr_frame_bytes(hr, dt_us, sr_hz, INT_MAX);
+
+    void *mem = malloc(lc3_hr_encoder_size(hr, dt_us, sr_hz));
+    lc3_encoder_t encoder;
+
+    int nbytes[NUM_QUALITIES], ret = 0;
+
+    /* --- First frame, sized as in variable bitrate mode --- */
+
+    encoder = lc3_hr_setup_encoder(hr, dt_us, sr_hz, sr_hz, mem);
+    lc3_encode_estimate(encoder, LC3_PCM_FORMAT_S16,
+        x, 1, NUM_QUALITIES, qualities, min_nbytes, max_nbytes, nbytes);
+
+    for (int i = 0; ret == 0 && i < NUM_QUALITIES; i++) {
+        uint8_t frame[LC3_HR_MAX_FRAME_BYTES];
+
+        encoder = lc3_hr_setup_encoder(hr, dt_us, sr_hz, sr_hz, mem);
+        int vbr_nbytes = lc3_encode_vbr(encoder, LC3_PCM_FORMAT_S16,
+            x, 1, qualities[i], min_nbytes, max_nbytes, frame);
+
+        if (nbytes[i] != vbr_nbytes)
+            ret = fail(config, "quality %g dB, estimation of %d bytes, "
+                "encoded on %d bytes", (double)qualities[i],
+                nbytes[i], vbr_nbytes);
+    }
+
+    /* --- Sizes in range, and growing with the quality --- */
+
+    encoder = lc3_hr_setup_encoder(hr, dt_us, sr_hz, sr_hz, mem);
+
+    for (int i = 0; ret == 0 && i < NUM_FRAMES; i++) {
+        if (lc3_encode_estimate(encoder, LC3_PCM_FORMAT_S16, x + i * ns, 1,
+                NUM_QUALITIES, qualities, min_nbytes, max_nbytes, nbytes) < 0)
+            ret = fail(config, "estimation of frame %d", i);
+
+        for (int j = 0; ret == 0 && j < NUM_QUALITIES; j++)
+            if (nbytes[j] < min_nbytes || nbytes[j] > max_nbytes
+                    || (j > 0 && nbytes[j] < nbytes[j-1]))
+                ret = fail(config, "quality %g dB, frame %d estimated "
+                    "on %d bytes", (double)qualities[j], i, nbytes[j]);
+    }
+
+    /* --- Wrong parameters --- */
+
+    if (ret == 0 && (
+            lc3_encode_estimate(encoder, LC3_PCM_FORMAT_S16, x, 1,
+                NUM_QUALITIES, qualities, max_nbytes, min_nbytes,
+                nbytes) != -1 ||
+            lc3_encode_estimate(encoder, LC3_PCM_FORMAT_S16, x, 1,
+                NUM_QUALITIES, qualities, min_nbytes - 1, max_nbytes,
+                nbytes) != -1 ))
+        ret = fail(config, "wrong range of sizes accepted");
+
+    free(mem);
+
+    return ret;
+}
+
+/**
+ * Check the variable bitrate encoding
+ */
+int check_vbr(void)
+{
+    return for_each_config(check_config);
+}
+
+/**
+ * Check the size estimation for quality targets
+ */
+int check_estimate(void)
+{
+    return for_each_config(check_estimate_config);
+}
@@ -0,0 +1,65 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "simd32.h"
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_ARM
+#include <attdet.c>
+
+/* -------------------------------------------------------------------------- */
+
+static int check_energy(void)
+{
+    static int16_t alignas(4) __x[6+480];
+    int16_t *x = __x + 6;
+    int32_t e[4], e_arm[4];
+
+    for (int i = -6; i < 480; i++)
+        x[i] = rand() & 0xffff;
+
+    for (int nblk = 3; nblk <= 4; nblk++) {
+
+        compute_energy(LC3_SRATE_32K, x, nblk, e);
+        arm_compute_energy(LC3_SRATE_32K, x, nblk, e_arm);
+        if (memcmp(e, e_arm, nblk * sizeof(*e)) != 0)
+            return -1;
+
+        compute_energy(LC3_SRATE_48K, x, nblk, e);
+        arm_compute_energy(LC3_SRATE_48K, x, nblk, e_arm);
+        if (memcmp(e, e_arm, nblk * sizeof(*e)) != 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+int check_attdet(void)
+{
+    int ret;
+
+    if ((ret = check_energy()) < 0)
+        return ret;
+
+    return 0;
+}
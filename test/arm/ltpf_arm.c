@@ -100,6 +100,47 @@ static int check_correlate()
     return 0;
 }
 
+static int check_resampler_6k4()
+{
+    static int16_t alignas(4) __x[4+256];
+    int16_t *x = __x + 4;
+    int16_t y[128], y_arm[128];
+
+    for (int i = -4; i < 256; i++)
+        x[i] = rand() & 0xffff;
+
+    resample_6k4(x, y, 128);
+    arm_resample_6k4(x, y_arm, 128);
+    if (memcmp(y, y_arm, 128 * sizeof(*y)) != 0)
+        return -1;
+
+    return 0;
+}
+
+static int check_interpolate()
+{
+    static int16_t alignas(4) __x[4+256];
+    int16_t *x = __x + 4;
+    int16_t y[128], y_arm[128];
+
+    for (int i = -4; i < 256; i++)
+        x[i] = rand() & 0xffff;
+
+    for (int d = 0; d < 4; d++) {
+        interpolate(x, 128, d, y);
+        arm_interpolate(x, 128, d, y_arm);
+        if (memcmp(y, y_arm, 128 * sizeof(*y)) != 0)
+            return -1;
+
+        interpolate(x + 1, 120, d, y);
+        arm_interpolate(x + 1, 120, d, y_arm);
+        if (memcmp(y, y_arm, 120 * sizeof(*y)) != 0)
+            return -1;
+    }
+
+    return 0;
+}
+
 int check_ltpf(void)
 {
     int ret;
@@ -107,8 +148,14 @@ int check_ltpf(void)
     if ((ret = check_resampler()) < 0)
         return ret;
 
+    if ((ret = check_resampler_6k4()) < 0)
+        return ret;
+
     if ((ret = check_correlate()) < 0)
         return ret;
 
+    if ((ret = check_interpolate()) < 0)
+        return ret;
+
     return 0;
 }
@@ -17,6 +17,7 @@
 test_arm_src += \
     $(TEST_DIR)/arm/test_arm.c \
     $(TEST_DIR)/arm/ltpf_arm.c \
+    $(TEST_DIR)/arm/attdet_arm.c \
     $(SRC_DIR)/tables.c
 
 test_arm_include += $(SRC_DIR)
@@ -42,6 +42,15 @@ static int16x2_t __pkhbt(int16x2_t a, int16x2_t b)
     return (int16x2_t)(a_bot | b_top);
 }
 
+__attribute__((unused))
+static int32_t __smuad(int16x2_t a, int16x2_t b)
+{
+    int16_t a_hi = a >> 16, a_lo = a & 0xffff;
+    int16_t b_hi = b >> 16, b_lo = b & 0xffff;
+
+    return (a_hi * b_hi) + (a_lo * b_lo);
+}
+
 __attribute__((unused))
 static int32_t __smlad(int16x2_t a, int16x2_t b, int32_t u)
 {
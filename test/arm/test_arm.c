@@ -19,6 +19,7 @@
 #include <stdio.h>
 
 int check_ltpf(void);
+int check_attdet(void);
 
 int main()
 {
@@ -28,5 +29,9 @@ int main()
     printf("%s\n", (r = check_ltpf()) == 0 ? "OK" : "Failed");
     ret = ret || r;
 
+    printf("Checking Attack Detector ARM... "); fflush(stdout);
+    printf("%s\n", (r = check_attdet()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
     return ret;
 }
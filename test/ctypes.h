@@ -296,6 +296,9 @@ static PyObject *to_ltpf_analysis(
     CTYPES_CHECK("ltpf.tc", to_scalar(
         PyDict_GetItemString(obj, "tc"), NPY_INT, &ltpf->tc));
 
+    CTYPES_CHECK("ltpf.track", to_scalar(
+        PyDict_GetItemString(obj, "track"), NPY_BOOL, &ltpf->track));
+
     return obj;
 }
 
@@ -329,6 +332,9 @@ static PyObject *from_ltpf_analysis(
     PyDict_SetItemString(obj, "tc",
         new_scalar(NPY_INT, &ltpf->tc));
 
+    PyDict_SetItemString(obj, "track",
+        new_scalar(NPY_BOOL, &ltpf->track));
+
     return obj;
 }
 
@@ -552,6 +558,9 @@ static PyObject *from_spec_analysis(
     PyDict_SetItemString(obj, "nbits_spare",
         new_scalar(NPY_INT, &spec->nbits_spare));
 
+    PyDict_SetItemString(obj, "g_idx",
+        new_scalar(NPY_INT, &spec->g_idx));
+
     return obj;
 }
 
@@ -569,6 +578,10 @@ static PyObject *to_spec_analysis(
         to_scalar(PyDict_GetItemString(obj, "nbits_spare"),
             NPY_INT, &spec->nbits_spare));
 
+    CTYPES_CHECK("spec.g_idx",
+        to_scalar(PyDict_GetItemString(obj, "g_idx"),
+            NPY_INT, &spec->g_idx));
+
     return obj;
 }
 
@@ -624,6 +637,9 @@ static PyObject *new_side_data(const struct side_data *side)
     PyDict_SetItemString(obj, "bw",
         new_scalar(NPY_INT, &(int){ side->bw }));
 
+    PyDict_SetItemString(obj, "pitch_present",
+        new_scalar(NPY_BOOL, &side->pitch_present));
+
     PyDict_SetItemString(obj, "ltpf",
         new_ltpf_data(&side->ltpf));
 
@@ -633,6 +649,9 @@ static PyObject *new_side_data(const struct side_data *side)
     PyDict_SetItemString(obj, "tns",
         new_tns_data(&side->tns));
 
+    PyDict_SetItemString(obj, "spec",
+        new_spec_side(&side->spec));
+
     return obj;
 }
 
@@ -649,6 +668,10 @@ static PyObject *to_side_data(PyObject *obj, struct side_data *side)
         side->bw = bw;
     }
 
+    if ((item = PyDict_GetItemString(obj, "pitch_present")))
+        CTYPES_CHECK("frame.pitch_present",
+            to_scalar(item, NPY_BOOL, &side->pitch_present));
+
     if ((item = PyDict_GetItemString(obj, "ltpf")))
         to_ltpf_data(item, &side->ltpf);
 
@@ -658,6 +681,54 @@ static PyObject *to_side_data(PyObject *obj, struct side_data *side)
     if ((item = PyDict_GetItemString(obj, "tns")))
         to_tns_data(item, &side->tns);
 
+    if ((item = PyDict_GetItemString(obj, "spec")))
+        to_spec_data(item, &side->spec);
+
+    return obj;
+}
+
+__attribute__((unused))
+static PyObject *new_frame_info(const struct lc3_frame_info *info)
+{
+    PyObject *obj = PyDict_New();
+
+    PyDict_SetItemString(obj, "bandwidth",
+        new_scalar(NPY_INT, &info->bandwidth));
+
+    PyDict_SetItemString(obj, "lastnz",
+        new_scalar(NPY_INT, &info->lastnz));
+
+    PyDict_SetItemString(obj, "lsb_mode",
+        new_scalar(NPY_BOOL, &info->lsb_mode));
+
+    PyDict_SetItemString(obj, "global_gain",
+        new_scalar(NPY_INT, &info->global_gain));
+
+    PyDict_SetItemString(obj, "noise_factor",
+        new_scalar(NPY_INT, &info->noise_factor));
+
+    PyDict_SetItemString(obj, "tns_nfilters",
+        new_scalar(NPY_INT, &info->tns_nfilters));
+
+    PyDict_SetItemString(obj, "tns_order",
+        new_1d_copy(NPY_INT, 2, info->tns_order));
+
+    PyDict_SetItemString(obj, "pitch_present",
+        new_scalar(NPY_BOOL, &info->pitch_present));
+
+    PyDict_SetItemString(obj, "ltpf_active",
+        new_scalar(NPY_BOOL, &info->ltpf_active));
+
+    PyDict_SetItemString(obj, "pitch_index",
+        new_scalar(NPY_INT, &info->pitch_index));
+
+    PyDict_SetItemString(obj, "sns",
+        new_sns_data(&(struct lc3_sns_data){
+            .lfcb = info->sns.lfcb, .hfcb = info->sns.hfcb,
+            .shape = info->sns.shape, .gain = info->sns.gain,
+            .idx_a = info->sns.idx_a, .ls_a = info->sns.ls_a,
+            .idx_b = info->sns.idx_b, .ls_b = info->sns.ls_b }));
+
     return obj;
 }
 
@@ -0,0 +1,156 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include <lc3.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+#define DT_US      10000
+#define SR_HZ      48000
+#define NBYTES     120
+#define NFRAMES    400
+#define NWARMUP      2
+#define NRUNS        8
+
+/**
+ * Time elapsed, in nanoseconds, since a start point
+ */
+static double elapsed_ns(const struct timespec *t0)
+{
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    return (t1.tv_sec - t0->tv_sec) * 1e9 + (t1.tv_nsec - t0->tv_nsec);
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double da = *(const double *)a, db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+/**
+ * Report the median, the 99th percentile and the worst time of frames
+ * name            Name of the scenario
+ * t, n            Time of the frames, and count
+ */
+static void report(const char *name, double *t, int n)
+{
+    qsort(t, n, sizeof(*t), compare_double);
+
+    double median = t[n/2], p99 = t[(n*99)/100], worst = t[n-1];
+
+    printf("  %-24s %9.1f us %9.1f us %9.1f us    x%.2f\n", name,
+        median * 1e-3, p99 * 1e-3, worst * 1e-3, worst / median);
+}
+
+/**
+ * Input signal, a tone decaying to silence
+ * i               Index of the frame
+ * x, n            Output samples, and count
+ * decay           Decay by sample, 0 for a tone followed by silence
+ */
+static void generate(int i, float *x, int n, float decay)
+{
+    for (int j = 0; j < n; j++) {
+        int k = i * n + j;
+        float g = decay > 0 ? powf(decay, (float)k) : k < 4 * n;
+
+        x[j] = g * sinf(2 * 3.14159265f * 1000 * k / SR_HZ);
+    }
+}
+
+/**
+ * Encode and decode the decaying signal, and time the frames
+ * decay           Decay by sample, 0 for a tone followed by silence
+ * plc             Number of frames lost at the end of the tone
+ * te, td          Time of encoding and decoding of frames, kept at minimum
+ */
+static void run(float decay, int plc, double *te, double *td)
+{
+    int ns = lc3_frame_samples(DT_US, SR_HZ);
+
+    void *enc_mem = malloc(lc3_encoder_size(DT_US, SR_HZ));
+    void *dec_mem = malloc(lc3_decoder_size(DT_US, SR_HZ));
+
+    lc3_encoder_t enc = lc3_setup_encoder(DT_US, SR_HZ, 0, enc_mem);
+    lc3_decoder_t dec = lc3_setup_decoder(DT_US, SR_HZ, 0, dec_mem);
+
+    float x[2 * 480], y[2 * 480];
+    uint8_t frame[NBYTES];
+
+    for (int i = 0; i < NFRAMES; i++) {
+        struct timespec t0;
+
+        generate(i, x, ns, decay);
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        lc3_encode(enc, LC3_PCM_FORMAT_FLOAT, x, 1, NBYTES, frame);
+        te[i] = fmin(te[i], elapsed_ns(&t0));
+
+        bool lost = i >= 4 && i < 4 + plc;
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        lc3_decode(dec, lost ? NULL : frame, NBYTES,
+            LC3_PCM_FORMAT_FLOAT, y, 1);
+        td[i] = fmin(td[i], elapsed_ns(&t0));
+    }
+
+    free(enc_mem);
+    free(dec_mem);
+}
+
+int main(void)
+{
+    static const struct {
+        const char *name;
+        float decay;
+        int plc;
+    } scenarios[] = {
+        { "fade-out"     , 0.999f ,  0 },
+        { "silence"      , 0      ,  0 },
+        { "concealment"  , 0      , 40 },
+    };
+
+    static double te[NFRAMES], td[NFRAMES];
+
+    printf("  %-24s %12s %12s %12s\n", "Scenario", "Median", "P99", "Worst");
+
+    for (int i = 0; i < (int)(sizeof(scenarios) / sizeof(*scenarios)); i++) {
+        char name[32];
+
+        for (int j = 0; j < NFRAMES; j++)
+            te[j] = td[j] = INFINITY;
+
+        for (int j = 0; j < NRUNS; j++)
+            run(scenarios[i].decay, scenarios[i].plc, te, td);
+
+        snprintf(name, sizeof(name), "%s encode", scenarios[i].name);
+        report(name, te + NWARMUP, NFRAMES - NWARMUP);
+
+        snprintf(name, sizeof(name), "%s decode", scenarios[i].name);
+        report(name, td + NWARMUP, NFRAMES - NWARMUP);
+    }
+
+    return 0;
+}
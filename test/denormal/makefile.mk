@@ -0,0 +1,30 @@
+#
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at:
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+bench_denormal_src += \
+    $(TEST_DIR)/denormal/bench_denormal.c
+
+bench_denormal_define += _POSIX_C_SOURCE=200112L
+bench_denormal_ldlibs += lc3 m
+bench_denormal_dependencies += liblc3
+
+$(eval $(call add-bin,bench_denormal))
+
+bench_denormal: $(bench_denormal_bin)
+	@echo "  RUN     $(notdir $<)"
+	$(V)LD_LIBRARY_PATH=$(BIN_DIR) $<
+
+bench: bench_denormal
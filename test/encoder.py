@@ -115,11 +115,103 @@ def check_appendix_c(dt):
 
     return ok
 
+def check_inspect(rng, dt, sr):
+
+    dt_us = int(T.DT_MS[dt] * 1000)
+    sr_hz = int(T.SRATE_KHZ[sr] * 1000)
+    ns = T.NS[dt][sr]
+
+    ### Harmonics of a gliding pitch, with bursts of noise
+
+    n = 40 * ns
+    t = np.arange(n) / sr_hz
+
+    phase = 2 * np.pi * np.cumsum(120 * 2 ** (t / t[-1])) / sr_hz
+    x = sum([ np.sin(k * phase) / k for k in range(1, 16) ])
+    x *= 0.2 + np.sin(2 * np.pi * 3 * t) ** 2
+
+    burst = (np.arange(n) // ns) % 7 == 3
+    x = 8000 * x + 4000 * burst * rng.standard_normal(n)
+    x = np.clip(x, -32768, 32767).astype(np.int16)
+
+    ### Inspected side data against the data of the encoder
+
+    enc_c = lc3.setup_encoder(dt_us, sr_hz)
+    ok = True
+
+    for i in range(n // ns):
+
+        nbytes = [ 20, 40, 80, 160, 400 ][i % 5]
+
+        (data, side, xq) = lc3.encode_side(enc_c, x[i*ns:(i+1)*ns], nbytes)
+        info = lc3.frame_inspect(dt_us, sr_hz, data)
+        if info is None:
+            return False
+
+        (spec, tns, ltpf, sns) = \
+            (side['spec'], side['tns'], side['ltpf'], side['sns'])
+
+        nf = lc3.spec_estimate_noise(dt, side['bw'], False, xq, spec['nq'])
+        nfilters = tns['nfilters']
+
+        ok = ok and info['bandwidth'] == T.SRATE_KHZ[side['bw']] * 1000
+        ok = ok and info['lastnz'] == spec['nq']
+        ok = ok and info['lsb_mode'] == spec['lsb_mode']
+        ok = ok and info['global_gain'] == spec['g_idx']
+        ok = ok and info['noise_factor'] == nf
+
+        ok = ok and info['tns_nfilters'] == nfilters
+        ok = ok and np.all(
+            info['tns_order'][:nfilters] == tns['rc_order'][:nfilters])
+
+        ok = ok and info['pitch_present'] == side['pitch_present']
+        ok = ok and info['ltpf_active'] == \
+            (side['pitch_present'] and ltpf['active'])
+        ok = ok and info['pitch_index'] == \
+            (ltpf['pitch_index'] if side['pitch_present'] else 0)
+
+        for k in ( 'lfcb', 'hfcb', 'shape', 'gain', 'idx_a', 'ls_a' ):
+            ok = ok and info['sns'][k] == sns[k]
+
+        if sns['shape'] == 0:
+            ok = ok and info['sns']['idx_b'] == sns['idx_b']
+            ok = ok and info['sns']['ls_b'] == sns['ls_b']
+
+    ### Malformed frames
+
+    ne = T.I[dt][sr][-1]
+    nbits_bw = bwdet.BandwidthDetector(dt, sr).get_nbits()
+    nbits_nq = np.ceil(np.log2(ne/2)).astype(int)
+
+    def set_bits(data, pos, nbits):
+        data = bytearray(data)
+        for i in range(pos, pos + nbits):
+            data[-1 - (i >> 3)] |= 1 << (i & 7)
+        return bytes(data)
+
+    ok = ok and lc3.frame_inspect(dt_us, sr_hz, data[:19]) is None
+    ok = ok and lc3.frame_inspect(dt_us, sr_hz, bytes(401)) is None
+
+    if (1 << nbits_bw) - 1 > sr:
+        ok = ok and lc3.frame_inspect(dt_us, sr_hz,
+            set_bits(data, 0, nbits_bw)) is None
+
+    if (2 << nbits_nq) > ne:
+        ok = ok and lc3.frame_inspect(dt_us, sr_hz,
+            set_bits(data, nbits_bw, nbits_nq)) is None
+
+    return ok
+
 def check():
 
+    rng = np.random.default_rng(1234)
     ok = True
 
     for dt in ( T.DT_7M5, T.DT_10M ):
         ok = ok and check_appendix_c(dt)
 
+    for dt in range(T.NUM_DT):
+        for sr in range(T.SRATE_8K, T.SRATE_48K + 1):
+            ok = ok and check_inspect(rng, dt, sr)
+
     return ok
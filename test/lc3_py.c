@@ -76,6 +76,47 @@ static PyObject *encode_py(PyObject *m, PyObject *args)
         PyBytes_FromStringAndSize((const char *)out, nbytes));
 }
 
+static PyObject *encode_side_py(PyObject *m, PyObject *args)
+{
+    PyObject *encoder_obj, *pcm_obj;
+    int nbytes;
+    int16_t *pcm;
+
+    if (!PyArg_ParseTuple(args, "OOi", &encoder_obj, &pcm_obj, &nbytes))
+        return NULL;
+
+    lc3_encoder_t encoder =
+        lc3_setup_encoder(10000, 48000, 0, &(lc3_encoder_mem_48k_t){ });
+
+    CTYPES_CHECK(NULL, encoder_obj = to_encoder(encoder_obj, encoder));
+
+    enum lc3_dt dt = encoder->dt;
+    enum lc3_srate sr = encoder->sr;
+    int ns = lc3_ns(dt, sr);
+
+    CTYPES_CHECK("x", pcm_obj = to_1d_ptr(pcm_obj, NPY_INT16, ns, &pcm));
+    CTYPES_CHECK("nbytes", nbytes >= 20 && nbytes <= 400);
+
+    uint8_t out[nbytes];
+    struct side_data side;
+
+    load_s16(encoder, pcm, 1);
+
+    analyze(encoder, nbytes, nbytes, 0, &side);
+
+    float *xq = encoder->x + encoder->xs_off;
+    PyObject *xq_obj = new_1d_copy(
+        NPY_FLOAT, lc3_ne(dt, (enum lc3_srate)side.bw), xq);
+
+    encode(dt, sr, &side, xq, nbytes, out);
+
+    from_encoder(encoder_obj, encoder);
+
+    return Py_BuildValue("NNN",
+        PyBytes_FromStringAndSize((const char *)out, nbytes),
+        new_side_data(&side), xq_obj);
+}
+
 static PyObject *setup_decoder_py(PyObject *m, PyObject *args)
 {
     int dt_us, sr_hz;
@@ -124,11 +165,32 @@ static PyObject *decode_py(PyObject *m, PyObject *args)
     return Py_BuildValue("N", pcm_obj);
 }
 
+static PyObject *frame_inspect_py(PyObject *m, PyObject *args)
+{
+    PyObject *in_obj;
+    int dt_us, sr_hz;
+
+    if (!PyArg_ParseTuple(args, "iiO", &dt_us, &sr_hz, &in_obj))
+        return NULL;
+
+    CTYPES_CHECK("in", PyBytes_Check(in_obj));
+
+    struct lc3_frame_info info;
+
+    if (lc3_frame_inspect(dt_us, sr_hz, PyBytes_AsString(in_obj),
+            PyBytes_Size(in_obj), &info) < 0)
+        Py_RETURN_NONE;
+
+    return Py_BuildValue("N", new_frame_info(&info));
+}
+
 static PyMethodDef methods[] = {
     { "setup_encoder"      , setup_encoder_py      , METH_VARARGS },
     { "encode"             , encode_py             , METH_VARARGS },
     { "setup_decoder"      , setup_decoder_py      , METH_VARARGS },
     { "decode"             , decode_py             , METH_VARARGS },
+    { "encode_side"        , encode_side_py        , METH_VARARGS },
+    { "frame_inspect"      , frame_inspect_py      , METH_VARARGS },
     { NULL },
 };
 
@@ -442,7 +442,8 @@ class LtpfSynthesis(Ltpf):
 def initial_state():
     return { 'active' : False, 'pitch': 0, 'nc':  np.zeros(2),
              'hp50' : initial_hp50_state(),
-             'x_12k8' : np.zeros(384), 'x_6k4' : np.zeros(178), 'tc' : 0 }
+             'x_12k8' : np.zeros(384), 'x_6k4' : np.zeros(178), 'tc' : 0,
+             'track' : False }
 
 def initial_sstate():
     return { 'active': False, 'pitch': 0,
@@ -537,6 +538,35 @@ def check_analysis(rng, dt, sr):
 
     return ok
 
+def check_analysis_tracking(dt, sr):
+
+    ns = T.NS[dt][sr]
+    nt = (5 * T.SRATE_KHZ[sr]) // 4
+    ok = True
+
+    state_c = initial_state()
+    state_t = initial_state()
+    state_t['track'] = True
+    x_c = np.zeros(ns+nt)
+
+    t = np.arange(50 * ns) / (T.SRATE_KHZ[sr] * 1000)
+    p = 2 * np.pi * np.cumsum(120 + 60 * t / t[-1]) / (T.SRATE_KHZ[sr] * 1000)
+    s = sum([ np.sin(k * p) / k for k in range(1, 6) ]) * 0.3
+
+    for i in range(50):
+
+        x = s[i*ns:(i+1)*ns] * (2 ** 15 - 1)
+        x_c = np.append(x_c[-nt:], x.astype(np.int16))
+
+        (pitch_present_c, data_c) = lc3.ltpf_analyse(dt, sr, state_c, x_c)
+        (pitch_present_t, data_t) = lc3.ltpf_analyse(dt, sr, state_t, x_c)
+
+        ok = ok and state_t['tc'] == state_c['tc']
+        ok = ok and pitch_present_t == pitch_present_c
+        ok = ok and data_t == data_c
+
+    return ok
+
 def check_synthesis(rng, dt, sr):
 
     ok = True
@@ -665,6 +695,7 @@ def check():
         for sr in range(T.SRATE_8K, T.SRATE_48K + 1):
             ok = ok and check_resampler(rng, dt, sr)
             ok = ok and check_analysis(rng, dt, sr)
+            ok = ok and check_analysis_tracking(dt, sr)
             ok = ok and check_synthesis(rng, dt, sr)
 
     for dt in ( T.DT_7M5, T.DT_10M ):
@@ -26,5 +26,11 @@ test-clean:
 
 -include $(TEST_DIR)/arm/makefile.mk
 -include $(TEST_DIR)/neon/makefile.mk
+-include $(TEST_DIR)/sse/makefile.mk
+-include $(TEST_DIR)/wasm/makefile.mk
+-include $(TEST_DIR)/simd/makefile.mk
+-include $(TEST_DIR)/denormal/makefile.mk
+-include $(TEST_DIR)/api/makefile.mk
+-include $(TEST_DIR)/tools/makefile.mk
 
 clean-all: test-clean
@@ -99,6 +99,59 @@ static int check_correlate()
     return 0;
 }
 
+static int check_synthesize()
+{
+    static void (* const neon_synthesize[])(const float *, int, int,
+        const float *, float *, int, const float *, int) =
+    {
+        [LC3_SRATE_8K ] = neon_synthesize_4,
+        [LC3_SRATE_16K] = neon_synthesize_4,
+        [LC3_SRATE_24K] = neon_synthesize_6,
+        [LC3_SRATE_32K] = neon_synthesize_8,
+        [LC3_SRATE_48K] = neon_synthesize_12,
+    };
+
+    float xh[1440], xh_neon[1440];
+    float c[2*MAX_FILTER_WIDTH], x0[MAX_FILTER_WIDTH];
+
+    for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_srate sr = LC3_SRATE_8K; sr <= LC3_SRATE_48K; sr++) {
+
+            int ns = lc3_ns(dt, sr), nh = ns + lc3_nh(dt, sr);
+            int w = LC3_MAX(4, lc3_ns_4m[sr] >> 4);
+
+            for (int i = 0; i < nh; i++)
+                xh[i] = (2 * (double)rand() / RAND_MAX) - 1;
+
+            for (int i = 0; i < w; i++) {
+                c[  i] = 0.4f * lc3_ltpf_cden[sr][rand() & 3][(w-1)-i];
+                c[w+i] = 0.85f * 0.4f * lc3_ltpf_cnum[sr][0][(w-1)-i];
+            }
+
+            for (int i = 0; i < w-1; i++)
+                x0[i] = (2 * (double)rand() / RAND_MAX) - 1;
+
+            memcpy(xh_neon, xh, nh * sizeof(*xh));
+
+            for (int fade = -1; fade <= 1; fade++)
+                for (int i = 0; i + ns <= nh; i += ns) {
+                    int pitch = 4*32 + rand() % (4*(228-32));
+                    pitch = (pitch * lc3_ns(LC3_DT_10M, sr) + 64) / 128;
+
+                    synthesize[sr](xh, nh, pitch/4,
+                        x0, xh + i, ns, c, fade);
+                    neon_synthesize[sr](xh_neon, nh, pitch/4,
+                        x0, xh_neon + i, ns, c, fade);
+                }
+
+            for (int i = 0; i < nh; i++)
+                if (fabsf(xh[i] - xh_neon[i]) > 1e-5f)
+                    return -1;
+        }
+
+    return 0;
+}
+
 int check_ltpf(void)
 {
     int ret;
@@ -112,5 +165,8 @@ int check_ltpf(void)
     if ((ret = check_correlate()) < 0)
         return ret;
 
+    if ((ret = check_synthesize()) < 0)
+        return ret;
+
     return 0;
 }
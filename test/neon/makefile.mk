@@ -18,6 +18,10 @@ test_neon_src += \
     $(TEST_DIR)/neon/test_neon.c \
     $(TEST_DIR)/neon/ltpf_neon.c \
     $(TEST_DIR)/neon/mdct_neon.c \
+    $(TEST_DIR)/neon/pcm_neon.c \
+    $(TEST_DIR)/neon/sns_neon.c \
+    $(TEST_DIR)/neon/spec_neon.c \
+    $(TEST_DIR)/neon/tns_neon.c \
     $(SRC_DIR)/tables.c
 
 test_neon_include += $(SRC_DIR)
@@ -63,6 +63,94 @@ static int check_fft(void)
     return 0;
 }
 
+static int check_near(const float *a, const float *b, int n)
+{
+    for (int i = 0; i < n; i++)
+        if (fabsf(a[i] - b[i]) > 1e-5f * (1 + fabsf(a[i])))
+            return -1;
+
+    return 0;
+}
+
+static int check_window(void)
+{
+    float x[LC3_MAX_NS], y[LC3_MAX_NS], y_neon[LC3_MAX_NS];
+    float d[LC3_MAX_NS], d_neon[LC3_MAX_NS];
+
+    for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_srate sr = 0; sr < LC3_NUM_SRATE; sr++) {
+            int ns = lc3_ns(dt, sr), nd = lc3_nd(dt, sr);
+            if (!lc3_mdct_win[dt][sr])
+                continue;
+
+            for (int i = 0; i < ns; i++) {
+                x[i] = (2 * (double)rand() / RAND_MAX) - 1;
+                d[i] = d_neon[i] = (2 * (double)rand() / RAND_MAX) - 1;
+            }
+
+            mdct_window(dt, sr, x, d, y);
+            neon_mdct_window(dt, sr, x, d_neon, y_neon);
+            if (check_near(y, y_neon, ns) < 0 ||
+                check_near(d, d_neon, nd) < 0   )
+                return -1;
+
+            imdct_window(dt, sr, x, d, y);
+            neon_imdct_window(dt, sr, x, d_neon, y_neon);
+            if (check_near(y, y_neon, nd) < 0 ||
+                check_near(d, d_neon, nd) < 0   )
+                return -1;
+        }
+
+    return 0;
+}
+
+static int check_rotation(void)
+{
+    float x[LC3_MAX_NS];
+    struct lc3_complex y[LC3_MAX_NS/2], y_neon[LC3_MAX_NS/2];
+    float z[LC3_MAX_NS], z_neon[LC3_MAX_NS];
+
+    for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_srate sr = 0; sr < LC3_NUM_SRATE; sr++) {
+            const struct lc3_mdct_rot_def *rot = lc3_mdct_rot[dt][sr];
+            if (!rot)
+                continue;
+
+            int n4 = rot->n4;
+
+            for (int i = 0; i < 2*n4; i++)
+                x[i] = (2 * (double)rand() / RAND_MAX) - 1;
+
+            mdct_pre_fft(rot, x, y);
+            neon_mdct_pre_fft(rot, x, y_neon);
+            if (check_near((float *)y, (float *)y_neon, 2*n4) < 0)
+                return -1;
+
+            mdct_post_fft(rot, y, z);
+            neon_mdct_post_fft(rot, y, z_neon);
+            if (check_near(z, z_neon, 2*n4) < 0)
+                return -1;
+
+            imdct_pre_fft(rot, x, y);
+            neon_imdct_pre_fft(rot, x, y_neon);
+            if (check_near((float *)y, (float *)y_neon, 2*n4) < 0)
+                return -1;
+
+            imdct_post_fft(rot, y, z);
+            neon_imdct_post_fft(rot, y, z_neon);
+            if (check_near(z, z_neon, 2*n4) < 0)
+                return -1;
+
+            memcpy(y_neon, x, 2*n4 * sizeof(float));
+            neon_mdct_pre_fft(rot, (float *)y_neon, y_neon);
+            mdct_pre_fft(rot, x, y);
+            if (check_near((float *)y, (float *)y_neon, 2*n4) < 0)
+                return -1;
+        }
+
+    return 0;
+}
+
 int check_mdct(void)
 {
     int ret;
@@ -70,5 +158,11 @@ int check_mdct(void)
     if ((ret = check_fft()) < 0)
         return ret;
 
+    if ((ret = check_window()) < 0)
+        return ret;
+
+    if ((ret = check_rotation()) < 0)
+        return ret;
+
     return 0;
 }
@@ -23,6 +23,8 @@
 #else
 
 #include <stdint.h>
+#include <string.h>
+#include <math.h>
 
 
 /* ----------------------------------------------------------------------------
@@ -35,6 +37,9 @@ typedef struct { int16_t e[8]; } int16x8_t;
 typedef struct { int32_t e[4]; } int32x4_t;
 typedef struct { int64_t e[2]; } int64x2_t;
 
+typedef struct { uint32_t e[4]; } uint32x4_t;
+typedef struct { uint64_t e[2]; } uint64x2_t;
+
 
 /**
  * Load / Store
@@ -46,6 +51,37 @@ static int16x4_t vld1_s16(const int16_t *p)
     return (int16x4_t){ { p[0], p[1], p[2], p[3] } };
 }
 
+__attribute__((unused))
+static int16x8_t vld1q_s16(const int16_t *p)
+{
+    return (int16x8_t){ { p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7] } };
+}
+
+__attribute__((unused))
+static uint32x4_t vld1q_u32(const uint32_t *p)
+{
+    return (uint32x4_t){ { p[0], p[1], p[2], p[3] } };
+}
+
+__attribute__((unused))
+static void vst1q_s16(int16_t *p, int16x8_t v)
+{
+    for (int i = 0; i < 8; i++)
+        p[i] = v.e[i];
+}
+
+__attribute__((unused))
+static void vst1q_s32(int32_t *p, int32x4_t v)
+{
+    p[0] = v.e[0], p[1] = v.e[1], p[2] = v.e[2], p[3] = v.e[3];
+}
+
+__attribute__((unused))
+static void vst1q_u32(uint32_t *p, uint32x4_t v)
+{
+    p[0] = v.e[0], p[1] = v.e[1], p[2] = v.e[2], p[3] = v.e[3];
+}
+
 
 /**
  * Arithmetic
@@ -61,9 +97,12 @@ static int32x4_t vmull_s16(int16x4_t a, int16x4_t b)
 __attribute__((unused))
 static int32x4_t vmlal_s16(int32x4_t r, int16x4_t a, int16x4_t b)
 {
-    return (int32x4_t){ {
-        r.e[0] + a.e[0] * b.e[0], r.e[1] + a.e[1] * b.e[1],
-        r.e[2] + a.e[2] * b.e[2], r.e[3] + a.e[3] * b.e[3] } };
+    int32x4_t d;
+
+    for (int i = 0; i < 4; i++)
+        d.e[i] = (int32_t)((uint32_t)r.e[i] + (uint32_t)(a.e[i] * b.e[i]));
+
+    return d;
 }
 
 __attribute__((unused))
@@ -77,6 +116,55 @@ static int64x2_t vpadalq_s32(int64x2_t a, int32x4_t b)
     return r;
 }
 
+__attribute__((unused))
+static int32x4_t vaddq_s32(int32x4_t a, int32x4_t b)
+{
+    return (int32x4_t){ { a.e[0] + b.e[0], a.e[1] + b.e[1],
+                          a.e[2] + b.e[2], a.e[3] + b.e[3] } };
+}
+
+__attribute__((unused))
+static int32x4_t vsubq_s32(int32x4_t a, int32x4_t b)
+{
+    return (int32x4_t){ { a.e[0] - b.e[0], a.e[1] - b.e[1],
+                          a.e[2] - b.e[2], a.e[3] - b.e[3] } };
+}
+
+__attribute__((unused))
+static uint32x4_t vaddq_u32(uint32x4_t a, uint32x4_t b)
+{
+    return (uint32x4_t){ { a.e[0] + b.e[0], a.e[1] + b.e[1],
+                           a.e[2] + b.e[2], a.e[3] + b.e[3] } };
+}
+
+__attribute__((unused))
+static uint32x4_t vsubq_u32(uint32x4_t a, uint32x4_t b)
+{
+    return (uint32x4_t){ { a.e[0] - b.e[0], a.e[1] - b.e[1],
+                           a.e[2] - b.e[2], a.e[3] - b.e[3] } };
+}
+
+__attribute__((unused))
+static uint32x4_t vmulq_u32(uint32x4_t a, uint32x4_t b)
+{
+    return (uint32x4_t){ { a.e[0] * b.e[0], a.e[1] * b.e[1],
+                           a.e[2] * b.e[2], a.e[3] * b.e[3] } };
+}
+
+__attribute__((unused))
+static uint32x4_t vandq_u32(uint32x4_t a, uint32x4_t b)
+{
+    return (uint32x4_t){ { a.e[0] & b.e[0], a.e[1] & b.e[1],
+                           a.e[2] & b.e[2], a.e[3] & b.e[3] } };
+}
+
+__attribute__((unused))
+static uint32x4_t vshrq_n_u32(uint32x4_t a, const int n)
+{
+    return (uint32x4_t){ { a.e[0] >> n, a.e[1] >> n,
+                           a.e[2] >> n, a.e[3] >> n } };
+}
+
 
 /**
  * Reduce
@@ -88,6 +176,12 @@ static int32_t vaddvq_s32(int32x4_t v)
     return v.e[0] + v.e[1] + v.e[2] + v.e[3];
 }
 
+__attribute__((unused))
+static uint32_t vaddvq_u32(uint32x4_t v)
+{
+    return v.e[0] + v.e[1] + v.e[2] + v.e[3];
+}
+
 __attribute__((unused))
 static int64_t vaddvq_s64(int64x2_t v)
 {
@@ -114,6 +208,12 @@ static int32x4_t vmovq_n_s32(uint32_t v)
     return (int32x4_t){ { v, v, v, v } };
 }
 
+__attribute__((unused))
+static uint32x4_t vmovq_n_u32(uint32_t v)
+{
+    return (uint32x4_t){ { v, v, v, v } };
+}
+
 __attribute__((unused))
 static int64x2_t vmovq_n_s64(int64_t v)
 {
@@ -121,6 +221,68 @@ static int64x2_t vmovq_n_s64(int64_t v)
 }
 
 
+/**
+ * Conversion
+ */
+
+__attribute__((unused))
+static int16x4_t vget_low_s16(int16x8_t a)
+{
+    return (int16x4_t){ { a.e[0], a.e[1], a.e[2], a.e[3] } };
+}
+
+__attribute__((unused))
+static int16x4_t vget_high_s16(int16x8_t a)
+{
+    return (int16x4_t){ { a.e[4], a.e[5], a.e[6], a.e[7] } };
+}
+
+__attribute__((unused))
+static int16x8_t vcombine_s16(int16x4_t a, int16x4_t b)
+{
+    return (int16x8_t){ { a.e[0], a.e[1], a.e[2], a.e[3],
+                          b.e[0], b.e[1], b.e[2], b.e[3] } };
+}
+
+__attribute__((unused))
+static int32x4_t vmovl_s16(int16x4_t a)
+{
+    return (int32x4_t){ { a.e[0], a.e[1], a.e[2], a.e[3] } };
+}
+
+__attribute__((unused))
+static int16x4_t vqmovn_s32(int32x4_t a)
+{
+    int16x4_t r;
+
+    for (int i = 0; i < 4; i++)
+        r.e[i] = a.e[i] > INT16_MAX ? INT16_MAX :
+                 a.e[i] < INT16_MIN ? INT16_MIN : a.e[i];
+
+    return r;
+}
+
+__attribute__((unused))
+static int32x4_t vreinterpretq_s32_u32(uint32x4_t a)
+{
+    return (int32x4_t){ { (int32_t)a.e[0], (int32_t)a.e[1],
+                          (int32_t)a.e[2], (int32_t)a.e[3] } };
+}
+
+__attribute__((unused))
+static uint64x2_t vreinterpretq_u64_u32(uint32x4_t a)
+{
+    return (uint64x2_t){ { a.e[0] | (uint64_t)a.e[1] << 32,
+                           a.e[2] | (uint64_t)a.e[3] << 32 } };
+}
+
+__attribute__((unused))
+static uint64_t vgetq_lane_u64(uint64x2_t v, const int i)
+{
+    return v.e[i];
+}
+
+
 
 /* ----------------------------------------------------------------------------
  *  Floating Point
@@ -131,6 +293,7 @@ typedef struct { float e[4]; } float32x4_t;
 
 typedef struct { float32x2_t val[2]; } float32x2x2_t;
 typedef struct { float32x4_t val[2]; } float32x4x2_t;
+typedef struct { float32x4_t val[4]; } float32x4x4_t;
 
 
 /**
@@ -181,6 +344,34 @@ static void vst1q_f32(float *p, float32x4_t v)
     p[0] = v.e[0], p[1] = v.e[1], p[2] = v.e[2], p[3] = v.e[3];
 }
 
+__attribute__((unused))
+static float32x4x4_t vld4q_f32(const float *p)
+{
+    float32x4x4_t r;
+
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            r.val[j].e[i] = p[4*i + j];
+
+    return r;
+}
+
+__attribute__((unused))
+static void vst2q_f32(float *p, float32x4x2_t v)
+{
+    for (int i = 0; i < 4; i++)
+        p[2*i + 0] = v.val[0].e[i], p[2*i + 1] = v.val[1].e[i];
+}
+
+__attribute__((unused))
+static void vst4q_f32(float *p, float32x4x4_t v)
+{
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            p[4*i + j] = v.val[j].e[i];
+}
+
+
 /**
  * Arithmetic
  */
@@ -215,30 +406,72 @@ __attribute__((unused))
 static float32x2_t vfma_f32(float32x2_t a, float32x2_t b, float32x2_t c)
 {
     return (float32x2_t){ {
-        a.e[0] + b.e[0] * c.e[0], a.e[1] + b.e[1] * c.e[1] } };
+        fmaf(b.e[0], c.e[0], a.e[0]), fmaf(b.e[1], c.e[1], a.e[1]) } };
 }
 
 __attribute__((unused))
 static float32x4_t vfmaq_f32(float32x4_t a, float32x4_t b, float32x4_t c)
 {
     return (float32x4_t){ {
-        a.e[0] + b.e[0] * c.e[0], a.e[1] + b.e[1] * c.e[1],
-        a.e[2] + b.e[2] * c.e[2], a.e[3] + b.e[3] * c.e[3] } };
+        fmaf(b.e[0], c.e[0], a.e[0]), fmaf(b.e[1], c.e[1], a.e[1]),
+        fmaf(b.e[2], c.e[2], a.e[2]), fmaf(b.e[3], c.e[3], a.e[3]) } };
 }
 
 __attribute__((unused))
 static float32x2_t vfms_f32(float32x2_t a, float32x2_t b, float32x2_t c)
 {
     return (float32x2_t){ {
-        a.e[0] - b.e[0] * c.e[0], a.e[1] - b.e[1] * c.e[1] } };
+        fmaf(-b.e[0], c.e[0], a.e[0]), fmaf(-b.e[1], c.e[1], a.e[1]) } };
 }
 
 __attribute__((unused))
 static float32x4_t vfmsq_f32(float32x4_t a, float32x4_t b, float32x4_t c)
 {
     return (float32x4_t){ {
-        a.e[0] - b.e[0] * c.e[0], a.e[1] - b.e[1] * c.e[1],
-        a.e[2] - b.e[2] * c.e[2], a.e[3] - b.e[3] * c.e[3] } };
+        fmaf(-b.e[0], c.e[0], a.e[0]), fmaf(-b.e[1], c.e[1], a.e[1]),
+        fmaf(-b.e[2], c.e[2], a.e[2]), fmaf(-b.e[3], c.e[3], a.e[3]) } };
+}
+
+__attribute__((unused))
+static float32x4_t vmulq_f32(float32x4_t a, float32x4_t b)
+{
+    return (float32x4_t){ { a.e[0] * b.e[0], a.e[1] * b.e[1],
+                            a.e[2] * b.e[2], a.e[3] * b.e[3] } };
+}
+
+__attribute__((unused))
+static float32x4_t vmulq_n_f32(float32x4_t a, float b)
+{
+    return (float32x4_t){ { a.e[0] * b, a.e[1] * b,
+                            a.e[2] * b, a.e[3] * b } };
+}
+
+__attribute__((unused))
+static float32x4_t vfmaq_n_f32(float32x4_t a, float32x4_t b, float c)
+{
+    return (float32x4_t){ { a.e[0] + b.e[0] * c, a.e[1] + b.e[1] * c,
+                            a.e[2] + b.e[2] * c, a.e[3] + b.e[3] * c } };
+}
+
+__attribute__((unused))
+static float32x4_t vabsq_f32(float32x4_t a)
+{
+    return (float32x4_t){ { fabsf(a.e[0]), fabsf(a.e[1]),
+                            fabsf(a.e[2]), fabsf(a.e[3]) } };
+}
+
+__attribute__((unused))
+static float32x4_t vmaxq_f32(float32x4_t a, float32x4_t b)
+{
+    return (float32x4_t){ { fmaxf(a.e[0], b.e[0]), fmaxf(a.e[1], b.e[1]),
+                            fmaxf(a.e[2], b.e[2]), fmaxf(a.e[3], b.e[3]) } };
+}
+
+__attribute__((unused))
+static float32x4_t vminq_f32(float32x4_t a, float32x4_t b)
+{
+    return (float32x4_t){ { fminf(a.e[0], b.e[0]), fminf(a.e[1], b.e[1]),
+                            fminf(a.e[2], b.e[2]), fminf(a.e[3], b.e[3]) } };
 }
 
 
@@ -271,6 +504,15 @@ static float32x2_t vget_high_f32(float32x4_t a)
     return (float32x2_t){ { a.e[2], a.e[3] } };
 }
 
+__attribute__((unused))
+static float32x4_t vextq_f32(float32x4_t a, float32x4_t b, const int n)
+{
+    float x[] = { a.e[0], a.e[1], a.e[2], a.e[3],
+                  b.e[0], b.e[1], b.e[2], b.e[3] };
+
+    return (float32x4_t){ { x[n], x[n+1], x[n+2], x[n+3] } };
+}
+
 __attribute__((unused))
 static float32x4_t vmovq_n_f32(float v)
 {
@@ -326,4 +568,101 @@ static float32x4_t vzip2q_f32(float32x4_t a, float32x4_t b)
 }
 
 
+/**
+ * Reduce
+ */
+
+__attribute__((unused))
+static float vaddvq_f32(float32x4_t v)
+{
+    return (v.e[0] + v.e[1]) + (v.e[2] + v.e[3]);
+}
+
+__attribute__((unused))
+static float vmaxvq_f32(float32x4_t v)
+{
+    return fmaxf(fmaxf(v.e[0], v.e[1]), fmaxf(v.e[2], v.e[3]));
+}
+
+
+/**
+ * Comparison
+ */
+
+__attribute__((unused))
+static uint32x4_t vcgeq_f32(float32x4_t a, float32x4_t b)
+{
+    return (uint32x4_t){ { -(uint32_t)(a.e[0] >= b.e[0]),
+                           -(uint32_t)(a.e[1] >= b.e[1]),
+                           -(uint32_t)(a.e[2] >= b.e[2]),
+                           -(uint32_t)(a.e[3] >= b.e[3]) } };
+}
+
+__attribute__((unused))
+static uint32x4_t vcltq_f32(float32x4_t a, float32x4_t b)
+{
+    return (uint32x4_t){ { -(uint32_t)(a.e[0] < b.e[0]),
+                           -(uint32_t)(a.e[1] < b.e[1]),
+                           -(uint32_t)(a.e[2] < b.e[2]),
+                           -(uint32_t)(a.e[3] < b.e[3]) } };
+}
+
+__attribute__((unused))
+static float32x4_t vbslq_f32(uint32x4_t m, float32x4_t a, float32x4_t b)
+{
+    float32x4_t r;
+
+    for (int i = 0; i < 4; i++)
+        r.e[i] = m.e[i] ? a.e[i] : b.e[i];
+
+    return r;
+}
+
+
+/**
+ * Conversion
+ */
+
+__attribute__((unused))
+static float vgetq_lane_f32(float32x4_t v, const int i)
+{
+    return v.e[i];
+}
+
+__attribute__((unused))
+static float32x4_t vcvtq_f32_s32(int32x4_t a)
+{
+    return (float32x4_t){ { (float)a.e[0], (float)a.e[1],
+                            (float)a.e[2], (float)a.e[3] } };
+}
+
+__attribute__((unused))
+static int32x4_t vcvtq_s32_f32(float32x4_t a)
+{
+    int32x4_t r;
+
+    for (int i = 0; i < 4; i++)
+        r.e[i] = a.e[i] >= 0x1p31f ? INT32_MAX :
+                 a.e[i] < -0x1p31f ? INT32_MIN : (int32_t)a.e[i];
+
+    return r;
+}
+
+__attribute__((unused))
+static uint32x4_t vreinterpretq_u32_f32(float32x4_t a)
+{
+    uint32x4_t r;
+    memcpy(r.e, a.e, sizeof(r.e));
+    return r;
+}
+
+__attribute__((unused))
+static float32x4_t vreinterpretq_f32_u32(uint32x4_t a)
+{
+    float32x4_t r;
+    memcpy(r.e, a.e, sizeof(r.e));
+    return r;
+}
+
+
 #endif /* __ARM_NEON */
@@ -0,0 +1,70 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "neon.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_NEON
+#include <sns.c>
+
+/* -------------------------------------------------------------------------- */
+
+static int check_spectral_shaping(void)
+{
+    float x[LC3_MAX_NE], y[LC3_MAX_NE], y_neon[LC3_MAX_NE];
+    float scf_q[16];
+
+    for (int i = 0; i < LC3_MAX_NE; i++)
+        x[i] = (2 * (double)rand() / RAND_MAX) - 1;
+
+    for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_srate sr = 0; sr < LC3_NUM_SRATE; sr++) {
+            if (!lc3_band_lim[dt][sr])
+                continue;
+
+            for (int k = 0; k < 4; k++) {
+                bool inv = k & 1;
+                int ne = lc3_ne(dt, sr);
+
+                for (int i = 0; i < 16; i++)
+                    scf_q[i] = (16 * (double)rand() / RAND_MAX) - 8;
+
+                spectral_shaping(dt, sr, scf_q, inv, x, y);
+                neon_spectral_shaping(dt, sr, scf_q, inv, x, y_neon);
+                if (memcmp(y, y_neon, ne * sizeof(*y)) != 0)
+                    return -1;
+            }
+        }
+
+    return 0;
+}
+
+int check_sns(void)
+{
+    int ret;
+
+    if ((ret = check_spectral_shaping()) < 0)
+        return ret;
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "neon.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_NEON
+#include <spec.c>
+
+int lc3_get_bits_left(const lc3_bits_t *a) { return (void)a, 0; }
+
+int lc3_bwdet_get_nbits(enum lc3_srate a) { return (void)a, 0; }
+
+/* -------------------------------------------------------------------------- */
+
+static void generate_spectrum(float *x, int n, float scale)
+{
+    for (int i = 0; i < n; i++) {
+        float v = (2 * (double)rand() / RAND_MAX) - 1;
+        x[i] = (rand() % 4 ? v * v * v : v) * scale;
+    }
+}
+
+static int check_energy(void)
+{
+    float x[LC3_MAX_NE];
+    float e[LC3_MAX_NE / 4], e_neon[LC3_MAX_NE / 4];
+    int32_t e_db[LC3_MAX_NE / 4], e_db_neon[LC3_MAX_NE / 4];
+
+    for (int n4 = 1; n4 <= LC3_MAX_NE / 4; n4 += 13) {
+        generate_spectrum(x, 4*n4, 1 << (rand() % 16));
+
+        float x2_max = compute_energy4(x, n4, e);
+        float x2_max_neon = neon_compute_energy4(x, n4, e_neon);
+        if (x2_max != x2_max_neon ||
+                memcmp(e, e_neon, n4 * sizeof(*e)) != 0)
+            return -1;
+
+        float nf = n4 % 2 ? 0 : sqrtf(x2_max) * 1e-3f;
+
+        convert_energy_db(e, n4, nf, e_db);
+        neon_convert_energy_db(e, n4, nf, e_db_neon);
+        if (memcmp(e_db, e_db_neon, n4 * sizeof(*e_db)) != 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+static int check_quantization(void)
+{
+    float x[LC3_MAX_NE], y[LC3_MAX_NE], y_neon[LC3_MAX_NE];
+
+    for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_srate sr = 0; sr < LC3_NUM_SRATE; sr++) {
+            int ne = lc3_ne(dt, sr);
+            if (!ne)
+                continue;
+
+            for (int g_int = -30; g_int < 60; g_int += 7) {
+                int n, n_neon;
+
+                generate_spectrum(x, ne, 1000);
+                for (int i = ne - 2 * (rand() % (ne/2)); i < ne; i++)
+                    x[i] *= 1e-4f;
+
+                memcpy(y, x, ne * sizeof(*x));
+                memcpy(y_neon, x, ne * sizeof(*x));
+
+                quantize(dt, sr, g_int, y, &n);
+                neon_quantize(dt, sr, g_int, y_neon, &n_neon);
+                if (n != n_neon || memcmp(y, y_neon, ne * sizeof(*y)) != 0)
+                    return -1;
+
+                float g = unquantize(dt, sr, g_int, y, n);
+                float g_neon = neon_unquantize(dt, sr, g_int, y_neon, n);
+                if (g != g_neon || memcmp(y, y_neon, ne * sizeof(*y)) != 0)
+                    return -1;
+            }
+        }
+
+    return 0;
+}
+
+static int check_noise(void)
+{
+    float x[LC3_MAX_NE];
+
+    for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_bandwidth bw = 0; bw < LC3_NUM_BANDWIDTH; bw++) {
+            int ne = lc3_ne(dt, (enum lc3_srate)bw);
+            if (!ne)
+                continue;
+
+            for (int k = 0; k < 10; k++) {
+                bool hrmode = k & 1;
+                int n = 2 * (rand() % (ne/2 + 1));
+
+                generate_spectrum(x, ne, 0.5f + k * 0.1f);
+
+                if (estimate_noise(dt, bw, hrmode, x, n) !=
+                        neon_estimate_noise(dt, bw, hrmode, x, n))
+                    return -1;
+            }
+        }
+
+    return 0;
+}
+
+int check_spec(void)
+{
+    int ret;
+
+    if ((ret = check_energy()) < 0)
+        return ret;
+
+    if ((ret = check_quantization()) < 0)
+        return ret;
+
+    if ((ret = check_noise()) < 0)
+        return ret;
+
+    return 0;
+}
@@ -20,6 +20,10 @@
 
 int check_ltpf(void);
 int check_mdct(void);
+int check_pcm(void);
+int check_sns(void);
+int check_spec(void);
+int check_tns(void);
 
 int main()
 {
@@ -33,5 +37,21 @@ int main()
     printf("%s\n", (r = check_mdct()) == 0 ? "OK" : "Failed");
     ret = ret || r;
 
+    printf("Checking PCM Neon... "); fflush(stdout);
+    printf("%s\n", (r = check_pcm()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking SNS Neon... "); fflush(stdout);
+    printf("%s\n", (r = check_sns()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking Spectral Neon... "); fflush(stdout);
+    printf("%s\n", (r = check_spec()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking TNS Neon... "); fflush(stdout);
+    printf("%s\n", (r = check_tns()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
     return ret;
 }
@@ -0,0 +1,76 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "check.h"
+
+#include <stdio.h>
+#include <stdalign.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#include <attdet.c>
+
+/* -------------------------------------------------------------------------- */
+
+static int check_energy(void)
+{
+    typedef void (*compute_energy_t)(
+        enum lc3_srate, const int16_t *, int, int32_t *);
+
+    static const struct {
+        const char *name; compute_energy_t ref, fn; int ulp;
+    } variants[] = {
+        VARIANT(compute_energy, arm_compute_energy, 0),
+        VARIANT(compute_energy, sse_compute_energy, 0),
+    };
+
+    static int16_t alignas(4) __x[6+480];
+    int16_t *x = __x + 6;
+
+    for (int iv = 0; iv < NUM_VARIANTS(variants); iv++)
+        for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+            generate_s16(__x, 6+480, p);
+
+            for (int nblk = 1; nblk <= 4; nblk++) {
+                int32_t e[4], e_simd[4];
+
+                variants[iv].ref(LC3_SRATE_32K, x, nblk, e);
+                variants[iv].fn(LC3_SRATE_32K, x, nblk, e_simd);
+                if (memcmp(e, e_simd, nblk * sizeof(*e)) != 0)
+                    return report(variants[iv].name, p);
+
+                variants[iv].ref(LC3_SRATE_48K, x, nblk, e);
+                variants[iv].fn(LC3_SRATE_48K, x, nblk, e_simd);
+                if (memcmp(e, e_simd, nblk * sizeof(*e)) != 0)
+                    return report(variants[iv].name, p);
+            }
+        }
+
+    return 0;
+}
+
+int check_attdet(void)
+{
+    int ret;
+
+    if ((ret = check_energy()) < 0)
+        return ret;
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+
+void generate_s16(int16_t *x, int n, enum pattern pattern)
+{
+    for (int i = 0; i < n; i++)
+        switch (pattern) {
+        case PATTERN_RANDOM   : x[i] = rand() & 0xffff; break;
+        case PATTERN_ZERO     : x[i] = 0; break;
+        case PATTERN_MAX      : x[i] = INT16_MAX; break;
+        case PATTERN_MIN      : x[i] = INT16_MIN; break;
+        case PATTERN_ALTERNATE: x[i] = i & 1 ? INT16_MIN : INT16_MAX; break;
+        case PATTERN_IMPULSE  :
+            x[i] = rand() % 16 ? 0 : rand() & 1 ? INT16_MIN : INT16_MAX;
+            break;
+        case PATTERN_SMALL    : x[i] = rand() % 3 - 1; break;
+        default: break;
+        }
+}
+
+void generate_f32(float *x, int n, float scale, enum pattern pattern)
+{
+    for (int i = 0; i < n; i++) {
+        float v = (2 * (double)rand() / RAND_MAX) - 1;
+
+        switch (pattern) {
+        case PATTERN_RANDOM   : x[i] = v * scale; break;
+        case PATTERN_ZERO     : x[i] = 0; break;
+        case PATTERN_MAX      : x[i] = scale; break;
+        case PATTERN_MIN      : x[i] = -scale; break;
+        case PATTERN_ALTERNATE: x[i] = i & 1 ? -scale : scale; break;
+        case PATTERN_IMPULSE  :
+            x[i] = rand() % 16 ? 0 : rand() & 1 ? -scale : scale;
+            break;
+        case PATTERN_SMALL    : x[i] = v * FLT_MIN; break;
+        default: break;
+        }
+    }
+}
+
+int check_ulp(const float *ref, const float *x, int n, int ulp)
+{
+    if (!ulp)
+        return memcmp(ref, x, n * sizeof(*x)) ? -1 : 0;
+
+    float ref_max = 0;
+    for (int i = 0; i < n; i++)
+        ref_max = fmaxf(ref_max, fabsf(ref[i]));
+
+    float tol = ulp * (nextafterf(ref_max, INFINITY) - ref_max);
+    tol = fmaxf(tol, FLT_MIN);
+
+    for (int i = 0; i < n; i++)
+        if (!(fabsf(x[i] - ref[i]) <= tol))
+            return -1;
+
+    return 0;
+}
+
+int report(const char *name, enum pattern pattern)
+{
+    static const char *pattern_str[] = {
+        [PATTERN_RANDOM   ] = "random",
+        [PATTERN_ZERO     ] = "zero",
+        [PATTERN_MAX      ] = "max",
+        [PATTERN_MIN      ] = "min",
+        [PATTERN_ALTERNATE] = "alternate",
+        [PATTERN_IMPULSE  ] = "impulse",
+        [PATTERN_SMALL    ] = "small",
+    };
+
+    printf("%s (%s) ", name, pattern_str[pattern]);
+    return -1;
+}
@@ -0,0 +1,106 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#ifndef __CHECK_H
+#define __CHECK_H
+
+/**
+ * All the variants of the kernels are compiled in a same translation unit,
+ * along with the generic one. The variants that cannot run natively on
+ * the host are emulated.
+ */
+
+#include "sse.h"
+#include "neon.h"
+#include "simd32.h"
+#include "wasm.h"
+
+#define TEST_SSE
+#define TEST_NEON
+#define TEST_ARM
+#define TEST_WASM
+
+#include <stdint.h>
+
+
+/**
+ * Random and adversarial inputs
+ *
+ * PATTERN_RANDOM     Uniform random values
+ * PATTERN_ZERO       Null values
+ * PATTERN_MAX        Saturating positive values
+ * PATTERN_MIN        Saturating negative values
+ * PATTERN_ALTERNATE  Saturating values of alternating sign
+ * PATTERN_IMPULSE    Sparse saturating values
+ * PATTERN_SMALL      Values close to 0 (Subnormals for float)
+ */
+enum pattern {
+    PATTERN_RANDOM,
+    PATTERN_ZERO,
+    PATTERN_MAX,
+    PATTERN_MIN,
+    PATTERN_ALTERNATE,
+    PATTERN_IMPULSE,
+    PATTERN_SMALL,
+
+    PATTERN_NUM
+};
+
+/**
+ * Generate a vector of samples
+ * x, n            Output vector of `n` values
+ * scale           Full-scale value of floating point samples
+ * pattern         Pattern of the generated values
+ */
+void generate_s16(int16_t *x, int n, enum pattern pattern);
+void generate_f32(float *x, int n, float scale, enum pattern pattern);
+
+/**
+ * Compare a vector with its reference
+ * ref, x, n       Reference and vector to check, of size `n`
+ * ulp             Tolerance, 0 for bit-exactness
+ * return          0: Match  -1: Mismatch
+ *
+ * The tolerance is expressed in units in the last place of the greatest
+ * magnitude of the reference vector. When a tolerance is declared, the
+ * differences below the smallest normal value are not significant.
+ */
+int check_ulp(const float *ref, const float *x, int n, int ulp);
+
+/**
+ * Report a mismatch of a kernel variant
+ * name            Name of the variant
+ * pattern         Pattern of the input
+ * return          -1
+ */
+int report(const char *name, enum pattern pattern);
+
+/**
+ * Declare a variant of a kernel
+ * ref, fn         Generic reference and variant of the kernel
+ * ulp             Declared tolerance, 0 for bit-exactness
+ */
+#define VARIANT(ref, fn, ulp) { #fn, ref, fn, ulp }
+
+/**
+ * Number of variants of a kernel
+ */
+#define NUM_VARIANTS(v) ( (int)(sizeof(v) / sizeof(*(v))) )
+
+
+#endif /* __CHECK_H */
@@ -0,0 +1,263 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "check.h"
+
+#include <stdio.h>
+#include <stdalign.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#include <ltpf.c>
+
+void lc3_put_bits_generic(lc3_bits_t *a, unsigned b, int c)
+{ (void)a, (void)b, (void)c; }
+
+unsigned lc3_get_bits_generic(struct lc3_bits *a, int b)
+{ return (void)a, (void)b, 0; }
+
+/* -------------------------------------------------------------------------- */
+
+static int check_resampler(void)
+{
+    typedef void (*resample_t)(
+        struct lc3_ltpf_hp50_state *, const int16_t *, int16_t *, int);
+
+    static const struct {
+        const char *name; resample_t ref, fn; int ulp;
+    } variants[] = {
+        VARIANT(resample_8k_12k8 , arm_resample_8k_12k8  , 0),
+        VARIANT(resample_16k_12k8, arm_resample_16k_12k8 , 0),
+        VARIANT(resample_16k_12k8, neon_resample_16k_12k8, 0),
+        VARIANT(resample_16k_12k8, wasm_resample_16k_12k8, 0),
+        VARIANT(resample_24k_12k8, arm_resample_24k_12k8 , 0),
+        VARIANT(resample_32k_12k8, arm_resample_32k_12k8 , 0),
+        VARIANT(resample_32k_12k8, neon_resample_32k_12k8, 0),
+        VARIANT(resample_32k_12k8, wasm_resample_32k_12k8, 0),
+        VARIANT(resample_48k_12k8, arm_resample_48k_12k8 , 0),
+        VARIANT(resample_48k_12k8, neon_resample_48k_12k8, 0),
+        VARIANT(resample_48k_12k8, wasm_resample_48k_12k8, 0),
+    };
+
+    static int16_t alignas(4) __x[60+480];
+    int16_t *x = __x + 60;
+
+    for (int iv = 0; iv < NUM_VARIANTS(variants); iv++)
+        for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+            struct lc3_ltpf_hp50_state hp50 = { 0 }, hp50_simd = { 0 };
+            int16_t y[128], y_simd[128];
+
+            generate_s16(__x, 60+480, p);
+
+            for (int n = 32; n <= 128; n += 32) {
+                variants[iv].ref(&hp50, x, y, n);
+                variants[iv].fn(&hp50_simd, x, y_simd, n);
+                if (memcmp(y, y_simd, n * sizeof(*y)) != 0)
+                    return report(variants[iv].name, p);
+            }
+        }
+
+    return 0;
+}
+
+static int check_resampler_6k4(void)
+{
+    static int16_t alignas(4) __x[4+256];
+    int16_t *x = __x + 4;
+
+    for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+        int16_t y[128], y_simd[128];
+
+        generate_s16(__x, 4+256, p);
+
+        resample_6k4(x, y, 128);
+        arm_resample_6k4(x, y_simd, 128);
+        if (memcmp(y, y_simd, 128 * sizeof(*y)) != 0)
+            return report("arm_resample_6k4", p);
+    }
+
+    return 0;
+}
+
+static int check_correlate(void)
+{
+    typedef float (*dot_t)(const int16_t *, const int16_t *, int);
+    typedef void (*correlate_t)(
+        const int16_t *, const int16_t *, int, float *, int);
+
+    static const struct {
+        const char *name; dot_t ref, fn; int ulp;
+    } dot_variants[] = {
+        VARIANT(dot, neon_dot, 0),
+        VARIANT(dot, wasm_dot, 0),
+    };
+
+    static const struct {
+        const char *name; correlate_t ref, fn; int ulp;
+    } correlate_variants[] = {
+        VARIANT(correlate, arm_correlate , 0),
+        VARIANT(correlate, neon_correlate, 0),
+        VARIANT(correlate, wasm_correlate, 0),
+    };
+
+    static int16_t alignas(4) a[500], b[500];
+
+    for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+        generate_s16(a, 500, p);
+        generate_s16(b, 500, p);
+
+        for (int iv = 0; iv < NUM_VARIANTS(dot_variants); iv++)
+            for (int n = 16; n <= 128; n += 16) {
+                float y = dot_variants[iv].ref(a, b+3, n);
+                float y_simd = dot_variants[iv].fn(a, b+3, n);
+                if (check_ulp(&y, &y_simd, 1, dot_variants[iv].ulp) < 0)
+                    return report(dot_variants[iv].name, p);
+            }
+
+        for (int iv = 0; iv < NUM_VARIANTS(correlate_variants); iv++)
+            for (int nc = 97; nc <= 100; nc++) {
+                float y[100], y_simd[100];
+
+                correlate_variants[iv].ref(a, b+200, 128, y, nc);
+                correlate_variants[iv].fn(a, b+200, 128, y_simd, nc);
+                if (check_ulp(y, y_simd, nc, correlate_variants[iv].ulp) < 0)
+                    return report(correlate_variants[iv].name, p);
+
+                correlate_variants[iv].ref(a, b+199, 64, y, nc);
+                correlate_variants[iv].fn(a, b+199, 64, y_simd, nc);
+                if (check_ulp(y, y_simd, nc, correlate_variants[iv].ulp) < 0)
+                    return report(correlate_variants[iv].name, p);
+            }
+    }
+
+    return 0;
+}
+
+static int check_interpolate(void)
+{
+    static int16_t alignas(4) __x[4+256];
+    int16_t *x = __x + 4;
+
+    for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+        int16_t y[128], y_simd[128];
+
+        generate_s16(__x, 4+256, p);
+
+        for (int d = 0; d < 4; d++) {
+            interpolate(x, 128, d, y);
+            arm_interpolate(x, 128, d, y_simd);
+            if (memcmp(y, y_simd, 128 * sizeof(*y)) != 0)
+                return report("arm_interpolate", p);
+
+            interpolate(x + 1, 120, d, y);
+            arm_interpolate(x + 1, 120, d, y_simd);
+            if (memcmp(y, y_simd, 120 * sizeof(*y)) != 0)
+                return report("arm_interpolate", p);
+        }
+    }
+
+    return 0;
+}
+
+static int check_synthesize(void)
+{
+    typedef void (*synthesize_t)(const float *, int, int,
+        const float *, float *, int, const float *, int);
+
+    static const struct {
+        const char *name; synthesize_t ref, fn; int ulp; enum lc3_srate sr;
+    } variants[] = {
+        { "sse_synthesize_4"  , synthesize_4 , sse_synthesize_4  , 0,
+          LC3_SRATE_16K },
+        { "sse_synthesize_6"  , synthesize_6 , sse_synthesize_6  , 0,
+          LC3_SRATE_24K },
+        { "sse_synthesize_8"  , synthesize_8 , sse_synthesize_8  , 0,
+          LC3_SRATE_32K },
+        { "sse_synthesize_12" , synthesize_12, sse_synthesize_12 , 0,
+          LC3_SRATE_48K },
+        { "neon_synthesize_4" , synthesize_4 , neon_synthesize_4 , 8,
+          LC3_SRATE_16K },
+        { "neon_synthesize_6" , synthesize_6 , neon_synthesize_6 , 8,
+          LC3_SRATE_24K },
+        { "neon_synthesize_8" , synthesize_8 , neon_synthesize_8 , 8,
+          LC3_SRATE_32K },
+        { "neon_synthesize_12", synthesize_12, neon_synthesize_12, 8,
+          LC3_SRATE_48K },
+    };
+
+    static float xh[1440], xh_simd[1440];
+    float c[2*MAX_FILTER_WIDTH], x0[MAX_FILTER_WIDTH];
+
+    for (int iv = 0; iv < NUM_VARIANTS(variants); iv++)
+      for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+            enum lc3_srate sr = variants[iv].sr;
+
+            int ns = lc3_ns(dt, sr), nh = ns + lc3_nh(dt, sr);
+            int w = LC3_MAX(4, lc3_ns_4m[sr] >> 4);
+
+            generate_f32(xh, nh, 1.f, p);
+            generate_f32(x0, w-1, 1.f, p);
+
+            for (int i = 0; i < w; i++) {
+                c[  i] = 0.4f * lc3_ltpf_cden[sr][rand() & 3][(w-1)-i];
+                c[w+i] = 0.85f * 0.4f * lc3_ltpf_cnum[sr][0][(w-1)-i];
+            }
+
+            memcpy(xh_simd, xh, nh * sizeof(*xh));
+
+            for (int fade = -1; fade <= 1; fade++)
+                for (int i = 0; i + ns <= nh; i += ns) {
+                    int pitch = 4*32 + rand() % (4*(228-32));
+                    pitch = (pitch * lc3_ns(LC3_DT_10M, sr) + 64) / 128;
+
+                    variants[iv].ref(xh, nh, pitch/4,
+                        x0, xh + i, ns, c, fade);
+                    variants[iv].fn(xh_simd, nh, pitch/4,
+                        x0, xh_simd + i, ns, c, fade);
+                }
+
+            if (check_ulp(xh, xh_simd, nh, variants[iv].ulp) < 0)
+                return report(variants[iv].name, p);
+        }
+
+    return 0;
+}
+
+int check_ltpf(void)
+{
+    int ret;
+
+    if ((ret = check_resampler()) < 0)
+        return ret;
+
+    if ((ret = check_resampler_6k4()) < 0)
+        return ret;
+
+    if ((ret = check_correlate()) < 0)
+        return ret;
+
+    if ((ret = check_interpolate()) < 0)
+        return ret;
+
+    if ((ret = check_synthesize()) < 0)
+        return ret;
+
+    return 0;
+}
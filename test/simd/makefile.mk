@@ -0,0 +1,39 @@
+#
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at:
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+test_simd_src += \
+    $(TEST_DIR)/simd/test_simd.c \
+    $(TEST_DIR)/simd/check.c \
+    $(TEST_DIR)/simd/attdet_simd.c \
+    $(TEST_DIR)/simd/ltpf_simd.c \
+    $(TEST_DIR)/simd/mdct_simd.c \
+    $(TEST_DIR)/simd/pcm_simd.c \
+    $(TEST_DIR)/simd/sns_simd.c \
+    $(TEST_DIR)/simd/spec_simd.c \
+    $(TEST_DIR)/simd/tns_simd.c \
+    $(SRC_DIR)/tables.c
+
+test_simd_include += $(SRC_DIR) \
+    $(TEST_DIR)/sse $(TEST_DIR)/neon $(TEST_DIR)/arm $(TEST_DIR)/wasm
+test_simd_ldlibs += m
+
+$(eval $(call add-bin,test_simd))
+
+test_simd: $(test_simd_bin)
+	@echo "  RUN     $(notdir $<)"
+	$(V)$<
+
+test: test_simd
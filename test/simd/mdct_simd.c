@@ -0,0 +1,242 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#include <mdct.c>
+
+/* -------------------------------------------------------------------------- */
+
+static int check_fft(void)
+{
+    typedef void (*fft_5_t)(
+        const struct lc3_complex *, struct lc3_complex *, int);
+    typedef void (*fft_bf3_t)(const struct lc3_fft_bf3_twiddles *,
+        const struct lc3_complex *, struct lc3_complex *, int);
+    typedef void (*fft_bf2_t)(const struct lc3_fft_bf2_twiddles *,
+        const struct lc3_complex *, struct lc3_complex *, int);
+
+    static const struct {
+        const char *name; fft_5_t ref, fn; int ulp;
+    } fft_5_variants[] = {
+        VARIANT(fft_5, neon_fft_5, 8),
+    };
+
+    static const struct {
+        const char *name; fft_bf3_t ref, fn; int ulp;
+    } fft_bf3_variants[] = {
+        VARIANT(fft_bf3, neon_fft_bf3, 8),
+        VARIANT(fft_bf3, wasm_fft_bf3, 4),
+    };
+
+    static const struct {
+        const char *name; fft_bf2_t ref, fn; int ulp;
+    } fft_bf2_variants[] = {
+        VARIANT(fft_bf2, neon_fft_bf2, 8),
+        VARIANT(fft_bf2, wasm_fft_bf2, 4),
+    };
+
+    const int nt = LC3_MAX_NS / 2;
+    struct lc3_complex x[LC3_MAX_NS/2];
+    struct lc3_complex y[LC3_MAX_NS/2], y_simd[LC3_MAX_NS/2];
+
+    for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+        generate_f32((float *)x, 2*nt, 32768.f, p);
+
+        for (int iv = 0; iv < NUM_VARIANTS(fft_5_variants); iv++) {
+            fft_5_variants[iv].ref(x, y, nt / 5);
+            fft_5_variants[iv].fn(x, y_simd, nt / 5);
+            if (check_ulp((float *)y, (float *)y_simd,
+                    2*nt, fft_5_variants[iv].ulp) < 0)
+                return report(fft_5_variants[iv].name, p);
+        }
+
+        for (int iv = 0; iv < NUM_VARIANTS(fft_bf3_variants); iv++)
+            for (int k = 0; k < 2; k++) {
+                const struct lc3_fft_bf3_twiddles *t = lc3_fft_twiddles_bf3[k];
+                int n = nt / (3 * t->n3);
+
+                fft_bf3_variants[iv].ref(t, x, y, n);
+                fft_bf3_variants[iv].fn(t, x, y_simd, n);
+                if (check_ulp((float *)y, (float *)y_simd,
+                        2 * 3*t->n3 * n, fft_bf3_variants[iv].ulp) < 0)
+                    return report(fft_bf3_variants[iv].name, p);
+            }
+
+        for (int iv = 0; iv < NUM_VARIANTS(fft_bf2_variants); iv++)
+            for (int i2 = 0; i2 < 5; i2++)
+                for (int i3 = 0; i3 < 3; i3++) {
+                    const struct lc3_fft_bf2_twiddles *t =
+                        lc3_fft_twiddles_bf2[i2][i3];
+                    if (!t)
+                        continue;
+
+                    int n = nt / (2 * t->n2);
+
+                    fft_bf2_variants[iv].ref(t, x, y, n);
+                    fft_bf2_variants[iv].fn(t, x, y_simd, n);
+                    if (check_ulp((float *)y, (float *)y_simd,
+                            2 * 2*t->n2 * n, fft_bf2_variants[iv].ulp) < 0)
+                        return report(fft_bf2_variants[iv].name, p);
+                }
+    }
+
+    return 0;
+}
+
+static int check_window(void)
+{
+    typedef void (*window_t)(
+        enum lc3_dt, enum lc3_srate, const float *, float *, float *);
+
+    static const struct {
+        const char *name; window_t ref, fn; int ulp;
+    } mdct_variants[] = {
+        VARIANT(mdct_window, neon_mdct_window, 4),
+    };
+
+    static const struct {
+        const char *name; window_t ref, fn; int ulp;
+    } imdct_variants[] = {
+        VARIANT(imdct_window, neon_imdct_window, 4),
+    };
+
+    float x[LC3_MAX_NS], y[LC3_MAX_NS], y_simd[LC3_MAX_NS];
+    float d[LC3_MAX_NS], d_simd[LC3_MAX_NS];
+
+    for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_srate sr = 0; sr < LC3_NUM_SRATE; sr++)
+            for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+                int ns = lc3_ns(dt, sr), nd = lc3_nd(dt, sr);
+                if (!lc3_mdct_win[dt][sr])
+                    continue;
+
+                generate_f32(x, ns, 32768.f, p);
+                generate_f32(d, nd, 32768.f, p);
+
+                for (int iv = 0; iv < NUM_VARIANTS(mdct_variants); iv++) {
+                    memcpy(d_simd, d, nd * sizeof(*d));
+
+                    mdct_variants[iv].ref(dt, sr, x, d, y);
+                    mdct_variants[iv].fn(dt, sr, x, d_simd, y_simd);
+                    if (check_ulp(y, y_simd, ns, mdct_variants[iv].ulp) < 0 ||
+                        check_ulp(d, d_simd, nd, mdct_variants[iv].ulp) < 0)
+                        return report(mdct_variants[iv].name, p);
+                }
+
+                for (int iv = 0; iv < NUM_VARIANTS(imdct_variants); iv++) {
+                    memcpy(d_simd, d, nd * sizeof(*d));
+
+                    imdct_variants[iv].ref(dt, sr, x, d, y);
+                    imdct_variants[iv].fn(dt, sr, x, d_simd, y_simd);
+                    if (check_ulp(y, y_simd, nd, imdct_variants[iv].ulp) < 0 ||
+                        check_ulp(d, d_simd, nd, imdct_variants[iv].ulp) < 0)
+                        return report(imdct_variants[iv].name, p);
+                }
+            }
+
+    return 0;
+}
+
+static int check_rotation(void)
+{
+    typedef void (*pre_fft_t)(const struct lc3_mdct_rot_def *,
+        const float *, struct lc3_complex *);
+    typedef void (*post_fft_t)(const struct lc3_mdct_rot_def *,
+        const struct lc3_complex *, float *);
+
+    static const struct {
+        const char *name; pre_fft_t ref, fn; int ulp;
+    } pre_variants[] = {
+        VARIANT(mdct_pre_fft , neon_mdct_pre_fft , 4),
+        VARIANT(imdct_pre_fft, neon_imdct_pre_fft, 4),
+    };
+
+    static const struct {
+        const char *name; post_fft_t ref, fn; int ulp;
+    } post_variants[] = {
+        VARIANT(mdct_post_fft , neon_mdct_post_fft , 4),
+        VARIANT(imdct_post_fft, neon_imdct_post_fft, 4),
+    };
+
+    float x[LC3_MAX_NS];
+    struct lc3_complex y[LC3_MAX_NS/2], y_simd[LC3_MAX_NS/2];
+    float z[LC3_MAX_NS], z_simd[LC3_MAX_NS];
+
+    for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_srate sr = 0; sr < LC3_NUM_SRATE; sr++)
+            for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+                const struct lc3_mdct_rot_def *rot = lc3_mdct_rot[dt][sr];
+                if (!rot)
+                    continue;
+
+                int n4 = rot->n4;
+
+                generate_f32(x, 2*n4, 32768.f, p);
+                generate_f32((float *)y, 2*n4, 32768.f, p);
+
+                for (int iv = 0; iv < NUM_VARIANTS(pre_variants); iv++) {
+                    struct lc3_complex u[LC3_MAX_NS/2];
+
+                    pre_variants[iv].ref(rot, x, u);
+                    pre_variants[iv].fn(rot, x, y_simd);
+                    if (check_ulp((float *)u, (float *)y_simd,
+                            2*n4, pre_variants[iv].ulp) < 0)
+                        return report(pre_variants[iv].name, p);
+
+                    if (pre_variants[iv].ref != mdct_pre_fft)
+                        continue;
+
+                    memcpy(y_simd, x, 2*n4 * sizeof(float));
+                    pre_variants[iv].fn(rot, (float *)y_simd, y_simd);
+                    if (check_ulp((float *)u, (float *)y_simd,
+                            2*n4, pre_variants[iv].ulp) < 0)
+                        return report(pre_variants[iv].name, p);
+                }
+
+                for (int iv = 0; iv < NUM_VARIANTS(post_variants); iv++) {
+                    post_variants[iv].ref(rot, y, z);
+                    post_variants[iv].fn(rot, y, z_simd);
+                    if (check_ulp(z, z_simd, 2*n4, post_variants[iv].ulp) < 0)
+                        return report(post_variants[iv].name, p);
+                }
+            }
+
+    return 0;
+}
+
+int check_mdct(void)
+{
+    int ret;
+
+    if ((ret = check_fft()) < 0)
+        return ret;
+
+    if ((ret = check_window()) < 0)
+        return ret;
+
+    if ((ret = check_rotation()) < 0)
+        return ret;
+
+    return 0;
+}
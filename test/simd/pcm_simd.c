@@ -0,0 +1,193 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#include <common.h>
+#include <pcm_neon.h>
+#include <pcm_wasm.h>
+
+/* -------------------------------------------------------------------------- */
+
+static void pcm_from_s16(
+    const int16_t *pcm, int stride, int n, int16_t *xt, float *xs)
+{
+    for (int i = 0; i < n; i++, pcm += stride)
+        xt[i] = *pcm, xs[i] = *pcm;
+}
+
+static void pcm_from_float(
+    const float *pcm, int stride, int n, int16_t *xt, float *xs)
+{
+    for (int i = 0; i < n; i++, pcm += stride) {
+        xs[i] = lc3_ldexpf(*pcm, 15);
+        xt[i] = LC3_SAT16((int32_t)xs[i]);
+    }
+}
+
+static void pcm_to_s16(
+    const float *xs, int n, int16_t *pcm, int stride)
+{
+    for ( ; n > 0; n--, xs++, pcm += stride) {
+        int32_t s = *xs >= 0 ? (int)(*xs + 0.5f) : (int)(*xs - 0.5f);
+        *pcm = LC3_SAT16(s);
+    }
+}
+
+static void pcm_to_float(
+    const float *xs, int n, float *pcm, int stride)
+{
+    for ( ; n > 0; n--, xs++, pcm += stride) {
+        float s = lc3_ldexpf(*xs, -15);
+        *pcm = fminf(fmaxf(s, -1.f), 1.f);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+static int check_load(void)
+{
+    typedef void (*from_s16_t)(const int16_t *, int, int, int16_t *, float *);
+    typedef void (*from_float_t)(const float *, int, int, int16_t *, float *);
+
+    static const struct {
+        const char *name; from_s16_t ref, fn; int ulp;
+    } s16_variants[] = {
+        VARIANT(pcm_from_s16, neon_pcm_from_s16, 0),
+        VARIANT(pcm_from_s16, wasm_pcm_from_s16, 0),
+    };
+
+    static const struct {
+        const char *name; from_float_t ref, fn; int ulp;
+    } float_variants[] = {
+        VARIANT(pcm_from_float, neon_pcm_from_float, 0),
+        VARIANT(pcm_from_float, wasm_pcm_from_float, 0),
+    };
+
+    int16_t pcm_s16[2*480], xt[480], xt_simd[480];
+    float pcm_f32[2*480], xs[480], xs_simd[480];
+
+    for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+        generate_s16(pcm_s16, 2*480, p);
+        generate_f32(pcm_f32, 2*480, 1.1f, p);
+
+        for (int stride = 1; stride <= 2; stride++)
+            for (int n = 1; n <= 480; n += 17) {
+
+                for (int iv = 0; iv < NUM_VARIANTS(s16_variants); iv++) {
+                    s16_variants[iv].ref(pcm_s16, stride, n, xt, xs);
+                    s16_variants[iv].fn(pcm_s16, stride, n, xt_simd, xs_simd);
+                    if (memcmp(xt, xt_simd, n * sizeof(*xt)) != 0 ||
+                        check_ulp(xs, xs_simd, n, s16_variants[iv].ulp) < 0)
+                        return report(s16_variants[iv].name, p);
+                }
+
+                /* The subnormals are left unscaled by the generic
+                 * conversion, and scaled by the variants. */
+
+                for (int iv = 0; iv < NUM_VARIANTS(float_variants); iv++) {
+                    float_variants[iv].ref(pcm_f32, stride, n, xt, xs);
+                    float_variants[iv].fn(pcm_f32, stride, n, xt_simd, xs_simd);
+                    if (memcmp(xt, xt_simd, n * sizeof(*xt)) != 0 ||
+                        (p != PATTERN_SMALL && check_ulp(
+                            xs, xs_simd, n, float_variants[iv].ulp) < 0))
+                        return report(float_variants[iv].name, p);
+                }
+            }
+    }
+
+    return 0;
+}
+
+static int check_store(void)
+{
+    typedef void (*to_s16_t)(const float *, int, int16_t *, int);
+    typedef void (*to_float_t)(const float *, int, float *, int);
+
+    static const struct {
+        const char *name; to_s16_t ref, fn; int ulp;
+    } s16_variants[] = {
+        VARIANT(pcm_to_s16, neon_pcm_to_s16, 0),
+        VARIANT(pcm_to_s16, wasm_pcm_to_s16, 0),
+    };
+
+    static const struct {
+        const char *name; to_float_t ref, fn; int ulp;
+    } float_variants[] = {
+        VARIANT(pcm_to_float, neon_pcm_to_float, 0),
+        VARIANT(pcm_to_float, wasm_pcm_to_float, 0),
+    };
+
+    float xs[480];
+    int16_t pcm_s16[2*480], pcm_s16_simd[2*480];
+    float pcm_f32[2*480], pcm_f32_simd[2*480];
+
+    for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+        generate_f32(xs, 480, 1.1f * 32768, p);
+        for (int i = 0; p == PATTERN_RANDOM && i < 480; i += 8)
+            xs[i] = roundf(xs[i] / 32) + 0.5f;
+
+        for (int stride = 1; stride <= 2; stride++)
+            for (int n = 1; n <= 480; n += 17) {
+
+                for (int iv = 0; iv < NUM_VARIANTS(s16_variants); iv++) {
+                    memset(pcm_s16, 0, sizeof(pcm_s16));
+                    memset(pcm_s16_simd, 0, sizeof(pcm_s16_simd));
+
+                    s16_variants[iv].ref(xs, n, pcm_s16, stride);
+                    s16_variants[iv].fn(xs, n, pcm_s16_simd, stride);
+                    if (memcmp(pcm_s16, pcm_s16_simd, sizeof(pcm_s16)) != 0)
+                        return report(s16_variants[iv].name, p);
+                }
+
+                /* The subnormals are left unscaled by the generic
+                 * conversion, and scaled by the variants. */
+
+                for (int iv = 0; iv < NUM_VARIANTS(float_variants); iv++) {
+                    memset(pcm_f32, 0, sizeof(pcm_f32));
+                    memset(pcm_f32_simd, 0, sizeof(pcm_f32_simd));
+
+                    float_variants[iv].ref(xs, n, pcm_f32, stride);
+                    float_variants[iv].fn(xs, n, pcm_f32_simd, stride);
+                    if (p != PATTERN_SMALL && check_ulp(pcm_f32, pcm_f32_simd,
+                            2*480, float_variants[iv].ulp) < 0)
+                        return report(float_variants[iv].name, p);
+                }
+            }
+    }
+
+    return 0;
+}
+
+int check_pcm(void)
+{
+    int ret;
+
+    if ((ret = check_load()) < 0)
+        return ret;
+
+    if ((ret = check_store()) < 0)
+        return ret;
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#include <sns.c>
+
+/* -------------------------------------------------------------------------- */
+
+static int check_spectral_shaping(void)
+{
+    typedef void (*spectral_shaping_t)(enum lc3_dt, enum lc3_srate,
+        const float *, bool, const float *, float *);
+
+    static const struct {
+        const char *name; spectral_shaping_t ref, fn; int ulp;
+    } variants[] = {
+        VARIANT(spectral_shaping, neon_spectral_shaping, 0),
+    };
+
+    float x[LC3_MAX_NE], y[LC3_MAX_NE], y_simd[LC3_MAX_NE];
+    float scf_q[16];
+
+    for (int iv = 0; iv < NUM_VARIANTS(variants); iv++)
+      for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_srate sr = 0; sr < LC3_NUM_SRATE; sr++)
+          for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+            if (!lc3_band_lim[dt][sr])
+                continue;
+
+            int ne = lc3_ne(dt, sr);
+
+            generate_f32(x, ne, 32768.f, p);
+            generate_f32(scf_q, 16, 8.f, p);
+
+            for (int inv = 0; inv <= 1; inv++) {
+                variants[iv].ref(dt, sr, scf_q, inv, x, y);
+                variants[iv].fn(dt, sr, scf_q, inv, x, y_simd);
+                if (check_ulp(y, y_simd, ne, variants[iv].ulp) < 0)
+                    return report(variants[iv].name, p);
+            }
+          }
+
+    return 0;
+}
+
+int check_sns(void)
+{
+    int ret;
+
+    if ((ret = check_spectral_shaping()) < 0)
+        return ret;
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#include <spec.c>
+
+int lc3_get_bits_left(const lc3_bits_t *a) { return (void)a, 0; }
+
+int lc3_bwdet_get_nbits(enum lc3_srate a) { return (void)a, 0; }
+
+/* -------------------------------------------------------------------------- */
+
+static int check_energy(void)
+{
+    typedef float (*compute_energy4_t)(const float *, int, float *);
+    typedef void (*convert_energy_db_t)(const float *, int, float, int32_t *);
+
+    static const struct {
+        const char *name; compute_energy4_t ref, fn; int ulp;
+    } energy_variants[] = {
+        VARIANT(compute_energy4, neon_compute_energy4, 0),
+        VARIANT(compute_energy4, sse_compute_energy4 , 0),
+        VARIANT(compute_energy4, wasm_compute_energy4, 0),
+    };
+
+    static const struct {
+        const char *name; convert_energy_db_t ref, fn; int ulp;
+    } db_variants[] = {
+        VARIANT(convert_energy_db, neon_convert_energy_db, 0),
+        VARIANT(convert_energy_db, sse_convert_energy_db , 0),
+    };
+
+    float x[LC3_MAX_NE];
+    float e[LC3_MAX_NE / 4], e_simd[LC3_MAX_NE / 4];
+    int32_t e_db[LC3_MAX_NE / 4], e_db_simd[LC3_MAX_NE / 4];
+
+    for (enum pattern p = 0; p < PATTERN_NUM; p++)
+        for (int n4 = 1; n4 <= LC3_MAX_NE / 4; n4 += 13) {
+            generate_f32(x, 4*n4, 1 << (rand() % 16), p);
+
+            float x2_max = compute_energy4(x, n4, e);
+            float nf = n4 % 2 ? 0 : sqrtf(x2_max) * 1e-3f;
+
+            for (int iv = 0; iv < NUM_VARIANTS(energy_variants); iv++) {
+                float x2_max_simd = energy_variants[iv].fn(x, n4, e_simd);
+                if (check_ulp(&x2_max, &x2_max_simd,
+                        1, energy_variants[iv].ulp) < 0 ||
+                    check_ulp(e, e_simd, n4, energy_variants[iv].ulp) < 0)
+                    return report(energy_variants[iv].name, p);
+            }
+
+            convert_energy_db(e, n4, nf, e_db);
+
+            for (int iv = 0; iv < NUM_VARIANTS(db_variants); iv++) {
+                db_variants[iv].fn(e, n4, nf, e_db_simd);
+                if (memcmp(e_db, e_db_simd, n4 * sizeof(*e_db)) != 0)
+                    return report(db_variants[iv].name, p);
+            }
+        }
+
+    return 0;
+}
+
+static int check_quantization(void)
+{
+    typedef void (*quantize_t)(
+        enum lc3_dt, enum lc3_srate, int, float *, int *);
+    typedef float (*unquantize_t)(
+        enum lc3_dt, enum lc3_srate, int, float *, int);
+
+    static const struct {
+        const char *name; quantize_t ref, fn; int ulp;
+    } quant_variants[] = {
+        VARIANT(quantize, neon_quantize, 0),
+        VARIANT(quantize, sse_quantize , 0),
+        VARIANT(quantize, wasm_quantize, 0),
+    };
+
+    static const struct {
+        const char *name; unquantize_t ref, fn; int ulp;
+    } unquant_variants[] = {
+        VARIANT(unquantize, neon_unquantize, 0),
+        VARIANT(unquantize, sse_unquantize , 0),
+        VARIANT(unquantize, wasm_unquantize, 0),
+    };
+
+    float x[LC3_MAX_NE], q[LC3_MAX_NE], y[LC3_MAX_NE], y_simd[LC3_MAX_NE];
+
+    for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_srate sr = 0; sr < LC3_NUM_SRATE; sr++)
+            for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+                int ne = lc3_ne(dt, sr);
+                if (!ne)
+                    continue;
+
+                for (int g_int = -30; g_int < 60; g_int += 7) {
+                    int n, n_simd;
+
+                    generate_f32(x, ne, 1000.f, p);
+                    for (int i = ne - 2 * (rand() % (ne/2)); i < ne; i++)
+                        x[i] *= 1e-4f;
+
+                    memcpy(q, x, ne * sizeof(*x));
+                    quantize(dt, sr, g_int, q, &n);
+
+                    for (int iv = 0; iv < NUM_VARIANTS(quant_variants); iv++) {
+                        memcpy(y_simd, x, ne * sizeof(*x));
+                        quant_variants[iv].fn(dt, sr, g_int, y_simd, &n_simd);
+                        if (n != n_simd || check_ulp(q, y_simd,
+                                ne, quant_variants[iv].ulp) < 0)
+                            return report(quant_variants[iv].name, p);
+                    }
+
+                    memcpy(y, q, ne * sizeof(*q));
+                    float g = unquantize(dt, sr, g_int, y, n);
+
+                    for (int iv = 0;
+                            iv < NUM_VARIANTS(unquant_variants); iv++) {
+                        memcpy(y_simd, q, ne * sizeof(*q));
+                        float g_simd = unquant_variants[iv].fn(
+                            dt, sr, g_int, y_simd, n);
+                        if (check_ulp(&g, &g_simd,
+                                1, unquant_variants[iv].ulp) < 0 ||
+                            check_ulp(y, y_simd,
+                                ne, unquant_variants[iv].ulp) < 0)
+                            return report(unquant_variants[iv].name, p);
+                    }
+                }
+            }
+
+    return 0;
+}
+
+static int check_noise(void)
+{
+    typedef int (*estimate_noise_t)(
+        enum lc3_dt, enum lc3_bandwidth, bool, const float *, int);
+
+    static const struct {
+        const char *name; estimate_noise_t ref, fn; int ulp;
+    } variants[] = {
+        VARIANT(estimate_noise, neon_estimate_noise, 0),
+        VARIANT(estimate_noise, sse_estimate_noise , 0),
+    };
+
+    float x[LC3_MAX_NE];
+
+    for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_bandwidth bw = 0; bw < LC3_NUM_BANDWIDTH; bw++)
+            for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+                int ne = lc3_ne(dt, (enum lc3_srate)bw);
+                if (!ne)
+                    continue;
+
+                for (int k = 0; k < 10; k++) {
+                    bool hrmode = k & 1;
+                    int n = 2 * (rand() % (ne/2 + 1));
+
+                    generate_f32(x, ne, 0.5f + k * 0.1f, p);
+
+                    int nf = estimate_noise(dt, bw, hrmode, x, n);
+
+                    for (int iv = 0; iv < NUM_VARIANTS(variants); iv++)
+                        if (variants[iv].fn(dt, bw, hrmode, x, n) != nf)
+                            return report(variants[iv].name, p);
+                }
+            }
+
+    return 0;
+}
+
+int check_spec(void)
+{
+    int ret;
+
+    if ((ret = check_energy()) < 0)
+        return ret;
+
+    if ((ret = check_quantization()) < 0)
+        return ret;
+
+    if ((ret = check_noise()) < 0)
+        return ret;
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include <stdio.h>
+
+int check_attdet(void);
+int check_ltpf(void);
+int check_mdct(void);
+int check_pcm(void);
+int check_sns(void);
+int check_spec(void);
+int check_tns(void);
+
+int main()
+{
+    int r, ret = 0;
+
+    printf("Checking Attack Detector kernels... "); fflush(stdout);
+    printf("%s\n", (r = check_attdet()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking LTPF kernels... "); fflush(stdout);
+    printf("%s\n", (r = check_ltpf()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking MDCT kernels... "); fflush(stdout);
+    printf("%s\n", (r = check_mdct()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking PCM kernels... "); fflush(stdout);
+    printf("%s\n", (r = check_pcm()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking SNS kernels... "); fflush(stdout);
+    printf("%s\n", (r = check_sns()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking Spectral kernels... "); fflush(stdout);
+    printf("%s\n", (r = check_spec()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    printf("Checking TNS kernels... "); fflush(stdout);
+    printf("%s\n", (r = check_tns()) == 0 ? "OK" : "Failed");
+    ret = ret || r;
+
+    return ret;
+}
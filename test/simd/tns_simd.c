@@ -0,0 +1,117 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#include <tns.c>
+
+void lc3_ac_read_renorm(lc3_bits_t *a) { (void)a; }
+void lc3_ac_write_renorm(lc3_bits_t *a) { (void)a; }
+
+/* -------------------------------------------------------------------------- */
+
+static int check_autocorrelate(void)
+{
+    typedef void (*autocorrelate_t)(const float *, int, int, float *);
+
+    static const struct {
+        const char *name; autocorrelate_t ref, fn; int ulp;
+    } variants[] = {
+        VARIANT(autocorrelate, neon_autocorrelate, 16),
+        VARIANT(autocorrelate, sse_autocorrelate , 16),
+    };
+
+    float x[160];
+
+    for (int iv = 0; iv < NUM_VARIANTS(variants); iv++)
+        for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+            generate_f32(x, 160, 1.f, p);
+
+            for (int n = 9; n <= 160; n += 17)
+                for (int maxorder = 4; maxorder <= 8; maxorder += 4) {
+                    float r[9], r_simd[9];
+
+                    variants[iv].ref(x, n, maxorder, r);
+                    variants[iv].fn(x, n, maxorder, r_simd);
+                    if (check_ulp(r, r_simd,
+                            maxorder + 1, variants[iv].ulp) < 0)
+                        return report(variants[iv].name, p);
+                }
+        }
+
+    return 0;
+}
+
+static int check_forward_filtering(void)
+{
+    typedef void (*forward_filtering_t)(enum lc3_dt, enum lc3_bandwidth,
+        const int [2], float (* const)[8], float *);
+
+    static const struct {
+        const char *name; forward_filtering_t ref, fn; int ulp;
+    } variants[] = {
+        VARIANT(forward_filtering, neon_forward_filtering, 0),
+        VARIANT(forward_filtering, sse_forward_filtering , 0),
+    };
+
+    float x[LC3_MAX_NE], y[LC3_MAX_NE], y_simd[LC3_MAX_NE];
+    float rc[2][8];
+
+    for (int iv = 0; iv < NUM_VARIANTS(variants); iv++)
+      for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_bandwidth bw = 0; bw <= LC3_BANDWIDTH_FB; bw++)
+          for (enum pattern p = 0; p < PATTERN_NUM; p++) {
+            if (!lc3_ne(dt, (enum lc3_srate)bw))
+                continue;
+
+            generate_f32(x, LC3_MAX_NE, 32768.f, p);
+            generate_f32(rc[0], 2*8, 0.9f, p);
+
+            for (int order = 0; order <= 8; order++) {
+                int rc_order[2] = { order, 8 - order };
+
+                memcpy(y, x, sizeof(x));
+                memcpy(y_simd, x, sizeof(x));
+
+                variants[iv].ref(dt, bw, rc_order, rc, y);
+                variants[iv].fn(dt, bw, rc_order, rc, y_simd);
+                if (check_ulp(y, y_simd, LC3_MAX_NE, variants[iv].ulp) < 0)
+                    return report(variants[iv].name, p);
+            }
+          }
+
+    return 0;
+}
+
+int check_tns(void)
+{
+    int ret;
+
+    if ((ret = check_autocorrelate()) < 0)
+        return ret;
+
+    if ((ret = check_forward_filtering()) < 0)
+        return ret;
+
+    return 0;
+}
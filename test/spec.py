@@ -611,7 +611,7 @@ class SpectrumSynthesis(SpectrumQuantization):
 
 
 def initial_state():
-    return { 'nbits_off' : 0.0, 'nbits_spare' : 0 }
+    return { 'nbits_off' : 0.0, 'nbits_spare' : 0, 'g_idx' : 0 }
 
 
 ### ------------------------------------------------------------------------ ###
@@ -631,12 +631,13 @@ def check_estimate_gain(rng, dt, sr):
         nbits_budget = 8 * nbytes - int(rng.random() * 100)
         nbits_off = rng.random() * 10
         g_off = 10 - int(rng.random() * 20)
+        g_idx_prev = int(rng.random() * 256)
 
         (_, g_int, reset_off) = \
             analysis.estimate_gain(x, nbytes, nbits_budget, nbits_off, g_off)
 
         (g_int_c, reset_off_c, _) = lc3.spec_estimate_gain(
-            dt, sr, x, nbytes, nbits_budget, nbits_off, -g_off)
+            dt, sr, x, nbytes, nbits_budget, nbits_off, -g_off, g_idx_prev)
 
         if g_int_c != g_int:
             mismatch_count += 1
@@ -686,13 +687,14 @@ def check_compute_nbits(rng, dt, sr):
         (nbits, nbits_trunc, nq_trunc, lsb_mode) = \
             analysis.compute_nbits(nbytes, xq, nq, nbits_budget)
 
-        (nbits_c, nq_c, _) = \
+        (nbits_c, _, nq_c, _) = \
             lc3.spec_compute_nbits(dt, sr, nbytes, xq, nq, 0)
 
-        (nbits_trunc_c, nq_trunc_c, lsb_mode_c) = \
+        (nbits_budget_c, nbits_trunc_c, nq_trunc_c, lsb_mode_c) = \
             lc3.spec_compute_nbits(dt, sr, nbytes, xq, nq, nbits_budget)
 
         ok = ok and nbits_c == nbits
+        ok = ok and nbits_budget_c == nbits
         ok = ok and nbits_trunc_c == nbits_trunc
         ok = ok and nq_trunc_c == nq_trunc
         ok = ok and lsb_mode_c == lsb_mode
@@ -26,13 +26,13 @@
 static PyObject *estimate_gain_py(PyObject *m, PyObject *args)
 {
     unsigned dt, sr;
-    int nbytes, nbits_budget, g_off;
+    int nbytes, nbits_budget, g_off, g_idx_prev = 0;
     float nbits_off;
     PyObject *x_obj;
     float *x;
 
-    if (!PyArg_ParseTuple(args, "IIOiifi", &dt, &sr,
-                &x_obj, &nbytes, &nbits_budget, &nbits_off, &g_off))
+    if (!PyArg_ParseTuple(args, "IIOiifi|i", &dt, &sr, &x_obj,
+                &nbytes, &nbits_budget, &nbits_off, &g_off, &g_idx_prev))
         return NULL;
 
     CTYPES_CHECK("dt", dt < LC3_NUM_DT);
@@ -45,8 +45,8 @@ static PyObject *estimate_gain_py(PyObject *m, PyObject *args)
     int g_min;
     bool reset_off;
 
-    int g_int = estimate_gain(dt, sr,
-        x, nbytes, nbits_budget, nbits_off, g_off, &reset_off, &g_min);
+    int g_int = estimate_gain(dt, sr, x, nbytes,
+        nbits_budget, nbits_off, g_off, g_idx_prev, &reset_off, &g_min);
 
     return Py_BuildValue("iii", g_int, reset_off, g_min);
 }
@@ -111,12 +111,13 @@ static PyObject *compute_nbits_py(PyObject *m, PyObject *args)
 
     CTYPES_CHECK("x", x_obj = to_1d_ptr(x_obj, NPY_FLOAT, ne, &x));
 
+    int nbits_trunc;
     bool lsb_mode;
 
-    int nbits = compute_nbits(
-        dt, sr, nbytes, x, &nq, nbits_budget, &lsb_mode);
+    int nbits = compute_nbits(dt, sr, nbytes,
+        x, &nq, nbits_budget, &nbits_trunc, &lsb_mode);
 
-    return Py_BuildValue("iii", nbits, nq, lsb_mode);
+    return Py_BuildValue("iiii", nbits, nbits_trunc, nq, lsb_mode);
 }
 
 static PyObject *analyze_py(PyObject *m, PyObject *args)
@@ -0,0 +1,64 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "sse.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_SSE
+#include <attdet.c>
+
+/* -------------------------------------------------------------------------- */
+
+static int check_compute_energy(void)
+{
+    int16_t __x[6+480], *x = __x + 6;
+
+    for (int run = 0; run < 10; run++) {
+
+        for (int i = -6; i < 480; i++)
+            x[i] = run < 2 ? (run & 1 ? INT16_MIN : INT16_MAX) * (i & 1) :
+                   rand() & 0xffff;
+
+        for (enum lc3_srate sr = LC3_SRATE_32K; sr <= LC3_SRATE_48K; sr++)
+            for (int nblk = 3; nblk <= 4; nblk++) {
+                int32_t e[4], e_sse[4];
+
+                compute_energy(sr, x, nblk, e);
+                sse_compute_energy(sr, x, nblk, e_sse);
+                if (memcmp(e, e_sse, nblk * sizeof(*e)) != 0)
+                    return -1;
+            }
+    }
+
+    return 0;
+}
+
+int check_attdet(void)
+{
+    int ret;
+
+    if ((ret = check_compute_energy()) < 0)
+        return ret;
+
+    return 0;
+}
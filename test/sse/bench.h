@@ -0,0 +1,45 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#ifndef __BENCH_H
+#define __BENCH_H
+
+#include <stdio.h>
+#include <time.h>
+
+
+/**
+ * Time the generic and SIMD variants of a kernel
+ * name            Name of the kernel
+ * n               Number of runs
+ * generic, simd   Statements running the generic and the SIMD kernel
+ */
+#define BENCH_KERNEL(name, n, generic, simd) do {                      \
+    clock_t t0 = clock();                                               \
+    for (int bench_i = 0; bench_i < (n); bench_i++) { generic; }        \
+    clock_t t1 = clock();                                               \
+    for (int bench_i = 0; bench_i < (n); bench_i++) { simd; }           \
+    clock_t t2 = clock();                                               \
+    double ns = 1e9 / CLOCKS_PER_SEC / (n);                             \
+    printf("  %-24s %9.1f ns %9.1f ns    x%.2f\n", name,                \
+        (double)(t1 - t0) * ns, (double)(t2 - t1) * ns,                 \
+        (double)(t1 - t0) / (t2 - t1 ? t2 - t1 : 1));                   \
+} while (0)
+
+
+#endif /* __BENCH_H */
@@ -0,0 +1,47 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "sse.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_SSE
+#include <attdet.c>
+
+/* -------------------------------------------------------------------------- */
+
+void bench_attdet(int n)
+{
+    int16_t __x[6+480], *x = __x + 6;
+    int32_t e[4];
+
+    for (int i = -6; i < 480; i++)
+        x[i] = rand() & 0xffff;
+
+    BENCH_KERNEL("attdet energy 32k", n,
+        compute_energy(LC3_SRATE_32K, x, 4, e),
+        sse_compute_energy(LC3_SRATE_32K, x, 4, e));
+
+    BENCH_KERNEL("attdet energy 48k", n,
+        compute_energy(LC3_SRATE_48K, x, 4, e),
+        sse_compute_energy(LC3_SRATE_48K, x, 4, e));
+}
@@ -0,0 +1,61 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "sse.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_SSE
+#include <ltpf.c>
+
+/* -------------------------------------------------------------------------- */
+
+void bench_ltpf(int n)
+{
+    enum lc3_dt dt = LC3_DT_10M;
+    float xh[1440], c[2*MAX_FILTER_WIDTH], x0[MAX_FILTER_WIDTH];
+
+    for (int i = 0; i < 1440; i++)
+        xh[i] = (2 * (double)rand() / RAND_MAX) - 1;
+
+    for (int i = 0; i < MAX_FILTER_WIDTH; i++)
+        x0[i] = (2 * (double)rand() / RAND_MAX) - 1;
+
+    for (int i = 0; i < 2*MAX_FILTER_WIDTH; i++)
+        c[i] = 0.1 * ((2 * (double)rand() / RAND_MAX) - 1);
+
+#define BENCH_SYNTHESIZE(name, sr, w) do {                              \
+    int ns = lc3_ns(dt, sr), nh = ns + lc3_nh(dt, sr);                  \
+    int lag = lc3_ns(dt, sr) * 3/8;                                     \
+                                                                        \
+    BENCH_KERNEL(name, n,                                               \
+        synthesize_##w(xh, nh, lag, x0, xh + (nh - ns), ns, c, 0),      \
+        sse_synthesize_##w(xh, nh, lag, x0, xh + (nh - ns), ns, c, 0)); \
+} while (0)
+
+    BENCH_SYNTHESIZE("ltpf synthesis 16k", LC3_SRATE_16K,  4);
+    BENCH_SYNTHESIZE("ltpf synthesis 24k", LC3_SRATE_24K,  6);
+    BENCH_SYNTHESIZE("ltpf synthesis 32k", LC3_SRATE_32K,  8);
+    BENCH_SYNTHESIZE("ltpf synthesis 48k", LC3_SRATE_48K, 12);
+
+#undef BENCH_SYNTHESIZE
+}
@@ -0,0 +1,39 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+void bench_attdet(int n);
+void bench_ltpf(int n);
+void bench_spec(int n);
+void bench_tns(int n);
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+
+    printf("  %-24s %12s %12s\n", "Kernel", "Generic", "SSE");
+
+    bench_attdet(n);
+    bench_ltpf(n);
+    bench_spec(n);
+    bench_tns(n);
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "sse.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_SSE
+#include <tns.c>
+
+void lc3_put_bits_generic(lc3_bits_t *a, unsigned b, int c)
+{ (void)a, (void)b, (void)c; }
+
+unsigned lc3_get_bits_generic(struct lc3_bits *a, int b)
+{ return (void)a, (void)b, 0; }
+
+void lc3_ac_read_renorm(lc3_bits_t *a) { (void)a; }
+void lc3_ac_write_renorm(lc3_bits_t *a) { (void)a; }
+
+/* -------------------------------------------------------------------------- */
+
+void bench_tns(int n)
+{
+    float x[LC3_MAX_NE], y[LC3_MAX_NE];
+    float r[9], rc[2][8];
+
+    for (int i = 0; i < LC3_MAX_NE; i++)
+        x[i] = (2 * (double)rand() / RAND_MAX) - 1;
+
+    for (int f = 0; f < 2; f++)
+        for (int k = 0; k < 8; k++)
+            rc[f][k] = (1.8 * (double)rand() / RAND_MAX) - 0.9;
+
+    BENCH_KERNEL("tns autocorrelate", n,
+        autocorrelate(x, 133, 8, r),
+        sse_autocorrelate(x, 133, 8, r));
+
+    BENCH_KERNEL("tns forward filtering", n,
+        (memcpy(y, x, sizeof(x)), forward_filtering(
+            LC3_DT_10M, LC3_BANDWIDTH_FB, (int [2]){ 8, 8 }, rc, y)),
+        (memcpy(y, x, sizeof(x)), sse_forward_filtering(
+            LC3_DT_10M, LC3_BANDWIDTH_FB, (int [2]){ 8, 8 }, rc, y)));
+}
@@ -0,0 +1,92 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "sse.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_SSE
+#include <ltpf.c>
+
+/* -------------------------------------------------------------------------- */
+
+static int check_synthesize(void)
+{
+    static void (* const sse_synthesize[])(const float *, int, int,
+        const float *, float *, int, const float *, int) =
+    {
+        [LC3_SRATE_8K ] = sse_synthesize_4,
+        [LC3_SRATE_16K] = sse_synthesize_4,
+        [LC3_SRATE_24K] = sse_synthesize_6,
+        [LC3_SRATE_32K] = sse_synthesize_8,
+        [LC3_SRATE_48K] = sse_synthesize_12,
+    };
+
+    float xh[1440], xh_sse[1440];
+    float c[2*MAX_FILTER_WIDTH], x0[MAX_FILTER_WIDTH];
+
+    for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_srate sr = LC3_SRATE_8K; sr <= LC3_SRATE_48K; sr++) {
+
+            int ns = lc3_ns(dt, sr), nh = ns + lc3_nh(dt, sr);
+            int w = LC3_MAX(4, lc3_ns_4m[sr] >> 4);
+
+            for (int i = 0; i < nh; i++)
+                xh[i] = (2 * (double)rand() / RAND_MAX) - 1;
+
+            for (int i = 0; i < w; i++) {
+                c[  i] = 0.4f * lc3_ltpf_cden[sr][rand() & 3][(w-1)-i];
+                c[w+i] = 0.85f * 0.4f * lc3_ltpf_cnum[sr][0][(w-1)-i];
+            }
+
+            for (int i = 0; i < w-1; i++)
+                x0[i] = (2 * (double)rand() / RAND_MAX) - 1;
+
+            memcpy(xh_sse, xh, nh * sizeof(*xh));
+
+            for (int fade = -1; fade <= 1; fade++)
+                for (int i = 0; i + ns <= nh; i += ns) {
+                    int pitch = 4*32 + rand() % (4*(228-32));
+                    pitch = (pitch * lc3_ns(LC3_DT_10M, sr) + 64) / 128;
+
+                    synthesize[sr](xh, nh, pitch/4,
+                        x0, xh + i, ns, c, fade);
+                    sse_synthesize[sr](xh_sse, nh, pitch/4,
+                        x0, xh_sse + i, ns, c, fade);
+                }
+
+            if (memcmp(xh, xh_sse, nh * sizeof(*xh)) != 0)
+                return -1;
+        }
+
+    return 0;
+}
+
+int check_ltpf(void)
+{
+    int ret;
+
+    if ((ret = check_synthesize()) < 0)
+        return ret;
+
+    return 0;
+}
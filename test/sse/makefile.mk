@@ -0,0 +1,55 @@
+#
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at:
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+test_sse_src += \
+    $(TEST_DIR)/sse/test_sse.c \
+    $(TEST_DIR)/sse/attdet_sse.c \
+    $(TEST_DIR)/sse/ltpf_sse.c \
+    $(TEST_DIR)/sse/spec_sse.c \
+    $(TEST_DIR)/sse/tns_sse.c \
+    $(SRC_DIR)/tables.c
+
+test_sse_include += $(SRC_DIR)
+test_sse_ldlibs += m
+
+$(eval $(call add-bin,test_sse))
+
+test_sse: $(test_sse_bin)
+	@echo "  RUN     $(notdir $<)"
+	$(V)$<
+
+test: test_sse
+
+
+bench_sse_src += \
+    $(TEST_DIR)/sse/bench_sse.c \
+    $(TEST_DIR)/sse/bench_attdet.c \
+    $(TEST_DIR)/sse/bench_ltpf.c \
+    $(TEST_DIR)/sse/bench_spec.c \
+    $(TEST_DIR)/sse/bench_tns.c \
+    $(SRC_DIR)/tables.c
+
+bench_sse_include += $(SRC_DIR)
+bench_sse_cflags += -ffast-math
+bench_sse_ldlibs += m
+
+$(eval $(call add-bin,bench_sse))
+
+bench_sse: $(bench_sse_bin)
+	@echo "  RUN     $(notdir $<)"
+	$(V)$<
+
+bench: bench_sse
@@ -0,0 +1,409 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if __SSE2__
+
+#include <emmintrin.h>
+
+#else
+
+#include <stdint.h>
+#include <string.h>
+
+
+/* ----------------------------------------------------------------------------
+ *  Integer
+ * -------------------------------------------------------------------------- */
+
+typedef struct { int32_t e[4]; } __m128i;
+
+
+/**
+ * Load / Store
+ */
+
+__attribute__((unused))
+static __m128i _mm_loadu_si128(const __m128i *p)
+{
+    return *p;
+}
+
+__attribute__((unused))
+static void _mm_storeu_si128(__m128i *p, __m128i v)
+{
+    *p = v;
+}
+
+
+/**
+ * Arithmetic
+ */
+
+__attribute__((unused))
+static __m128i _mm_add_epi32(__m128i a, __m128i b)
+{
+    return (__m128i){ { a.e[0] + b.e[0], a.e[1] + b.e[1],
+                        a.e[2] + b.e[2], a.e[3] + b.e[3] } };
+}
+
+__attribute__((unused))
+static __m128i _mm_sub_epi32(__m128i a, __m128i b)
+{
+    return (__m128i){ { a.e[0] - b.e[0], a.e[1] - b.e[1],
+                        a.e[2] - b.e[2], a.e[3] - b.e[3] } };
+}
+
+__attribute__((unused))
+static __m128i _mm_mulhi_epu16(__m128i a, __m128i b)
+{
+    __m128i r;
+
+    for (int i = 0; i < 4; i++) {
+        uint32_t a_lo = a.e[i] & 0xffff, a_hi = (uint32_t)a.e[i] >> 16;
+        uint32_t b_lo = b.e[i] & 0xffff, b_hi = (uint32_t)b.e[i] >> 16;
+
+        r.e[i] = (int32_t)( ((a_hi * b_hi) & 0xffff0000) |
+                            ((a_lo * b_lo) >> 16)          );
+    }
+
+    return r;
+}
+
+__attribute__((unused))
+static __m128i _mm_madd_epi16(__m128i a, __m128i b)
+{
+    int16_t a16[8], b16[8];
+    __m128i r;
+
+    memcpy(a16, a.e, sizeof(a16));
+    memcpy(b16, b.e, sizeof(b16));
+
+    for (int i = 0; i < 4; i++)
+        r.e[i] = (int32_t)a16[2*i  ] * b16[2*i  ] +
+                 (int32_t)a16[2*i+1] * b16[2*i+1] ;
+
+    return r;
+}
+
+
+/**
+ * Logical
+ */
+
+__attribute__((unused))
+static __m128i _mm_and_si128(__m128i a, __m128i b)
+{
+    return (__m128i){ { a.e[0] & b.e[0], a.e[1] & b.e[1],
+                        a.e[2] & b.e[2], a.e[3] & b.e[3] } };
+}
+
+__attribute__((unused))
+static __m128i _mm_srli_epi32(__m128i a, int n)
+{
+    return (__m128i){ {
+        (int32_t)((uint32_t)a.e[0] >> n), (int32_t)((uint32_t)a.e[1] >> n),
+        (int32_t)((uint32_t)a.e[2] >> n), (int32_t)((uint32_t)a.e[3] >> n) } };
+}
+
+__attribute__((unused))
+static __m128i _mm_srai_epi32(__m128i a, int n)
+{
+    return (__m128i){ {
+        a.e[0] >> n, a.e[1] >> n, a.e[2] >> n, a.e[3] >> n } };
+}
+
+
+/**
+ * Manipulation
+ */
+
+__attribute__((unused))
+static __m128i _mm_setzero_si128(void)
+{
+    return (__m128i){ { 0, 0, 0, 0 } };
+}
+
+__attribute__((unused))
+static __m128i _mm_set1_epi32(int32_t v)
+{
+    return (__m128i){ { v, v, v, v } };
+}
+
+__attribute__((unused))
+static __m128i _mm_setr_epi32(int32_t v0, int32_t v1, int32_t v2, int32_t v3)
+{
+    return (__m128i){ { v0, v1, v2, v3 } };
+}
+
+__attribute__((unused))
+static __m128i _mm_set1_epi16(int16_t v)
+{
+    uint32_t u = (uint16_t)v;
+    return _mm_set1_epi32((int32_t)(u << 16 | u));
+}
+
+__attribute__((unused))
+static __m128i _mm_unpacklo_epi16(__m128i a, __m128i b)
+{
+    int16_t a16[8], b16[8], r16[8];
+    __m128i r;
+
+    memcpy(a16, a.e, sizeof(a16));
+    memcpy(b16, b.e, sizeof(b16));
+
+    for (int i = 0; i < 4; i++)
+        r16[2*i] = a16[i], r16[2*i+1] = b16[i];
+
+    memcpy(r.e, r16, sizeof(r16));
+    return r;
+}
+
+__attribute__((unused))
+static __m128i _mm_unpackhi_epi16(__m128i a, __m128i b)
+{
+    int16_t a16[8], b16[8], r16[8];
+    __m128i r;
+
+    memcpy(a16, a.e, sizeof(a16));
+    memcpy(b16, b.e, sizeof(b16));
+
+    for (int i = 0; i < 4; i++)
+        r16[2*i] = a16[4+i], r16[2*i+1] = b16[4+i];
+
+    memcpy(r.e, r16, sizeof(r16));
+    return r;
+}
+
+__attribute__((unused))
+static __m128i _mm_packs_epi32(__m128i a, __m128i b)
+{
+    int16_t r16[8];
+    __m128i r;
+
+    for (int i = 0; i < 8; i++) {
+        int32_t v = i < 4 ? a.e[i] : b.e[i-4];
+        r16[i] = v < INT16_MIN ? INT16_MIN : v > INT16_MAX ? INT16_MAX : v;
+    }
+
+    memcpy(r.e, r16, sizeof(r16));
+    return r;
+}
+
+
+/* ----------------------------------------------------------------------------
+ *  Floating Point
+ * -------------------------------------------------------------------------- */
+
+typedef struct { float e[4]; } __m128;
+
+
+/**
+ * Load / Store
+ */
+
+__attribute__((unused))
+static __m128 _mm_loadu_ps(const float *p)
+{
+    return (__m128){ { p[0], p[1], p[2], p[3] } };
+}
+
+__attribute__((unused))
+static void _mm_storeu_ps(float *p, __m128 v)
+{
+    p[0] = v.e[0], p[1] = v.e[1], p[2] = v.e[2], p[3] = v.e[3];
+}
+
+
+/**
+ * Arithmetic
+ */
+
+__attribute__((unused))
+static __m128 _mm_add_ps(__m128 a, __m128 b)
+{
+    return (__m128){ { a.e[0] + b.e[0], a.e[1] + b.e[1],
+                       a.e[2] + b.e[2], a.e[3] + b.e[3] } };
+}
+
+__attribute__((unused))
+static __m128 _mm_sub_ps(__m128 a, __m128 b)
+{
+    return (__m128){ { a.e[0] - b.e[0], a.e[1] - b.e[1],
+                       a.e[2] - b.e[2], a.e[3] - b.e[3] } };
+}
+
+__attribute__((unused))
+static __m128 _mm_mul_ps(__m128 a, __m128 b)
+{
+    return (__m128){ { a.e[0] * b.e[0], a.e[1] * b.e[1],
+                       a.e[2] * b.e[2], a.e[3] * b.e[3] } };
+}
+
+
+__attribute__((unused))
+static __m128 _mm_max_ps(__m128 a, __m128 b)
+{
+    return (__m128){ { a.e[0] > b.e[0] ? a.e[0] : b.e[0],
+                       a.e[1] > b.e[1] ? a.e[1] : b.e[1],
+                       a.e[2] > b.e[2] ? a.e[2] : b.e[2],
+                       a.e[3] > b.e[3] ? a.e[3] : b.e[3] } };
+}
+
+
+/**
+ * Logical / Comparison
+ */
+
+__attribute__((unused))
+static __m128 _mm_and_ps(__m128 a, __m128 b)
+{
+    __m128 r;
+
+    for (int i = 0; i < 4; i++) {
+        union { float f; uint32_t u; } va = { a.e[i] }, vb = { b.e[i] };
+        va.u &= vb.u, r.e[i] = va.f;
+    }
+
+    return r;
+}
+
+__attribute__((unused))
+static __m128 _mm_cmplt_ps(__m128 a, __m128 b)
+{
+    __m128 r;
+
+    for (int i = 0; i < 4; i++) {
+        union { float f; uint32_t u; } v = { .u = -(a.e[i] < b.e[i]) };
+        r.e[i] = v.f;
+    }
+
+    return r;
+}
+
+__attribute__((unused))
+static __m128 _mm_cmpge_ps(__m128 a, __m128 b)
+{
+    __m128 r;
+
+    for (int i = 0; i < 4; i++) {
+        union { float f; uint32_t u; } v = { .u = -(a.e[i] >= b.e[i]) };
+        r.e[i] = v.f;
+    }
+
+    return r;
+}
+
+__attribute__((unused))
+static int _mm_movemask_ps(__m128 a)
+{
+    int m = 0;
+
+    for (int i = 0; i < 4; i++) {
+        union { float f; uint32_t u; } v = { a.e[i] };
+        m |= (v.u >> 31) << i;
+    }
+
+    return m;
+}
+
+
+/**
+ * Conversion
+ */
+
+__attribute__((unused))
+static __m128 _mm_castsi128_ps(__m128i a)
+{
+    __m128 r;
+    memcpy(&r, &a, sizeof(r));
+    return r;
+}
+
+__attribute__((unused))
+static __m128i _mm_castps_si128(__m128 a)
+{
+    __m128i r;
+    memcpy(&r, &a, sizeof(r));
+    return r;
+}
+
+__attribute__((unused))
+static __m128 _mm_cvtepi32_ps(__m128i a)
+{
+    return (__m128){ { a.e[0], a.e[1], a.e[2], a.e[3] } };
+}
+
+__attribute__((unused))
+static __m128i _mm_cvttps_epi32(__m128 a)
+{
+    return (__m128i){ { a.e[0], a.e[1], a.e[2], a.e[3] } };
+}
+
+
+/**
+ * Manipulation
+ */
+
+__attribute__((unused))
+static __m128 _mm_setzero_ps(void)
+{
+    return (__m128){ { 0, 0, 0, 0 } };
+}
+
+__attribute__((unused))
+static __m128 _mm_set1_ps(float v)
+{
+    return (__m128){ { v, v, v, v } };
+}
+
+__attribute__((unused))
+static __m128 _mm_unpacklo_ps(__m128 a, __m128 b)
+{
+    return (__m128){ { a.e[0], b.e[0], a.e[1], b.e[1] } };
+}
+
+__attribute__((unused))
+static __m128 _mm_unpackhi_ps(__m128 a, __m128 b)
+{
+    return (__m128){ { a.e[2], b.e[2], a.e[3], b.e[3] } };
+}
+
+__attribute__((unused))
+static __m128 _mm_movelh_ps(__m128 a, __m128 b)
+{
+    return (__m128){ { a.e[0], a.e[1], b.e[0], b.e[1] } };
+}
+
+__attribute__((unused))
+static __m128 _mm_movehl_ps(__m128 a, __m128 b)
+{
+    return (__m128){ { b.e[2], b.e[3], a.e[2], a.e[3] } };
+}
+
+#define _MM_SHUFFLE(z, y, x, w) \
+    (((z) << 6) | ((y) << 4) | ((x) << 2) | (w))
+
+__attribute__((unused))
+static __m128 _mm_shuffle_ps(__m128 a, __m128 b, const int n)
+{
+    return (__m128){ { a.e[(n >> 0) & 3], a.e[(n >> 2) & 3],
+                       b.e[(n >> 4) & 3], b.e[(n >> 6) & 3] } };
+}
+
+
+#endif /* __SSE2__ */
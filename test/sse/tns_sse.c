@@ -0,0 +1,107 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "sse.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_SSE
+#include <tns.c>
+
+void lc3_put_bits_generic(lc3_bits_t *a, unsigned b, int c)
+{ (void)a, (void)b, (void)c; }
+
+unsigned lc3_get_bits_generic(struct lc3_bits *a, int b)
+{ return (void)a, (void)b, 0; }
+
+void lc3_ac_read_renorm(lc3_bits_t *a) { (void)a; }
+void lc3_ac_write_renorm(lc3_bits_t *a) { (void)a; }
+
+/* -------------------------------------------------------------------------- */
+
+static int check_autocorrelate(void)
+{
+    float x[160];
+
+    for (int i = 0; i < 160; i++)
+        x[i] = (2 * (double)rand() / RAND_MAX) - 1;
+
+    for (int n = 9; n <= 160; n += 17)
+        for (int maxorder = 4; maxorder <= 8; maxorder += 4) {
+            float r[9], r_sse[9];
+
+            autocorrelate(x, n, maxorder, r);
+            sse_autocorrelate(x, n, maxorder, r_sse);
+            for (int k = 0; k <= maxorder; k++)
+                if (fabsf(r[k] - r_sse[k]) > 1e-6f * r[0])
+                    return -1;
+        }
+
+    return 0;
+}
+
+static int check_forward_filtering(void)
+{
+    float x[LC3_MAX_NE], y[LC3_MAX_NE], y_sse[LC3_MAX_NE];
+    float rc[2][8];
+
+    for (int i = 0; i < LC3_MAX_NE; i++)
+        x[i] = (2 * (double)rand() / RAND_MAX) - 1;
+
+    for (int f = 0; f < 2; f++)
+        for (int k = 0; k < 8; k++)
+            rc[f][k] = (1.8 * (double)rand() / RAND_MAX) - 0.9;
+
+    for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_bandwidth bw = 0; bw <= LC3_BANDWIDTH_FB; bw++) {
+
+            if (!lc3_ne(dt, (enum lc3_srate)bw))
+                continue;
+
+            for (int order = 0; order <= 8; order++) {
+                int rc_order[2] = { order, 8 - order };
+
+                memcpy(y, x, sizeof(x));
+                memcpy(y_sse, x, sizeof(x));
+
+                forward_filtering(dt, bw, rc_order, rc, y);
+                sse_forward_filtering(dt, bw, rc_order, rc, y_sse);
+                if (memcmp(y, y_sse, sizeof(y)) != 0)
+                    return -1;
+            }
+        }
+
+    return 0;
+}
+
+int check_tns(void)
+{
+    int ret;
+
+    if ((ret = check_autocorrelate()) < 0)
+        return ret;
+
+    if ((ret = check_forward_filtering()) < 0)
+        return ret;
+
+    return 0;
+}
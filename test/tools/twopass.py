@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import math
+import os
+import random
+import struct
+import subprocess
+import sys
+import tempfile
+import wave
+
+LC3_MIN_FRAME_BYTES = 20
+LC3_MAX_FRAME_BYTES = 400
+
+BIN_DIR = sys.argv[1] if len(sys.argv) > 1 else 'bin'
+
+
+def write_wave(fname, sr_hz, nchannels, duration):
+    """Write a test signal, alternating tones, noise, attacks and silence"""
+
+    random.seed(1)
+    n = int(duration * sr_hz)
+    x = []
+
+    for i in range(n):
+        t = i / sr_hz
+        section = int(4 * t) % 4
+
+        if section == 0:
+            v = 0.3 * math.sin(2 * math.pi * 440 * t) + \
+                0.1 * math.sin(2 * math.pi * 1320 * t)
+        elif section == 1:
+            v = 0.3 * random.uniform(-1, 1)
+        elif section == 2:
+            v = 0.6 * math.exp(-60 * (t % 0.1)) * random.uniform(-1, 1)
+        else:
+            v = 0
+
+        for ch in range(nchannels):
+            x.append(int(32767 * v * (1 - 0.5 * ch)))
+
+    with wave.open(fname, 'wb') as w:
+        w.setnchannels(nchannels)
+        w.setsampwidth(2)
+        w.setframerate(sr_hz)
+        w.writeframes(struct.pack('<{}h'.format(len(x)), *x))
+
+
+def read_blocks(fname):
+    """Return the sizes of the blocks of a LC3 binary file"""
+
+    with open(fname, 'rb') as f:
+        data = f.read()
+
+    (header_size,) = struct.unpack_from('<H', data, 2)
+    (nchannels,) = struct.unpack_from('<H', data, 8)
+
+    pos, sizes = header_size, []
+    while pos < len(data):
+        (nbytes,) = struct.unpack_from('<H', data, pos)
+        sizes.append(nbytes)
+        pos += 2 + nbytes
+
+    return (nchannels, sizes)
+
+
+def run(*args):
+    env = dict(os.environ, LD_LIBRARY_PATH=BIN_DIR)
+    return subprocess.run([ os.path.join(BIN_DIR, args[0]) ] + list(args[1:]),
+        env=env, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True)
+
+
+def check_config(tmp, dt_ms, nchannels, bitrate):
+    """Encode in two-pass and single pass, and decode the two-pass stream"""
+
+    name = '{}ms, {} channel(s), {} bps'.format(dt_ms, nchannels, bitrate)
+
+    wav = os.path.join(tmp, 'in.wav')
+    cbr = os.path.join(tmp, 'cbr.lc3')
+    vbr = os.path.join(tmp, 'vbr.lc3')
+    out = os.path.join(tmp, 'out.wav')
+
+    write_wave(wav, 48000, nchannels, 2)
+
+    for args in ([ wav, cbr ], [ '-2', wav, vbr ]):
+        r = run('elc3', '-m', str(dt_ms), '-b', str(bitrate), *args)
+        if r.returncode != 0:
+            print('\n  [{}] encoding failed: {}'.format(name, r.stderr))
+            return False
+
+    (_, cbr_sizes) = read_blocks(cbr)
+    (_, vbr_sizes) = read_blocks(vbr)
+
+    ok = True
+
+    # --- Budget met exactly, with varying sizes ---
+
+    if len(vbr_sizes) != len(cbr_sizes) or sum(vbr_sizes) != sum(cbr_sizes):
+        print('\n  [{}] {} bytes in {} blocks, budget of {} in {}'.format(
+            name, sum(vbr_sizes), len(vbr_sizes),
+            sum(cbr_sizes), len(cbr_sizes)))
+        ok = False
+
+    if min(vbr_sizes) == max(vbr_sizes):
+        print('\n  [{}] constant size of blocks'.format(name))
+        ok = False
+
+    # --- Frames sizes in range ---
+
+    for (i, nbytes) in enumerate(vbr_sizes):
+        frames = [ nbytes // nchannels + (ch < nbytes % nchannels)
+                   for ch in range(nchannels) ]
+        if min(frames) < LC3_MIN_FRAME_BYTES or \
+           max(frames) > LC3_MAX_FRAME_BYTES:
+            print('\n  [{}] block {} of {} bytes, frames out of range'.format(
+                name, i, nbytes))
+            ok = False
+            break
+
+    # --- Decoding ---
+
+    r = run('dlc3', vbr, out)
+    if r.returncode != 0 or 'failed' in r.stderr:
+        print('\n  [{}] decoding failed: {}'.format(name, r.stderr))
+        ok = False
+
+    else:
+        with wave.open(wav, 'rb') as w_in, wave.open(out, 'rb') as w_out:
+            if w_out.getnframes() != w_in.getnframes():
+                print('\n  [{}] {} samples decoded, {} expected'.format(
+                    name, w_out.getnframes(), w_in.getnframes()))
+                ok = False
+
+    return ok
+
+
+def check():
+
+    ok = True
+
+    with tempfile.TemporaryDirectory() as tmp:
+        for dt_ms in ( 2.5, 5, 7.5, 10 ):
+            for nchannels in ( 1, 2 ):
+                for bitrate in ( 96000, 160000 ):
+                    ok = check_config(tmp,
+                        dt_ms, nchannels, nchannels * bitrate) and ok
+
+    return ok
+
+
+print('Checking Two-pass encoding... ', end='', flush=True)
+ret = check()
+print('OK' if ret else 'Failed')
+
+exit(0 if ret else 1)
@@ -0,0 +1,63 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "wasm.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_WASM
+#include <ltpf.c>
+
+void lc3_put_bits_generic(lc3_bits_t *a, unsigned b, int c)
+{ (void)a, (void)b, (void)c; }
+
+unsigned lc3_get_bits_generic(struct lc3_bits *a, int b)
+{ return (void)a, (void)b, 0; }
+
+/* -------------------------------------------------------------------------- */
+
+void bench_ltpf(int n)
+{
+    int16_t __x[60+480], *x = __x + 60;
+    struct lc3_ltpf_hp50_state hp50 = { 0 };
+    int16_t y[128];
+    float c[128];
+
+    for (int i = -60; i < 480; i++)
+        x[i] = rand() & 0xffff;
+
+    BENCH_KERNEL("ltpf resample 16k", n,
+        resample_16k_12k8(&hp50, x, y, 128),
+        wasm_resample_16k_12k8(&hp50, x, y, 128));
+
+    BENCH_KERNEL("ltpf resample 32k", n,
+        resample_32k_12k8(&hp50, x, y, 128),
+        wasm_resample_32k_12k8(&hp50, x, y, 128));
+
+    BENCH_KERNEL("ltpf resample 48k", n,
+        resample_48k_12k8(&hp50, x, y, 128),
+        wasm_resample_48k_12k8(&hp50, x, y, 128));
+
+    BENCH_KERNEL("ltpf correlate", n,
+        correlate(x, x + 200, 64, c, 98),
+        wasm_correlate(x, x + 200, 64, c, 98));
+}
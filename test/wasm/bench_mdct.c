@@ -0,0 +1,48 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "wasm.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_WASM
+#include <mdct.c>
+
+/* -------------------------------------------------------------------------- */
+
+void bench_mdct(int n)
+{
+    struct lc3_complex x[240], y[240];
+
+    for (int i = 0; i < 240; i++) {
+        x[i].re = (2 * (double)rand() / RAND_MAX) - 1;
+        x[i].im = (2 * (double)rand() / RAND_MAX) - 1;
+    }
+
+    BENCH_KERNEL("fft butterfly 3", n,
+        fft_bf3(lc3_fft_twiddles_bf3[0], x, y, 240/15),
+        wasm_fft_bf3(lc3_fft_twiddles_bf3[0], x, y, 240/15));
+
+    BENCH_KERNEL("fft butterfly 2", n,
+        fft_bf2(lc3_fft_twiddles_bf2[3][1], x, y, 1),
+        wasm_fft_bf2(lc3_fft_twiddles_bf2[3][1], x, y, 1));
+}
@@ -0,0 +1,90 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "wasm.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_WASM
+#include <common.h>
+#include <pcm_wasm.h>
+
+/* -------------------------------------------------------------------------- */
+
+static void pcm_from_s16(
+    const int16_t *pcm, int stride, int n, int16_t *xt, float *xs)
+{
+    for (int i = 0; i < n; i++, pcm += stride)
+        xt[i] = *pcm, xs[i] = *pcm;
+}
+
+static void pcm_from_float(
+    const float *pcm, int stride, int n, int16_t *xt, float *xs)
+{
+    for (int i = 0; i < n; i++, pcm += stride) {
+        xs[i] = lc3_ldexpf(*pcm, 15);
+        xt[i] = LC3_SAT16((int32_t)xs[i]);
+    }
+}
+
+static void pcm_to_s16(const float *xs, int n, int16_t *pcm, int stride)
+{
+    for (int i = 0; i < n; i++, pcm += stride) {
+        int32_t s = xs[i] >= 0 ? (int)(xs[i] + 0.5f) : (int)(xs[i] - 0.5f);
+        *pcm = LC3_SAT16(s);
+    }
+}
+
+static void pcm_to_float(const float *xs, int n, float *pcm, int stride)
+{
+    for (int i = 0; i < n; i++, pcm += stride) {
+        float s = lc3_ldexpf(xs[i], -15);
+        *pcm = fminf(fmaxf(s, -1.f), 1.f);
+    }
+}
+
+void bench_pcm(int n)
+{
+    int16_t pcm_s16[480], xt[480];
+    float pcm_f32[480], xs[480];
+
+    for (int i = 0; i < 480; i++) {
+        pcm_s16[i] = rand() & 0xffff;
+        pcm_f32[i] = (2 * (double)rand() / RAND_MAX) - 1;
+    }
+
+    BENCH_KERNEL("pcm from s16", n,
+        pcm_from_s16(pcm_s16, 1, 480, xt, xs),
+        wasm_pcm_from_s16(pcm_s16, 1, 480, xt, xs));
+
+    BENCH_KERNEL("pcm from float", n,
+        pcm_from_float(pcm_f32, 1, 480, xt, xs),
+        wasm_pcm_from_float(pcm_f32, 1, 480, xt, xs));
+
+    BENCH_KERNEL("pcm to s16", n,
+        pcm_to_s16(xs, 480, pcm_s16, 1),
+        wasm_pcm_to_s16(xs, 480, pcm_s16, 1));
+
+    BENCH_KERNEL("pcm to float", n,
+        pcm_to_float(xs, 480, pcm_f32, 1),
+        wasm_pcm_to_float(xs, 480, pcm_f32, 1));
+}
@@ -0,0 +1,69 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "wasm.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_WASM
+#include <spec.c>
+
+int lc3_get_bits_left(const lc3_bits_t *a) { return (void)a, 0; }
+
+int lc3_bwdet_get_nbits(enum lc3_srate a) { return (void)a, 0; }
+int lc3_sns_get_nbits(void) { return 0; }
+
+int lc3_tns_get_nbits(const lc3_tns_data_t *a) { return (void)a, 0; }
+
+void lc3_ac_read_renorm(lc3_bits_t *a) { (void)a; }
+void lc3_ac_write_renorm(lc3_bits_t *a) { (void)a; }
+
+/* -------------------------------------------------------------------------- */
+
+void bench_spec(int n)
+{
+    float x[LC3_MAX_NE], y[LC3_MAX_NE];
+    float e[LC3_MAX_NE / 4];
+    volatile float sink;
+    int nq;
+
+    for (int i = 0; i < LC3_MAX_NE; i++)
+        x[i] = (2 * (double)rand() / RAND_MAX - 1) * 1000;
+
+    enum lc3_dt dt = LC3_DT_10M;
+    enum lc3_srate sr = LC3_SRATE_48K;
+    int ne = lc3_ne(dt, sr);
+
+    BENCH_KERNEL("spec energy (x4)", n,
+        sink = compute_energy4(x, ne/4, e),
+        sink = wasm_compute_energy4(x, ne/4, e));
+
+    BENCH_KERNEL("spec quantize", n,
+        (memcpy(y, x, sizeof(x)), quantize(dt, sr, 20, y, &nq)),
+        (memcpy(y, x, sizeof(x)), wasm_quantize(dt, sr, 20, y, &nq)));
+
+    BENCH_KERNEL("spec unquantize", n,
+        (memcpy(y, x, sizeof(x)), sink = unquantize(dt, sr, 20, y, ne)),
+        (memcpy(y, x, sizeof(x)), sink = wasm_unquantize(dt, sr, 20, y, ne)));
+
+    (void)sink;
+}
@@ -0,0 +1,55 @@
+#
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at:
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+test_wasm_src += \
+    $(TEST_DIR)/wasm/test_wasm.c \
+    $(TEST_DIR)/wasm/ltpf_wasm.c \
+    $(TEST_DIR)/wasm/mdct_wasm.c \
+    $(TEST_DIR)/wasm/pcm_wasm.c \
+    $(TEST_DIR)/wasm/spec_wasm.c \
+    $(SRC_DIR)/tables.c
+
+test_wasm_include += $(SRC_DIR)
+test_wasm_ldlibs += m
+
+$(eval $(call add-bin,test_wasm))
+
+test_wasm: $(test_wasm_bin)
+	@echo "  RUN     $(notdir $<)"
+	$(V)$<
+
+test: test_wasm
+
+
+bench_wasm_src += \
+    $(TEST_DIR)/wasm/bench_wasm.c \
+    $(TEST_DIR)/wasm/bench_ltpf.c \
+    $(TEST_DIR)/wasm/bench_mdct.c \
+    $(TEST_DIR)/wasm/bench_pcm.c \
+    $(TEST_DIR)/wasm/bench_spec.c \
+    $(SRC_DIR)/tables.c
+
+bench_wasm_include += $(SRC_DIR) $(TEST_DIR)/sse
+bench_wasm_cflags += -ffast-math
+bench_wasm_ldlibs += m
+
+$(eval $(call add-bin,bench_wasm))
+
+WASM_RUNTIME ?= wasmtime
+
+bench_wasm: $(bench_wasm_bin)
+	@echo "  RUN     $(notdir $<)"
+	$(V)$(if $(filter wasm32%,$(TARGET)),$(WASM_RUNTIME)) $<
@@ -0,0 +1,84 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "wasm.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_WASM
+#include <mdct.c>
+
+/* -------------------------------------------------------------------------- */
+
+static int check_near(
+    const struct lc3_complex *a, const struct lc3_complex *b, int n)
+{
+    for (int i = 0; i < n; i++)
+        if (fabsf(a[i].re - b[i].re) > 1e-6f ||
+            fabsf(a[i].im - b[i].im) > 1e-6f   )
+            return -1;
+
+    return 0;
+}
+
+static int check_fft(void)
+{
+    struct lc3_complex x[240];
+    struct lc3_complex y[240], y_wasm[240];
+
+    for (int i = 0; i < 240; i++) {
+          x[i].re = (double)rand() / RAND_MAX;
+          x[i].im = (double)rand() / RAND_MAX;
+    }
+
+    for (int k = 0; k < 2; k++) {
+        const struct lc3_fft_bf3_twiddles *t = lc3_fft_twiddles_bf3[k];
+        int n = 240 / (3 * t->n3);
+
+        fft_bf3(t, x, y, n);
+        wasm_fft_bf3(t, x, y_wasm, n);
+        if (check_near(y, y_wasm, 3 * t->n3 * n) < 0)
+            return -1;
+    }
+
+    for (int k = 0; k < 3; k++) {
+        const struct lc3_fft_bf2_twiddles *t = lc3_fft_twiddles_bf2[k][1];
+        int n = 240 / (2 * t->n2);
+
+        fft_bf2(t, x, y, n);
+        wasm_fft_bf2(t, x, y_wasm, n);
+        if (check_near(y, y_wasm, 2 * t->n2 * n) < 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+int check_mdct(void)
+{
+    int ret;
+
+    if ((ret = check_fft()) < 0)
+        return ret;
+
+    return 0;
+}
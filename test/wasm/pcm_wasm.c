@@ -0,0 +1,121 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "wasm.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_WASM
+#include <common.h>
+#include <pcm_wasm.h>
+
+/* -------------------------------------------------------------------------- */
+
+static int check_load(void)
+{
+    int16_t pcm_s16[2*480], xt[480], xt_wasm[480];
+    float pcm_f32[2*480], xs[480], xs_wasm[480];
+
+    for (int i = 0; i < 2*480; i++) {
+        pcm_s16[i] = rand() & 0xffff;
+        pcm_f32[i] = (2.2 * (double)rand() / RAND_MAX) - 1.1;
+    }
+
+    for (int stride = 1; stride <= 2; stride++)
+        for (int n = 1; n <= 480; n += 17) {
+
+            for (int i = 0; i < n; i++) {
+                int16_t s = pcm_s16[i * stride];
+                xt[i] = s, xs[i] = s;
+            }
+
+            wasm_pcm_from_s16(pcm_s16, stride, n, xt_wasm, xs_wasm);
+            if (memcmp(xt, xt_wasm, n * sizeof(*xt)) != 0 ||
+                memcmp(xs, xs_wasm, n * sizeof(*xs)) != 0   )
+                return -1;
+
+            for (int i = 0; i < n; i++) {
+                xs[i] = pcm_f32[i * stride] * 32768;
+                xt[i] = LC3_SAT16((int32_t)xs[i]);
+            }
+
+            wasm_pcm_from_float(pcm_f32, stride, n, xt_wasm, xs_wasm);
+            if (memcmp(xt, xt_wasm, n * sizeof(*xt)) != 0 ||
+                memcmp(xs, xs_wasm, n * sizeof(*xs)) != 0   )
+                return -1;
+        }
+
+    return 0;
+}
+
+static int check_store(void)
+{
+    float xs[480];
+    int16_t pcm_s16[2*480], pcm_s16_wasm[2*480];
+    float pcm_f32[2*480], pcm_f32_wasm[2*480];
+
+    for (int i = 0; i < 480; i++) {
+        float v = (2.2 * (double)rand() / RAND_MAX) - 1.1;
+        xs[i] = i % 8 ? v * 32768 : roundf(v * 1024) + 0.5f;
+    }
+
+    for (int stride = 1; stride <= 2; stride++)
+        for (int n = 1; n <= 480; n += 17) {
+            memset(pcm_s16, 0, sizeof(pcm_s16));
+            memset(pcm_s16_wasm, 0, sizeof(pcm_s16_wasm));
+
+            for (int i = 0; i < n; i++) {
+                int32_t s = xs[i] >= 0 ?
+                    (int)(xs[i] + 0.5f) : (int)(xs[i] - 0.5f);
+                pcm_s16[i * stride] = LC3_SAT16(s);
+            }
+
+            wasm_pcm_to_s16(xs, n, pcm_s16_wasm, stride);
+            if (memcmp(pcm_s16, pcm_s16_wasm, sizeof(pcm_s16)) != 0)
+                return -1;
+
+            memset(pcm_f32, 0, sizeof(pcm_f32));
+            memset(pcm_f32_wasm, 0, sizeof(pcm_f32_wasm));
+
+            for (int i = 0; i < n; i++)
+                pcm_f32[i * stride] = fminf(fmaxf(xs[i] / 32768, -1.f), 1.f);
+
+            wasm_pcm_to_float(xs, n, pcm_f32_wasm, stride);
+            if (memcmp(pcm_f32, pcm_f32_wasm, sizeof(pcm_f32)) != 0)
+                return -1;
+        }
+
+    return 0;
+}
+
+int check_pcm(void)
+{
+    int ret;
+
+    if ((ret = check_load()) < 0)
+        return ret;
+
+    if ((ret = check_store()) < 0)
+        return ret;
+
+    return 0;
+}
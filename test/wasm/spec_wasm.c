@@ -0,0 +1,115 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "wasm.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------- */
+
+#define TEST_WASM
+#include <spec.c>
+
+int lc3_get_bits_left(const lc3_bits_t *a) { return (void)a, 0; }
+
+int lc3_bwdet_get_nbits(enum lc3_srate a) { return (void)a, 0; }
+
+int lc3_sns_get_nbits(void) { return 0; }
+
+int lc3_tns_get_nbits(const lc3_tns_data_t *a) { return (void)a, 0; }
+
+void lc3_ac_read_renorm(lc3_bits_t *a) { (void)a; }
+void lc3_ac_write_renorm(lc3_bits_t *a) { (void)a; }
+
+/* -------------------------------------------------------------------------- */
+
+static void generate_spectrum(float *x, int n, float scale)
+{
+    for (int i = 0; i < n; i++) {
+        float v = (2 * (double)rand() / RAND_MAX) - 1;
+        x[i] = (rand() % 4 ? v * v * v : v) * scale;
+    }
+}
+
+static int check_energy(void)
+{
+    float x[LC3_MAX_NE];
+    float e[LC3_MAX_NE / 4], e_wasm[LC3_MAX_NE / 4];
+
+    for (int n4 = 1; n4 <= LC3_MAX_NE / 4; n4 += 13) {
+        generate_spectrum(x, 4*n4, 1 << (rand() % 16));
+
+        float x2_max = compute_energy4(x, n4, e);
+        float x2_max_wasm = wasm_compute_energy4(x, n4, e_wasm);
+        if (x2_max != x2_max_wasm ||
+                memcmp(e, e_wasm, n4 * sizeof(*e)) != 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+static int check_quantization(void)
+{
+    float x[LC3_MAX_NE], y[LC3_MAX_NE], y_wasm[LC3_MAX_NE];
+
+    for (enum lc3_dt dt = 0; dt < LC3_NUM_DT; dt++)
+        for (enum lc3_srate sr = 0; sr < LC3_NUM_SRATE; sr++) {
+            int ne = lc3_ne(dt, sr);
+            if (!ne)
+                continue;
+
+            for (int g_int = -30; g_int < 60; g_int += 7) {
+                int n, n_wasm;
+
+                generate_spectrum(x, ne, 1000);
+                for (int i = ne - 2 * (rand() % (ne/2)); i < ne; i++)
+                    x[i] *= 1e-4f;
+
+                memcpy(y, x, ne * sizeof(*x));
+                memcpy(y_wasm, x, ne * sizeof(*x));
+
+                quantize(dt, sr, g_int, y, &n);
+                wasm_quantize(dt, sr, g_int, y_wasm, &n_wasm);
+                if (n != n_wasm || memcmp(y, y_wasm, ne * sizeof(*y)) != 0)
+                    return -1;
+
+                float g = unquantize(dt, sr, g_int, y, n);
+                float g_wasm = wasm_unquantize(dt, sr, g_int, y_wasm, n);
+                if (g != g_wasm || memcmp(y, y_wasm, ne * sizeof(*y)) != 0)
+                    return -1;
+            }
+        }
+
+    return 0;
+}
+
+int check_spec(void)
+{
+    int ret;
+
+    if ((ret = check_energy()) < 0)
+        return ret;
+
+    if ((ret = check_quantization()) < 0)
+        return ret;
+
+    return 0;
+}
@@ -0,0 +1,319 @@
+/******************************************************************************
+ *
+ *  Copyright 2022 Google LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#if __wasm_simd128__
+
+#include <wasm_simd128.h>
+
+#else
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+typedef union {
+    int16_t i16[8];
+    int32_t i32[4];
+    int64_t i64[2];
+    float f32[4];
+} v128_t;
+
+
+/* ----------------------------------------------------------------------------
+ *  Load / Store
+ * -------------------------------------------------------------------------- */
+
+__attribute__((unused))
+static v128_t wasm_v128_load(const void *p)
+{
+    v128_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+__attribute__((unused))
+static v128_t wasm_v128_load64_zero(const void *p)
+{
+    v128_t v = { { 0 } };
+    memcpy(&v, p, sizeof(int64_t));
+    return v;
+}
+
+__attribute__((unused))
+static void wasm_v128_store(void *p, v128_t v)
+{
+    memcpy(p, &v, sizeof(v));
+}
+
+
+/* ----------------------------------------------------------------------------
+ *  Integer
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Arithmetic
+ */
+
+__attribute__((unused))
+static v128_t wasm_i32x4_add(v128_t a, v128_t b)
+{
+    v128_t r;
+
+    for (int i = 0; i < 4; i++)
+        r.i32[i] = (int32_t)((uint32_t)a.i32[i] + (uint32_t)b.i32[i]);
+
+    return r;
+}
+
+__attribute__((unused))
+static v128_t wasm_i64x2_add(v128_t a, v128_t b)
+{
+    v128_t r;
+
+    for (int i = 0; i < 2; i++)
+        r.i64[i] = (int64_t)((uint64_t)a.i64[i] + (uint64_t)b.i64[i]);
+
+    return r;
+}
+
+__attribute__((unused))
+static v128_t wasm_i32x4_dot_i16x8(v128_t a, v128_t b)
+{
+    v128_t r;
+
+    for (int i = 0; i < 4; i++)
+        r.i32[i] = (int32_t)(
+            (uint32_t)(a.i16[2*i+0] * b.i16[2*i+0]) +
+            (uint32_t)(a.i16[2*i+1] * b.i16[2*i+1]) );
+
+    return r;
+}
+
+
+/**
+ * Manipulation
+ */
+
+__attribute__((unused))
+static v128_t wasm_i32x4_splat(int32_t v)
+{
+    return (v128_t){ .i32 = { v, v, v, v } };
+}
+
+__attribute__((unused))
+static v128_t wasm_i64x2_splat(int64_t v)
+{
+    return (v128_t){ .i64 = { v, v } };
+}
+
+__attribute__((unused))
+static int32_t wasm_i32x4_extract_lane(v128_t v, const int i)
+{
+    return v.i32[i];
+}
+
+__attribute__((unused))
+static int64_t wasm_i64x2_extract_lane(v128_t v, const int i)
+{
+    return v.i64[i];
+}
+
+__attribute__((unused))
+static v128_t wasm_i32x4_shuffle(v128_t a, v128_t b,
+    const int c0, const int c1, const int c2, const int c3)
+{
+    int32_t x[] = { a.i32[0], a.i32[1], a.i32[2], a.i32[3],
+                    b.i32[0], b.i32[1], b.i32[2], b.i32[3] };
+
+    return (v128_t){ .i32 = { x[c0], x[c1], x[c2], x[c3] } };
+}
+
+__attribute__((unused))
+static v128_t wasm_v128_bitselect(v128_t a, v128_t b, v128_t m)
+{
+    v128_t r;
+
+    for (int i = 0; i < 4; i++)
+        r.i32[i] = (a.i32[i] & m.i32[i]) | (b.i32[i] & ~m.i32[i]);
+
+    return r;
+}
+
+
+/**
+ * Conversion
+ */
+
+__attribute__((unused))
+static v128_t wasm_i32x4_extend_low_i16x8(v128_t a)
+{
+    return (v128_t){ .i32 = { a.i16[0], a.i16[1], a.i16[2], a.i16[3] } };
+}
+
+__attribute__((unused))
+static v128_t wasm_i32x4_extend_high_i16x8(v128_t a)
+{
+    return (v128_t){ .i32 = { a.i16[4], a.i16[5], a.i16[6], a.i16[7] } };
+}
+
+__attribute__((unused))
+static v128_t wasm_i64x2_extend_low_i32x4(v128_t a)
+{
+    return (v128_t){ .i64 = { a.i32[0], a.i32[1] } };
+}
+
+__attribute__((unused))
+static v128_t wasm_i64x2_extend_high_i32x4(v128_t a)
+{
+    return (v128_t){ .i64 = { a.i32[2], a.i32[3] } };
+}
+
+__attribute__((unused))
+static v128_t wasm_i16x8_narrow_i32x4(v128_t a, v128_t b)
+{
+    v128_t r;
+
+    for (int i = 0; i < 8; i++) {
+        int32_t v = i < 4 ? a.i32[i] : b.i32[i-4];
+        r.i16[i] = v > INT16_MAX ? INT16_MAX :
+                   v < INT16_MIN ? INT16_MIN : v;
+    }
+
+    return r;
+}
+
+__attribute__((unused))
+static v128_t wasm_i32x4_trunc_sat_f32x4(v128_t a)
+{
+    v128_t r;
+
+    for (int i = 0; i < 4; i++) {
+        float v = a.f32[i];
+        r.i32[i] = isnan(v) ? 0 :
+                   v >=  0x1p31f ? INT32_MAX :
+                   v <  -0x1p31f ? INT32_MIN : (int32_t)v;
+    }
+
+    return r;
+}
+
+__attribute__((unused))
+static v128_t wasm_f32x4_convert_i32x4(v128_t a)
+{
+    return (v128_t){ .f32 = {
+        (float)a.i32[0], (float)a.i32[1], (float)a.i32[2], (float)a.i32[3] } };
+}
+
+
+/* ----------------------------------------------------------------------------
+ *  Floating Point
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Arithmetic
+ */
+
+__attribute__((unused))
+static v128_t wasm_f32x4_add(v128_t a, v128_t b)
+{
+    return (v128_t){ .f32 = { a.f32[0] + b.f32[0], a.f32[1] + b.f32[1],
+                              a.f32[2] + b.f32[2], a.f32[3] + b.f32[3] } };
+}
+
+__attribute__((unused))
+static v128_t wasm_f32x4_sub(v128_t a, v128_t b)
+{
+    return (v128_t){ .f32 = { a.f32[0] - b.f32[0], a.f32[1] - b.f32[1],
+                              a.f32[2] - b.f32[2], a.f32[3] - b.f32[3] } };
+}
+
+__attribute__((unused))
+static v128_t wasm_f32x4_mul(v128_t a, v128_t b)
+{
+    return (v128_t){ .f32 = { a.f32[0] * b.f32[0], a.f32[1] * b.f32[1],
+                              a.f32[2] * b.f32[2], a.f32[3] * b.f32[3] } };
+}
+
+__attribute__((unused))
+static v128_t wasm_f32x4_neg(v128_t a)
+{
+    return (v128_t){ .f32 = { -a.f32[0], -a.f32[1], -a.f32[2], -a.f32[3] } };
+}
+
+__attribute__((unused))
+static v128_t wasm_f32x4_abs(v128_t a)
+{
+    return (v128_t){ .f32 = { fabsf(a.f32[0]), fabsf(a.f32[1]),
+                              fabsf(a.f32[2]), fabsf(a.f32[3]) } };
+}
+
+__attribute__((unused))
+static v128_t wasm_f32x4_min(v128_t a, v128_t b)
+{
+    return (v128_t){ .f32 = {
+        fminf(a.f32[0], b.f32[0]), fminf(a.f32[1], b.f32[1]),
+        fminf(a.f32[2], b.f32[2]), fminf(a.f32[3], b.f32[3]) } };
+}
+
+__attribute__((unused))
+static v128_t wasm_f32x4_max(v128_t a, v128_t b)
+{
+    return (v128_t){ .f32 = {
+        fmaxf(a.f32[0], b.f32[0]), fmaxf(a.f32[1], b.f32[1]),
+        fmaxf(a.f32[2], b.f32[2]), fmaxf(a.f32[3], b.f32[3]) } };
+}
+
+
+/**
+ * Comparison
+ */
+
+__attribute__((unused))
+static v128_t wasm_f32x4_lt(v128_t a, v128_t b)
+{
+    return (v128_t){ .i32 = {
+        -(a.f32[0] < b.f32[0]), -(a.f32[1] < b.f32[1]),
+        -(a.f32[2] < b.f32[2]), -(a.f32[3] < b.f32[3]) } };
+}
+
+__attribute__((unused))
+static v128_t wasm_f32x4_ge(v128_t a, v128_t b)
+{
+    return (v128_t){ .i32 = {
+        -(a.f32[0] >= b.f32[0]), -(a.f32[1] >= b.f32[1]),
+        -(a.f32[2] >= b.f32[2]), -(a.f32[3] >= b.f32[3]) } };
+}
+
+
+/**
+ * Manipulation
+ */
+
+__attribute__((unused))
+static v128_t wasm_f32x4_splat(float v)
+{
+    return (v128_t){ .f32 = { v, v, v, v } };
+}
+
+__attribute__((unused))
+static float wasm_f32x4_extract_lane(v128_t v, const int i)
+{
+    return v.f32[i];
+}
+
+#endif /* __wasm_simd128__ */
@@ -19,6 +19,7 @@
 #define _POSIX_C_SOURCE 199309L
 
 #include <stdalign.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdlib.h>
@@ -64,6 +65,7 @@ struct parameters {
     int srate_hz;
     bool hrmode;
     int bitrate;
+    bool twopass;
 };
 
 static struct parameters parse_args(int argc, char *argv[])
@@ -80,6 +82,7 @@ static struct parameters parse_args(int argc, char *argv[])
         "\t-m\t"     "Frame duration in ms (default 10)\n"
         "\t-r\t"     "Encoder samplerate (default is input samplerate)\n"
         "\t-H\t"     "Enable high-resolution mode\n"
+        "\t-2\t"     "Two-pass encoding, with variable frame sizes\n"
         "\n";
 
     struct parameters p = { .frame_ms = 10 };
@@ -107,6 +110,7 @@ static struct parameters parse_args(int argc, char *argv[])
                 case 'm': p.frame_ms = atof(optarg); break;
                 case 'r': p.srate_hz = atoi(optarg); break;
                 case 'H': p.hrmode = true; break;
+                case '2': p.twopass = true; break;
                 default:
                     error(EINVAL, "Option %s", arg);
             }
@@ -140,6 +144,75 @@ static unsigned clock_us(void)
 }
 
 
+/**
+ * Two-pass encoding, quality targets of the first pass
+ */
+
+#define TWOPASS_NQUALITY  17
+
+static const float twopass_quality[TWOPASS_NQUALITY] = {
+    -10, -5, 0, 5, 10, 15, 20, 25, 30, 35, 40, 45, 50, 55, 60, 65, 70 };
+
+/**
+ * Two-pass encoding, allocation of the size of the frames
+ * nframes         Number of frames
+ * nquality        Number of quality targets
+ * est             Estimated size of the frames, by quality targets
+ * min, max        Minimum and maximum size of the frames
+ * total           Total size to distribute among the frames
+ * nbytes          Output the size of the frames
+ *
+ * A common quality target is searched, interpolating the estimations,
+ * for which the total size is met. The rounding remainder is spread
+ * over the frames.
+ */
+
+static void twopass_allocate(int nframes, int nquality, const uint16_t *est,
+    int min, int max, int64_t total, uint16_t *nbytes)
+{
+    float t_lo = 0, t_hi = nquality - 1, t = 0;
+
+    for (int it = 0; it < 32; it++) {
+        t = 0.5f * (t_lo + t_hi);
+
+        int k = t < nquality - 2 ? (int)t : nquality - 2;
+        int64_t sum = 0;
+
+        for (int i = 0; i < nframes; i++) {
+            const uint16_t *e = est + i * nquality + k;
+            sum += e[0] + (int)((t - k) * (e[1] - e[0]));
+        }
+
+        if (sum > total)
+            t_hi = t;
+        else
+            t_lo = t;
+    }
+
+    int k = t_lo < nquality - 2 ? (int)t_lo : nquality - 2;
+    int64_t sum = 0;
+
+    for (int i = 0; i < nframes; i++) {
+        const uint16_t *e = est + i * nquality + k;
+        nbytes[i] = e[0] + (int)((t_lo - k) * (e[1] - e[0]));
+        sum += nbytes[i];
+    }
+
+    for (bool spread = true; sum != total && spread; ) {
+        spread = false;
+
+        for (int i = 0; i < nframes && sum != total; i++) {
+            int d = sum < total ? 1 : -1;
+            if (nbytes[i] + d < min || nbytes[i] + d > max)
+                continue;
+
+            nbytes[i] += d, sum += d;
+            spread = true;
+        }
+    }
+}
+
+
 /**
  * Entry point
  */
@@ -170,6 +243,9 @@ int main(int argc, char *argv[])
     if (p.bitrate <= 0)
         error(EINVAL, "Bitrate");
 
+    if (p.twopass && fp_in == stdin)
+        error(EINVAL, "Two-pass encoding needs an input file");
+
     if (!LC3_CHECK_DT_US(frame_us))
         error(EINVAL, "Frame duration");
 
@@ -230,6 +306,60 @@ int main(int argc, char *argv[])
             error(EINVAL, "Encoder initialization failed");
     }
 
+    /* --- First pass of two-pass encoding --- */
+
+    uint16_t *frame_block_bytes = NULL;
+
+    if (p.twopass) {
+        int nframes = (encode_samples + frame_samples - 1) / frame_samples;
+        int min_bytes = lc3_hr_frame_bytes(
+            p.hrmode, frame_us, enc_srate_hz, 0);
+        int max_bytes = lc3_hr_frame_bytes(
+            p.hrmode, frame_us, enc_srate_hz, INT_MAX);
+
+        uint16_t *est = calloc(
+            (size_t)nframes * TWOPASS_NQUALITY, sizeof(*est));
+        frame_block_bytes = malloc(nframes * sizeof(*frame_block_bytes));
+        if (!est || !frame_block_bytes)
+            error(ENOMEM, "Two-pass encoding");
+
+        long data_pos = ftell(fp_in);
+
+        for (int i = 0; i < nframes; i++) {
+
+            int nread = wave_read_pcm(
+                fp_in, pcm_sbytes, nchannels, frame_samples, pcm);
+
+            memset(pcm + nread * nchannels * pcm_sbytes, 0,
+                nchannels * (frame_samples - nread) * pcm_sbytes);
+
+            for (int ich = 0; ich < nchannels; ich++) {
+                int nbytes[TWOPASS_NQUALITY];
+
+                lc3_encode_estimate(enc[ich],
+                    pcm_fmt, pcm + ich * pcm_sbytes, nchannels,
+                    TWOPASS_NQUALITY, twopass_quality,
+                    min_bytes, max_bytes, nbytes);
+
+                for (int k = 0; k < TWOPASS_NQUALITY; k++)
+                    est[i * TWOPASS_NQUALITY + k] += nbytes[k];
+            }
+        }
+
+        twopass_allocate(nframes, TWOPASS_NQUALITY, est,
+            nchannels * min_bytes, nchannels * max_bytes,
+            (int64_t)nframes * block_bytes, frame_block_bytes);
+
+        free(est);
+
+        if (fseek(fp_in, data_pos, SEEK_SET) < 0)
+            error(errno, "%s", p.fname_in);
+
+        for (int ich = 0; ich < nchannels; ich++)
+            lc3_hr_setup_encoder(p.hrmode,
+                frame_us, enc_srate_hz, srate_hz, enc[ich]);
+    }
+
     /* --- Encoding loop --- */
 
     static const char *dash_line = "========================================";
@@ -255,10 +385,12 @@ int main(int argc, char *argv[])
             nsec = (int)(i * frame_us * 1e-6);
         }
 
+        int nbytes = frame_block_bytes ? frame_block_bytes[i] : block_bytes;
+
         uint8_t *out_ptr = out;
         for (int ich = 0; ich < nchannels; ich++) {
-            int frame_bytes = block_bytes / nchannels
-                + (ich < block_bytes % nchannels);
+            int frame_bytes = nbytes / nchannels
+                + (ich < nbytes % nchannels);
 
             lc3_encode(enc[ich],
                 pcm_fmt, pcm + ich * pcm_sbytes, nchannels,
@@ -267,7 +399,7 @@ int main(int argc, char *argv[])
             out_ptr += frame_bytes;
         }
 
-        lc3bin_write_data(fp_out, out, block_bytes);
+        lc3bin_write_data(fp_out, out, nbytes);
     }
 
     unsigned t = (clock_us() - t0) / 1000;
@@ -281,6 +413,8 @@ int main(int argc, char *argv[])
     for (int ich = 0; ich < nchannels; ich++)
         free(enc[ich]);
 
+    free(frame_block_bytes);
+
     if (fp_in != stdin)
         fclose(fp_in);
 
@@ -66,6 +66,9 @@ void lc3bin_write_header(FILE *fp,
  * fp              Opened file
  * data            The frames data
  * nbytes          Size of the frames block
+ *
+ * The size of the blocks is written along each one, and can change from
+ * block to block. The block is shared evenly by the channels.
  */
 void lc3bin_write_data(FILE *fp, const void *data, int nbytes);
 